@@ -119,6 +119,7 @@ SOURCES += \
     profiler/ProfileGenerator.cpp \
     profiler/ProfileNode.cpp \
     profiler/Profiler.cpp \
+    profiler/SamplingProfiler.cpp \
     runtime/ArgList.cpp \
     runtime/Arguments.cpp \
     runtime/ArrayConstructor.cpp \
@@ -142,7 +143,7 @@ SOURCES += \
     runtime/Executable.cpp \
     runtime/FunctionConstructor.cpp \
     runtime/FunctionPrototype.cpp \
-    runtime/GCActivityCallback.cpp \
+    runtime/GCActivityCallbackQt.cpp \
     runtime/GetterSetter.cpp \
     runtime/Identifier.cpp \
     runtime/InitializeThreading.cpp \
@@ -38,6 +38,7 @@
 #include "JSFunction.h"
 #include "JSStaticScopeObject.h"
 #include "JSValue.h"
+#include "SamplingProfiler.h"
 #include "UStringConcatenate.h"
 #include <stdio.h>
 #include <wtf/StringExtras.h>
@@ -315,6 +316,18 @@ void CodeBlock::printStructures(const Instruction* vPC) const
         printStructure("put_by_id_replace", vPC, 4);
         return;
     }
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_self_list)) {
+        printf("  [%4d] %s: %s (%d)\n", instructionOffset, "get_by_id_self_list", pointerToSourceString(vPC[4].u.polymorphicStructures).utf8().data(), vPC[5].u.operand);
+        return;
+    }
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_proto_list)) {
+        printf("  [%4d] %s: %s (%d)\n", instructionOffset, "get_by_id_proto_list", pointerToSourceString(vPC[4].u.polymorphicStructures).utf8().data(), vPC[5].u.operand);
+        return;
+    }
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_put_by_id_replace_list)) {
+        printf("  [%4d] %s: %s (%d)\n", instructionOffset, "put_by_id_replace_list", pointerToSourceString(vPC[4].u.polymorphicStructures).utf8().data(), vPC[5].u.operand);
+        return;
+    }
     if (vPC[0].u.opcode == interpreter->getOpcode(op_resolve_global)) {
         printStructure("resolve_global", vPC, 4);
         return;
@@ -873,6 +886,10 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             printPutByIdOp(exec, location, it, "put_by_id_replace");
             break;
         }
+        case op_put_by_id_replace_list: {
+            printPutByIdOp(exec, location, it, "put_by_id_replace_list");
+            break;
+        }
         case op_put_by_id_transition: {
             printPutByIdOp(exec, location, it, "put_by_id_transition");
             break;
@@ -1073,6 +1090,7 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             int argCount = (++it)->u.operand;
             int registerOffset = (++it)->u.operand;
             printf("[%4d] call\t\t %s, %d, %d\n", location, registerName(exec, func).data(), argCount, registerOffset);
+            it += 2;
             break;
         }
         case op_call_eval: {
@@ -1080,6 +1098,7 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             int argCount = (++it)->u.operand;
             int registerOffset = (++it)->u.operand;
             printf("[%4d] call_eval\t %s, %d, %d\n", location, registerName(exec, func).data(), argCount, registerOffset);
+            it += 2;
             break;
         }
         case op_call_varargs: {
@@ -1125,6 +1144,7 @@ void CodeBlock::dump(ExecState* exec, const Vector<Instruction>::const_iterator&
             int argCount = (++it)->u.operand;
             int registerOffset = (++it)->u.operand;
             printf("[%4d] construct\t %s, %d, %d\n", location, registerName(exec, func).data(), argCount, registerOffset);
+            it += 2;
             break;
         }
         case op_strcat: {
@@ -1377,9 +1397,14 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, CodeType codeType, JSGlo
     , m_usesEval(ownerExecutable->usesEval())
     , m_isNumericCompareFunction(false)
     , m_isStrictMode(ownerExecutable->isStrictMode())
+    , m_hasDebugHooks(false)
+    , m_hasProfileHooks(false)
     , m_codeType(codeType)
     , m_source(sourceProvider)
     , m_sourceOffset(sourceOffset)
+#if ENABLE(JIT)
+    , m_executeCounter(0)
+#endif
     , m_symbolTable(symTab)
 {
     ASSERT(m_source);
@@ -1391,16 +1416,40 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, CodeType codeType, JSGlo
 
 CodeBlock::~CodeBlock()
 {
+    if (m_globalData && m_globalData->samplingProfiler)
+        m_globalData->samplingProfiler->codeBlockWillBeDestroyed(this);
+
 #if ENABLE(JIT)
     for (size_t size = m_structureStubInfos.size(), i = 0; i < size; ++i)
         m_structureStubInfos[i].deref();
+
+    for (size_t size = m_callLinkInfos.size(), i = 0; i < size; ++i) {
+        if (m_callLinkInfos[i].isOnList())
+            m_callLinkInfos[i].remove();
+    }
+    unlinkIncomingCalls();
 #endif // ENABLE(JIT)
 
+#if ENABLE(INTERPRETER)
+    for (size_t size = m_propertyAccessInstructions.size(), i = 0; i < size; ++i)
+        derefStructures(&m_instructions[m_propertyAccessInstructions[i]]);
+#endif
+
 #if DUMP_CODE_BLOCK_STATISTICS
     liveCodeBlockSet.remove(this);
 #endif
 }
 
+void CodeBlock::derefStructures(Instruction* vPC) const
+{
+    Interpreter* interpreter = m_globalData->interpreter;
+
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_self_list)
+        || vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_proto_list)
+        || vPC[0].u.opcode == interpreter->getOpcode(op_put_by_id_replace_list))
+        delete vPC[4].u.polymorphicStructures;
+}
+
 void CodeBlock::visitStructures(SlotVisitor& visitor, Instruction* vPC) const
 {
     Interpreter* interpreter = m_globalData->interpreter;
@@ -1442,7 +1491,10 @@ void CodeBlock::visitStructures(SlotVisitor& visitor, Instruction* vPC) const
         || (vPC[0].u.opcode == interpreter->getOpcode(op_get_by_id_custom_self_list))) {
         PolymorphicAccessStructureList* polymorphicStructures = vPC[4].u.polymorphicStructures;
         polymorphicStructures->visitAggregate(visitor, vPC[5].u.operand);
-        delete polymorphicStructures;
+        return;
+    }
+    if (vPC[0].u.opcode == interpreter->getOpcode(op_put_by_id_replace_list)) {
+        vPC[4].u.polymorphicStructures->visitAggregate(visitor, vPC[5].u.operand);
         return;
     }
 
@@ -1476,6 +1528,11 @@ void CodeBlock::visitAggregate(SlotVisitor& visitor)
 #if ENABLE(INTERPRETER)
     for (size_t size = m_propertyAccessInstructions.size(), i = 0; i < size; ++i)
         visitStructures(visitor, &m_instructions[m_propertyAccessInstructions[i]]);
+    for (size_t size = m_callInstructions.size(), i = 0; i < size; ++i) {
+        Instruction* vPC = &m_instructions[m_callInstructions[i]];
+        if (vPC[4].u.jsCell)
+            visitor.append(&vPC[4].u.jsCell);
+    }
 #endif
 #if ENABLE(JIT)
     for (size_t size = m_globalResolveInfos.size(), i = 0; i < size; ++i) {
@@ -1617,6 +1674,14 @@ bool CodeBlock::hasGlobalResolveInfoAtBytecodeOffset(unsigned bytecodeOffset)
         return false;
     return true;
 }
+
+void CodeBlock::unlinkIncomingCalls()
+{
+#if ENABLE(JIT_OPTIMIZE_CALL)
+    while (m_incomingCalls.begin() != m_incomingCalls.end())
+        JIT::unlinkCall(m_incomingCalls.begin(), m_isConstructor, m_globalData);
+#endif
+}
 #endif
 
 void CodeBlock::shrinkToFit()
@@ -1626,6 +1691,7 @@ void CodeBlock::shrinkToFit()
 #if ENABLE(INTERPRETER)
     m_propertyAccessInstructions.shrinkToFit();
     m_globalResolveInstructions.shrinkToFit();
+    m_callInstructions.shrinkToFit();
 #endif
 #if ENABLE(JIT)
     m_structureStubInfos.shrinkToFit();
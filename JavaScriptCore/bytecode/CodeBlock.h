@@ -41,6 +41,7 @@
 #include <wtf/FastAllocBase.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefPtr.h>
+#include <wtf/SentinelLinkedList.h>
 #include <wtf/Vector.h>
 
 #if ENABLE(JIT)
@@ -59,6 +60,7 @@ namespace JSC {
         hasSeenShouldRepatch
     };
 
+    class CodeBlock;
     class ExecState;
 
     enum CodeType { GlobalCode, EvalCode, FunctionCode };
@@ -96,7 +98,18 @@ namespace JSC {
 #if ENABLE(JIT)
     struct CallLinkInfo {
         CallLinkInfo()
-            : hasSeenShouldRepatch(false)
+            : caller(0)
+            , hasSeenShouldRepatch(false)
+            , m_prev(0)
+            , m_next(0)
+        {
+        }
+
+        CallLinkInfo(WTF::SentinelTag)
+            : caller(0)
+            , hasSeenShouldRepatch(false)
+            , m_prev(0)
+            , m_next(0)
         {
         }
 
@@ -104,11 +117,27 @@ namespace JSC {
         CodeLocationDataLabelPtr hotPathBegin;
         CodeLocationNearCall hotPathOther;
         WriteBarrier<JSFunction> callee;
+        CodeBlock* caller;
         bool hasSeenShouldRepatch;
         
         void setUnlinked() { callee.clear(); }
         bool isLinked() { return callee; }
 
+        // A linked call sits on its callee CodeBlock's list of incoming calls,
+        // so that the callee can unlink it before its code is thrown away.
+        bool isOnList() const { return m_next; }
+        void remove()
+        {
+            SentinelLinkedList<CallLinkInfo>::remove(this);
+            m_prev = 0;
+            m_next = 0;
+        }
+
+        CallLinkInfo* prev() { return m_prev; }
+        void setPrev(CallLinkInfo* prev) { m_prev = prev; }
+        CallLinkInfo* next() { return m_next; }
+        void setNext(CallLinkInfo* next) { m_next = next; }
+
         bool seenOnce()
         {
             return hasSeenShouldRepatch;
@@ -118,6 +147,10 @@ namespace JSC {
         {
             hasSeenShouldRepatch = true;
         }
+
+    private:
+        CallLinkInfo* m_prev;
+        CallLinkInfo* m_next;
     };
 
     struct MethodCallLinkInfo {
@@ -304,6 +337,13 @@ namespace JSC {
         bool needsFullScopeChain() const { return m_needsFullScopeChain; }
         void setUsesEval(bool usesEval) { m_usesEval = usesEval; }
         bool usesEval() const { return m_usesEval; }
+
+        // Whether the bytecode was generated with op_debug and op_profile_* hooks, which
+        // depends on the global object having a debugger or supporting profiling at the time.
+        void setHasDebugHooks(bool hasDebugHooks) { m_hasDebugHooks = hasDebugHooks; }
+        bool hasDebugHooks() const { return m_hasDebugHooks; }
+        void setHasProfileHooks(bool hasProfileHooks) { m_hasProfileHooks = hasProfileHooks; }
+        bool hasProfileHooks() const { return m_hasProfileHooks; }
         
         void setArgumentsRegister(int argumentsRegister)
         {
@@ -350,6 +390,11 @@ namespace JSC {
             if (!m_globalData->canUseJIT())
                 m_globalResolveInstructions.append(globalResolveInstruction);
         }
+        void addCallInstruction(unsigned callInstruction)
+        {
+            if (!m_globalData->canUseJIT())
+                m_callInstructions.append(callInstruction);
+        }
         bool hasGlobalResolveInstructionAtBytecodeOffset(unsigned bytecodeOffset);
 #endif
 #if ENABLE(JIT)
@@ -375,6 +420,15 @@ namespace JSC {
 
         void addMethodCallLinkInfos(unsigned n) { m_methodCallLinkInfos.grow(n); }
         MethodCallLinkInfo& methodCallLinkInfo(int index) { return m_methodCallLinkInfos[index]; }
+
+        void linkIncomingCall(CallLinkInfo* incoming) { m_incomingCalls.push(incoming); }
+        void unlinkIncomingCalls();
+
+        // Bumped on entry by JIT code compiled under an executable memory
+        // budget, and reset by each pass that looks for cold code to discard.
+        unsigned executeCounter() const { return m_executeCounter; }
+        void resetExecuteCounter() { m_executeCounter = 0; }
+        unsigned* addressOfExecuteCounter() { return &m_executeCounter; }
 #endif
 
         // Exception handling support
@@ -498,6 +552,7 @@ namespace JSC {
         void printPutByIdOp(ExecState*, int location, Vector<Instruction>::const_iterator&, const char* op) const;
 #endif
         void visitStructures(SlotVisitor&, Instruction* vPC) const;
+        void derefStructures(Instruction* vPC) const;
 
         void createRareDataIfNecessary()
         {
@@ -521,6 +576,8 @@ namespace JSC {
         bool m_usesEval;
         bool m_isNumericCompareFunction;
         bool m_isStrictMode;
+        bool m_hasDebugHooks;
+        bool m_hasProfileHooks;
 
         CodeType m_codeType;
 
@@ -530,12 +587,15 @@ namespace JSC {
 #if ENABLE(INTERPRETER)
         Vector<unsigned> m_propertyAccessInstructions;
         Vector<unsigned> m_globalResolveInstructions;
+        Vector<unsigned> m_callInstructions;
 #endif
 #if ENABLE(JIT)
         Vector<StructureStubInfo> m_structureStubInfos;
         Vector<GlobalResolveInfo> m_globalResolveInfos;
         Vector<CallLinkInfo> m_callLinkInfos;
         Vector<MethodCallLinkInfo> m_methodCallLinkInfos;
+        SentinelLinkedList<CallLinkInfo> m_incomingCalls;
+        unsigned m_executeCounter;
 #endif
 
         Vector<unsigned> m_jumpTargets;
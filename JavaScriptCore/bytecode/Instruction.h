@@ -29,6 +29,7 @@
 #ifndef Instruction_h
 #define Instruction_h
 
+#include "CallData.h"
 #include "MacroAssembler.h"
 #include "Opcode.h"
 #include "PropertySlot.h"
@@ -36,13 +37,18 @@
 #include "StructureChain.h"
 #include <wtf/VectorTraits.h>
 
+#if ENABLE(JIT)
 #define POLYMORPHIC_LIST_CACHE_SIZE 8
+#else
+// The interpreter walks its lists linearly on every access, so keep them short.
+#define POLYMORPHIC_LIST_CACHE_SIZE 4
+#endif
 
 namespace JSC {
 
     // *Sigh*, If the JIT is enabled we need to track the stubRountine (of type CodeLocationLabel),
-    // If the JIT is not in use we don't actually need the variable (that said, if the JIT is not in use we don't
-    // curently actually use PolymorphicAccessStructureLists, which we should).  Anyway, this seems like the best
+    // If the JIT is not in use we don't actually need the variable; the interpreter instead records
+    // the cached offset (and chain length) of each entry itself.  Anyway, this seems like the best
     // solution for now - will need to something smarter if/when we actually want mixed-mode operation.
 #if ENABLE(JIT)
     typedef CodeLocationLabel PolymorphicAccessStructureListStubRoutineType;
@@ -54,7 +60,8 @@ namespace JSC {
     class Structure;
     class StructureChain;
 
-    // Structure used by op_get_by_id_self_list and op_get_by_id_proto_list instruction to hold data off the main opcode stream.
+    // Structure used by op_get_by_id_self_list, op_get_by_id_proto_list and op_put_by_id_replace_list
+    // instructions to hold data off the main opcode stream.
     struct PolymorphicAccessStructureList {
         WTF_MAKE_FAST_ALLOCATED;
     public:
@@ -66,6 +73,10 @@ namespace JSC {
                 WriteBarrierBase<Structure> proto;
                 WriteBarrierBase<StructureChain> chain;
             } u;
+#if ENABLE(INTERPRETER)
+            size_t cachedOffset;
+            size_t count;
+#endif
 
             void set(JSGlobalData& globalData, JSCell* owner, PolymorphicAccessStructureListStubRoutineType _stubRoutine, Structure* _base)
             {
@@ -158,6 +169,7 @@ namespace JSC {
         }
         Instruction(PolymorphicAccessStructureList* polymorphicStructures) { u.polymorphicStructures = polymorphicStructures; }
         Instruction(PropertySlot::GetValueFunc getterFunc) { u.getterFunc = getterFunc; }
+        Instruction(NativeFunction nativeFunction) { u.nativeFunction = nativeFunction; }
 
         union {
             Opcode opcode;
@@ -167,6 +179,7 @@ namespace JSC {
             WriteBarrierBase<JSCell> jsCell;
             PolymorphicAccessStructureList* polymorphicStructures;
             PropertySlot::GetValueFunc getterFunc;
+            NativeFunction nativeFunction;
         } u;
         
     private:
@@ -127,6 +127,7 @@ namespace JSC {
         macro(op_put_by_id, 9) \
         macro(op_put_by_id_transition, 9) \
         macro(op_put_by_id_replace, 9) \
+        macro(op_put_by_id_replace_list, 9) \
         macro(op_put_by_id_generic, 9) \
         macro(op_del_by_id, 4) \
         macro(op_get_by_val, 4) \
@@ -160,8 +161,8 @@ namespace JSC {
         \
         macro(op_new_func, 4) \
         macro(op_new_func_exp, 3) \
-        macro(op_call, 4) \
-        macro(op_call_eval, 4) \
+        macro(op_call, 6) \
+        macro(op_call_eval, 6) \
         macro(op_call_varargs, 4) \
         macro(op_load_varargs, 4) \
         macro(op_tear_off_activation, 3) \
@@ -171,7 +172,7 @@ namespace JSC {
         macro(op_ret_object_or_this, 3) \
         macro(op_method_check, 1) \
         \
-        macro(op_construct, 4) \
+        macro(op_construct, 6) \
         macro(op_strcat, 4) \
         macro(op_to_primitive, 3) \
         \
@@ -228,6 +228,8 @@ BytecodeGenerator::BytecodeGenerator(ProgramNode* programNode, ScopeChainNode* s
 {
     if (m_shouldEmitDebugHooks)
         m_codeBlock->setNeedsFullScopeChain(true);
+    m_codeBlock->setHasDebugHooks(m_shouldEmitDebugHooks);
+    m_codeBlock->setHasProfileHooks(m_shouldEmitProfileHooks);
 
     emitOpcode(op_enter);
     codeBlock->setGlobalData(m_globalData);
@@ -349,6 +351,8 @@ BytecodeGenerator::BytecodeGenerator(FunctionBodyNode* functionBody, ScopeChainN
 {
     if (m_shouldEmitDebugHooks)
         m_codeBlock->setNeedsFullScopeChain(true);
+    m_codeBlock->setHasDebugHooks(m_shouldEmitDebugHooks);
+    m_codeBlock->setHasProfileHooks(m_shouldEmitProfileHooks);
 
     codeBlock->setGlobalData(m_globalData);
     
@@ -374,7 +378,11 @@ BytecodeGenerator::BytecodeGenerator(FunctionBodyNode* functionBody, ScopeChainN
         emitInitLazyRegister(argumentsRegister);
         emitInitLazyRegister(unmodifiedArgumentsRegister);
         
-        if (m_codeBlock->isStrictMode()) {
+        // Strict mode 'arguments' holds the values the parameters had on entry. Without an
+        // activation, only this function's own code can overwrite a parameter, and it creates
+        // the arguments object before doing so (see willWriteToLocal). That lets uses that only
+        // read the length, index or forward the arguments avoid allocating it, as in non-strict code.
+        if (m_codeBlock->isStrictMode() && m_codeBlock->needsFullScopeChain()) {
             emitOpcode(op_create_arguments);
             instructions().append(argumentsRegister->index());
         }
@@ -513,6 +521,8 @@ BytecodeGenerator::BytecodeGenerator(EvalNode* evalNode, ScopeChainNode* scopeCh
 {
     if (m_shouldEmitDebugHooks || m_baseScopeDepth)
         m_codeBlock->setNeedsFullScopeChain(true);
+    m_codeBlock->setHasDebugHooks(m_shouldEmitDebugHooks);
+    m_codeBlock->setHasProfileHooks(m_shouldEmitProfileHooks);
 
     emitOpcode(op_enter);
     codeBlock->setGlobalData(m_globalData);
@@ -1625,10 +1635,10 @@ void BytecodeGenerator::createArgumentsIfNecessary()
     if (!m_codeBlock->usesArguments())
         return;
 
-    // If we're in strict mode we tear off the arguments on function
-    // entry, so there's no need to check if we need to create them
-    // now
-    if (m_codeBlock->isStrictMode())
+    // If we're in strict mode and have an activation we create the
+    // arguments on function entry, so there's no need to check if we
+    // need to create them now
+    if (m_codeBlock->isStrictMode() && m_codeBlock->needsFullScopeChain())
         return;
 
     emitOpcode(op_create_arguments);
@@ -1679,11 +1689,17 @@ RegisterID* BytecodeGenerator::emitCall(OpcodeID opcodeID, RegisterID* dst, Regi
     m_codeBlock->addCallLinkInfo();
 #endif
 
+#if ENABLE(INTERPRETER)
+    m_codeBlock->addCallInstruction(instructions().size());
+#endif
+
     // Emit call.
     emitOpcode(opcodeID);
     instructions().append(func->index()); // func
     instructions().append(callArguments.count()); // argCount
     instructions().append(callArguments.callFrame()); // registerOffset
+    instructions().append(0); // cached callee
+    instructions().append(0); // cached native function
     if (dst != ignoredResult()) {
         emitOpcode(op_call_put_result);
         instructions().append(dst->index()); // dst
@@ -1796,10 +1812,16 @@ RegisterID* BytecodeGenerator::emitConstruct(RegisterID* dst, RegisterID* func,
     m_codeBlock->addCallLinkInfo();
 #endif
 
+#if ENABLE(INTERPRETER)
+    m_codeBlock->addCallInstruction(instructions().size());
+#endif
+
     emitOpcode(op_construct);
     instructions().append(func->index()); // func
     instructions().append(callArguments.count()); // argCount
     instructions().append(callArguments.callFrame()); // registerOffset
+    instructions().append(0); // cached callee
+    instructions().append(0); // cached native function
     if (dst != ignoredResult()) {
         emitOpcode(op_call_put_result);
         instructions().append(dst->index()); // dst
@@ -116,6 +116,15 @@ namespace JSC {
         bool willResolveToArguments(const Identifier&);
         RegisterID* uncheckedRegisterForArguments();
 
+        // Must be called before code that overwrites a local returned by registerFor.
+        // Strict mode 'arguments' does not alias the parameters, so it has to be created
+        // while they still hold the values they were called with.
+        void willWriteToLocal(RegisterID* local)
+        {
+            if (local->index() < 0 && m_codeBlock->isStrictMode())
+                createArgumentsIfNecessary();
+        }
+
         // Behaves as registerFor does, but ignores dynamic scope as
         // dynamic scope should not interfere with const initialisation
         RegisterID* constRegisterFor(const Identifier&);
@@ -22,6 +22,7 @@
 #include "config.h"
 #include "Debugger.h"
 
+#include "CodeBlock.h"
 #include "Error.h"
 #include "Interpreter.h"
 #include "JSFunction.h"
@@ -62,6 +63,15 @@ inline Recompiler::~Recompiler()
         m_debugger->sourceParsed(iter->second, iter->first, -1, UString());
 }
 
+// Code generated before a debugger was attached to its global object, or before profiling
+// was turned on, lacks the hooks they need; code generated while they were on carries
+// hooks that only slow it down once they are gone.
+bool hasCurrentHooks(CodeBlock& codeBlock, JSGlobalObject* globalObject)
+{
+    return codeBlock.hasDebugHooks() == !!globalObject->debugger()
+        && codeBlock.hasProfileHooks() == globalObject->supportsProfiling();
+}
+
 inline void Recompiler::operator()(JSCell* cell)
 {
     if (!cell->inherits(&JSFunction::s_info))
@@ -78,10 +88,16 @@ inline void Recompiler::operator()(JSCell* cell)
     if (!m_functionExecutables.add(executable).second)
         return;
 
-    ExecState* exec = function->scope()->globalObject->JSGlobalObject::globalExec();
-    executable->discardCode();
-    if (m_debugger == function->scope()->globalObject->debugger())
-        m_sourceProviders.add(executable->source().provider(), exec);
+    JSGlobalObject* globalObject = function->scope()->globalObject.get();
+    if (m_debugger == globalObject->debugger())
+        m_sourceProviders.add(executable->source().provider(), globalObject->JSGlobalObject::globalExec());
+
+    // Leave the code of unaffected global objects alone, so that attaching a debugger
+    // to one page does not throw away the compiled code of all the others.
+    if (executable->isGeneratedForCall() && !hasCurrentHooks(executable->generatedBytecodeForCall(), globalObject))
+        executable->discardCode();
+    else if (executable->isGeneratedForConstruct() && !hasCurrentHooks(executable->generatedBytecodeForConstruct(), globalObject))
+        executable->discardCode();
 }
 
 } // namespace
@@ -138,6 +138,28 @@ public:
     }
 #endif
 
+    // Add the block containing 'owner' to the heap's remembered set; see JIT::emitWriteBarrier.
+    void writeBarrier(GPRReg owner, GPRReg scratch)
+    {
+#if ENABLE(REMEMBERED_SET)
+        move(owner, scratch);
+        andPtr(TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch);
+        store32(TrustedImm32(1), Address(scratch, MarkedBlock::offsetOfIsRemembered()));
+#else
+        UNUSED_PARAM(owner);
+        UNUSED_PARAM(scratch);
+#endif
+    }
+
+    void writeBarrier(JSCell* owner)
+    {
+#if ENABLE(REMEMBERED_SET)
+        store32(TrustedImm32(1), MarkedBlock::blockFor(owner)->addressOfIsRemembered());
+#else
+        UNUSED_PARAM(owner);
+#endif
+    }
+
     static Address addressForGlobalVar(GPRReg global, int32_t varNumber)
     {
         return Address(global, varNumber * sizeof(Register));
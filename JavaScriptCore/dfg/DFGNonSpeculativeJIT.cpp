@@ -582,6 +582,7 @@ void NonSpeculativeJIT::compile(SpeculationCheckIndexIterator& checkIterator, No
         JSVariableObject* globalObject = m_jit.codeBlock()->globalObject();
         m_jit.loadPtr(globalObject->addressOfRegisters(), temp.gpr());
         m_jit.storePtr(value.gpr(), JITCompiler::addressForGlobalVar(temp.gpr(), node.varNumber()));
+        m_jit.writeBarrier(globalObject);
 
         noResult(m_compileIndex);
         break;
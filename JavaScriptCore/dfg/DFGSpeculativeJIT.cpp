@@ -689,6 +689,9 @@ void SpeculativeJIT::compile(Node& node)
             speculationCheck(m_jit.branchPtr(MacroAssembler::NotEqual, MacroAssembler::Address(baseReg), MacroAssembler::TrustedImmPtr(m_jit.globalData()->jsArrayVPtr)));
         speculationCheck(m_jit.branch32(MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, JSArray::vectorLengthOffset())));
 
+        // storageReg is free until the storage is loaded, so use it as the barrier's scratch.
+        m_jit.writeBarrier(baseReg, storageReg);
+
         // Get the array storage.
         m_jit.loadPtr(MacroAssembler::Address(baseReg, JSArray::storageOffset()), storageReg);
 
@@ -718,6 +721,13 @@ void SpeculativeJIT::compile(Node& node)
         JSValueOperand value(this, node.child3);
         GPRTemporary storage(this, base); // storage may overwrite base.
 
+#if ENABLE(REMEMBERED_SET)
+        {
+            GPRTemporary scratch(this);
+            m_jit.writeBarrier(base.gpr(), scratch.gpr());
+        }
+#endif
+
         // Get the array storage.
         GPRReg storageReg = storage.gpr();
         m_jit.loadPtr(MacroAssembler::Address(base.gpr(), JSArray::storageOffset()), storageReg);
@@ -857,6 +867,7 @@ void SpeculativeJIT::compile(Node& node)
         JSVariableObject* globalObject = m_jit.codeBlock()->globalObject();
         m_jit.loadPtr(globalObject->addressOfRegisters(), temp.gpr());
         m_jit.storePtr(value.gpr(), JITCompiler::addressForGlobalVar(temp.gpr(), node.varNumber()));
+        m_jit.writeBarrier(globalObject);
 
         noResult(m_compileIndex);
         break;
@@ -53,8 +53,8 @@ __asm EncodedJSValue cti_op_pre_inc(STUB_ARGS_DECLARATION)
     bx lr
 }
 
-extern "C" int JITStubThunked_timeout_check(STUB_ARGS_DECLARATION);
-__asm int cti_timeout_check(STUB_ARGS_DECLARATION)
+extern "C" void JITStubThunked_timeout_check(STUB_ARGS_DECLARATION);
+__asm void cti_timeout_check(STUB_ARGS_DECLARATION)
 {
     PRESERVE8
     IMPORT JITStubThunked_timeout_check
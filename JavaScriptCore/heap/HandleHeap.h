@@ -63,7 +63,10 @@ public:
     HandleSlot copyWeak(HandleSlot);
 
     void markStrongHandles(HeapRootVisitor&);
-    void markWeakHandles(HeapRootVisitor&);
+    // A collection that does not visit every live cell sees only some of the opaque roots,
+    // so it keeps alive every weak handle whose owner would have consulted them.
+    enum OpaqueRootsCompleteness { OpaqueRootsAreComplete, OpaqueRootsMayBeIncomplete };
+    void markWeakHandles(HeapRootVisitor&, OpaqueRootsCompleteness);
     void finalizeWeakHandles();
 
     void writeBarrier(HandleSlot, const JSValue&);
@@ -31,6 +31,7 @@
 #include "JSONObject.h"
 #include "Tracing.h"
 #include <algorithm>
+#include <wtf/CurrentTime.h>
 
 #define COLLECT_ON_EVERY_SLOW_ALLOCATION 0
 
@@ -40,6 +41,12 @@ namespace JSC {
 
 const size_t minBytesPerCycle = 512 * 1024;
 
+#if ENABLE(INCREMENTAL_MARKING)
+// While an incremental cycle is running, the allocator comes back for another slice
+// of marking after this many bytes.
+const size_t bytesBetweenMarkingSlices = 64 * 1024;
+#endif
+
 Heap::Heap(JSGlobalData* globalData)
     : m_operationInProgress(NoOperation)
     , m_markedSpace(globalData)
@@ -47,9 +54,19 @@ Heap::Heap(JSGlobalData* globalData)
     , m_activityCallback(DefaultGCActivityCallback::create(this))
     , m_globalData(globalData)
     , m_machineThreads(this)
-    , m_markStack(globalData->jsArrayVPtr)
+    , m_sharedData(globalData)
+    , m_markStack(m_sharedData, globalData->jsArrayVPtr)
     , m_handleHeap(globalData)
     , m_extraCost(0)
+#if ENABLE(GGC)
+    , m_sizeAfterLastFullCollection(0)
+    , m_nextCollectionIsFull(true)
+#endif
+#if ENABLE(INCREMENTAL_MARKING)
+    , m_markingPauseBudget(0)
+    , m_isMarkingIncrementally(false)
+    , m_incrementalMarkingAllocationLimit(0)
+#endif
 {
     m_markedSpace.setHighWaterMark(minBytesPerCycle);
     (*m_activityCallback)();
@@ -81,6 +98,13 @@ void Heap::destroy()
 
     delete m_markListSet;
     m_markListSet = 0;
+#if ENABLE(INCREMENTAL_MARKING)
+    if (m_isMarkingIncrementally) {
+        m_markStack.drain();
+        m_markStack.reset();
+        m_isMarkingIncrementally = false;
+    }
+#endif
     m_markedSpace.clearMarks();
     m_handleHeap.finalizeWeakHandles();
     m_markedSpace.destroy();
@@ -119,7 +143,14 @@ void* Heap::allocateSlowCase(size_t bytes)
     ASSERT(m_operationInProgress == NoOperation);
 #endif
 
-    reset(DoNotSweep);
+#if ENABLE(INCREMENTAL_MARKING)
+    if (m_isMarkingIncrementally || shouldBeginIncrementalMarking())
+        markIncrementally();
+    else
+        reset(AllocationCollection, SweepLazily);
+#else
+    reset(AllocationCollection, SweepLazily);
+#endif
 
     m_operationInProgress = Allocation;
     void* result = m_markedSpace.allocate(bytes);
@@ -190,7 +221,22 @@ inline RegisterFile& Heap::registerFile()
     return m_globalData->interpreter->registerFile();
 }
 
-void Heap::markRoots()
+#if ENABLE(REMEMBERED_SET)
+class RememberedCellVisitor {
+public:
+    RememberedCellVisitor(MarkStack& visitor)
+        : m_visitor(visitor)
+    {
+    }
+
+    void operator()(JSCell* cell) { m_visitor.appendChildren(cell); }
+
+private:
+    MarkStack& m_visitor;
+};
+#endif
+
+void Heap::markRoots(bool fullGC)
 {
 #ifndef NDEBUG
     if (m_globalData->isSharedInstance()) {
@@ -219,45 +265,73 @@ void Heap::markRoots()
     ConservativeRoots registerFileRoots(this);
     registerFile().gatherConservativeRoots(registerFileRoots);
 
-    m_markedSpace.clearMarks();
+#if ENABLE(INCREMENTAL_MARKING)
+    if (m_isMarkingIncrementally) {
+        // The slices have marked everything that was reachable when they saw it. What is
+        // left is whatever the program has since stored into cells they had already
+        // visited, or into the roots.
+        RememberedCellVisitor rememberedCellVisitor(visitor);
+        m_markedSpace.forEachRememberedCell(rememberedCellVisitor);
+    } else
+#endif
+    if (fullGC)
+        m_markedSpace.clearMarks();
+#if ENABLE(GGC)
+    else {
+        // Old cells keep their marks, so the trace stops at the old generation. The only
+        // old cells it has to look inside are those that may have been handed a pointer
+        // to a young cell since the last collection.
+        m_markedSpace.clearYoungMarks();
+        RememberedCellVisitor rememberedCellVisitor(visitor);
+        m_markedSpace.forEachRememberedCell(rememberedCellVisitor);
+    }
+#endif
 
+    // Queue both sets of conservative roots before draining so that the helper
+    // threads have plenty to steal from the start.
     visitor.append(machineThreadRoots);
-    visitor.drain();
-
     visitor.append(registerFileRoots);
-    visitor.drain();
+    visitor.drainInParallel();
 
     markProtectedObjects(heapRootMarker);
-    visitor.drain();
+    visitor.drainInParallel();
     
     markTempSortVectors(heapRootMarker);
-    visitor.drain();
+    visitor.drainInParallel();
 
     if (m_markListSet && m_markListSet->size())
         MarkedArgumentBuffer::markLists(heapRootMarker, *m_markListSet);
     if (m_globalData->exception)
         heapRootMarker.mark(&m_globalData->exception);
-    visitor.drain();
+    visitor.drainInParallel();
 
     m_handleHeap.markStrongHandles(heapRootMarker);
-    visitor.drain();
+    visitor.drainInParallel();
 
     m_handleStack.mark(heapRootMarker);
-    visitor.drain();
+    visitor.drainInParallel();
 
     // Mark the small strings cache as late as possible, since it will clear
     // itself if nothing else has marked it.
     // FIXME: Change the small strings cache to use Weak<T>.
     m_globalData->smallStrings.visitChildren(heapRootMarker);
-    visitor.drain();
+    visitor.drainInParallel();
     
     // Weak handles must be marked last, because their owners use the set of
-    // opaque roots to determine reachability.
+    // opaque roots to determine reachability. A young collection never looks inside
+    // old cells, so it misses the opaque roots they would have added.
+    HandleHeap::OpaqueRootsCompleteness opaqueRootsCompleteness = fullGC ? HandleHeap::OpaqueRootsAreComplete : HandleHeap::OpaqueRootsMayBeIncomplete;
+#if ENABLE(INCREMENTAL_MARKING)
+    // Nor does the final pause of an incremental cycle look again inside the cells the
+    // slices visited, whose opaque roots the program may have changed since.
+    if (m_isMarkingIncrementally)
+        opaqueRootsCompleteness = HandleHeap::OpaqueRootsMayBeIncomplete;
+#endif
     int lastOpaqueRootCount;
     do {
         lastOpaqueRootCount = visitor.opaqueRootCount();
-        m_handleHeap.markWeakHandles(heapRootMarker);
-        visitor.drain();
+        m_handleHeap.markWeakHandles(heapRootMarker, opaqueRootsCompleteness);
+        visitor.drainInParallel();
     // If the set of opaque roots has grown, more weak handles may have become reachable.
     } while (lastOpaqueRootCount != visitor.opaqueRootCount());
 
@@ -381,20 +455,29 @@ bool Heap::isBusy()
     return m_operationInProgress != NoOperation;
 }
 
-void Heap::collectAllGarbage()
+void Heap::collectAllGarbage(SweepMode sweepMode)
 {
     if (!m_globalData->dynamicGlobalObject)
         m_globalData->recompileAllJSFunctions();
 
-    reset(DoSweep);
+    reset(ExplicitCollection, sweepMode);
 }
 
-void Heap::reset(SweepToggle sweepToggle)
+void Heap::reset(CollectionType collectionType, SweepMode sweepMode)
 {
     ASSERT(globalData()->identifierTable == wtfThreadData().currentIdentifierTable());
     JAVASCRIPTCORE_GC_BEGIN();
 
-    markRoots();
+#if ENABLE(GGC)
+    // An incremental cycle only ever begins when the next collection is full.
+    bool fullGC = collectionType == ExplicitCollection || m_nextCollectionIsFull;
+#else
+    bool fullGC = true;
+#endif
+    markRoots(fullGC);
+#if ENABLE(INCREMENTAL_MARKING)
+    m_isMarkingIncrementally = false;
+#endif
     m_handleHeap.finalizeWeakHandles();
 
     JAVASCRIPTCORE_GC_MARKED();
@@ -402,27 +485,117 @@ void Heap::reset(SweepToggle sweepToggle)
     m_markedSpace.reset();
     m_extraCost = 0;
 
+    // Every heap, including those of workers that never see collectAllGarbage(), gets here
+    // regularly. Register file pages are only returned once a whole collection cycle has
+    // gone by without recursing into them, so steady deep recursion does not thrash.
+    registerFile().releaseExcessCapacity();
+
 #if ENABLE(JSC_ZOMBIES)
-    sweepToggle = DoSweep;
+    // Zombies must replace dead cells right away, so they cannot wait for the allocator.
+    sweepMode = SweepNow;
 #endif
 
-    if (sweepToggle == DoSweep) {
+    if (sweepMode == SweepNow) {
         m_markedSpace.sweep();
         m_markedSpace.shrink();
+    } else {
+        // Keep finalization out of the pause: the allocator sweeps blocks as it needs them.
+        // Explicit collections come from idle timers and memory pressure, so they also give
+        // back the blocks that no longer hold any live cell.
+        m_markedSpace.beginLazySweep();
+        if (collectionType == ExplicitCollection)
+            m_markedSpace.shrink();
     }
 
     // To avoid pathological GC churn in large heaps, we set the allocation high
     // water mark to be proportional to the current size of the heap. The exact
     // proportion is a bit arbitrary. A 2X multiplier gives a 1:1 (heap size :
     // new bytes allocated) proportion, and seems to work well in benchmarks.
-    size_t proportionalBytes = 2 * m_markedSpace.size();
+    size_t size = m_markedSpace.size();
+    size_t proportionalBytes = 2 * size;
     m_markedSpace.setHighWaterMark(max(proportionalBytes, minBytesPerCycle));
 
+#if ENABLE(GGC)
+    // Young collections never free old cells, so once the old generation has
+    // doubled since the last full collection, the next collection is a full one.
+    if (fullGC)
+        m_sizeAfterLastFullCollection = size;
+    m_nextCollectionIsFull = size > 2 * max(m_sizeAfterLastFullCollection, minBytesPerCycle);
+#endif
+
     JAVASCRIPTCORE_GC_END();
 
     (*m_activityCallback)();
 }
 
+#if ENABLE(INCREMENTAL_MARKING)
+bool Heap::shouldBeginIncrementalMarking()
+{
+    if (!m_markingPauseBudget)
+        return false;
+#if ENABLE(GGC)
+    // Young collections are short enough to run in a single pause.
+    return m_nextCollectionIsFull;
+#else
+    return true;
+#endif
+}
+
+void Heap::beginIncrementalMarking()
+{
+    ASSERT(!m_isMarkingIncrementally);
+    ASSERT(m_operationInProgress == NoOperation);
+    m_operationInProgress = Collection;
+
+    void* dummy;
+
+    MarkStack& visitor = m_markStack;
+    HeapRootVisitor heapRootMarker(visitor);
+
+    ConservativeRoots machineThreadRoots(this);
+    m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
+
+    ConservativeRoots registerFileRoots(this);
+    registerFile().gatherConservativeRoots(registerFileRoots);
+
+    m_markedSpace.beginIncrementalMarking();
+
+    // The final pause visits every root again. These are only here to give the
+    // slices most of the heap to work through.
+    visitor.append(machineThreadRoots);
+    visitor.append(registerFileRoots);
+    markProtectedObjects(heapRootMarker);
+    m_handleHeap.markStrongHandles(heapRootMarker);
+
+    // If the program allocates faster than the slices can mark, stop handing out new
+    // blocks once it has gone through half a cycle's worth, and finish in one pause.
+    m_incrementalMarkingAllocationLimit = m_markedSpace.waterMark() + m_markedSpace.highWaterMark() / 2;
+    m_isMarkingIncrementally = true;
+
+    m_operationInProgress = NoOperation;
+}
+
+void Heap::markIncrementally()
+{
+    ASSERT(m_operationInProgress == NoOperation);
+    double deadline = currentTime() + m_markingPauseBudget;
+
+    if (!m_isMarkingIncrementally)
+        beginIncrementalMarking();
+
+    m_operationInProgress = Collection;
+    bool isDone = m_markStack.drainUntil(deadline);
+    m_operationInProgress = NoOperation;
+
+    if (isDone || m_markedSpace.waterMark() >= m_incrementalMarkingAllocationLimit) {
+        reset(AllocationCollection, SweepLazily);
+        return;
+    }
+
+    m_markedSpace.setHighWaterMark(m_markedSpace.waterMark() + bytesBetweenMarkingSlices);
+}
+#endif
+
 void Heap::setActivityCallback(PassOwnPtr<GCActivityCallback> activityCallback)
 {
     m_activityCallback = activityCallback;
@@ -75,7 +75,22 @@ namespace JSC {
 
         bool isBusy(); // true if an allocation or collection is in progress
         void* allocate(size_t);
-        void collectAllGarbage();
+
+        // Collects the whole heap. Dead cells are finalized as allocation reaches their blocks;
+        // only blocks with no live cells are freed before returning. SweepNow finalizes every
+        // dead cell inside the pause, for callers that need that more than a short pause.
+        enum SweepMode { SweepLazily, SweepNow };
+        void collectAllGarbage(SweepMode = SweepLazily);
+
+#if ENABLE(INCREMENTAL_MARKING)
+        // When non-zero, collections triggered by allocation mark the heap in slices of at
+        // most this many seconds, interleaved with the program, followed by a short final
+        // pause that revisits the roots and the remembered set. 0, the default, marks the
+        // whole heap in one pause.
+        void setMarkingPauseBudget(double seconds) { m_markingPauseBudget = seconds; }
+        double markingPauseBudget() const { return m_markingPauseBudget; }
+        bool isMarkingIncrementally() const { return m_isMarkingIncrementally; }
+#endif
 
         void reportExtraMemoryCost(size_t cost);
 
@@ -114,12 +129,17 @@ namespace JSC {
         void* allocateSlowCase(size_t);
         void reportExtraMemoryCostSlowCase(size_t);
 
-        void markRoots();
+        void markRoots(bool fullGC);
+#if ENABLE(INCREMENTAL_MARKING)
+        bool shouldBeginIncrementalMarking();
+        void beginIncrementalMarking();
+        void markIncrementally();
+#endif
         void markProtectedObjects(HeapRootVisitor&);
         void markTempSortVectors(HeapRootVisitor&);
 
-        enum SweepToggle { DoNotSweep, DoSweep };
-        void reset(SweepToggle);
+        enum CollectionType { AllocationCollection, ExplicitCollection };
+        void reset(CollectionType, SweepMode);
 
         RegisterFile& registerFile();
 
@@ -136,11 +156,23 @@ namespace JSC {
         JSGlobalData* m_globalData;
         
         MachineThreads m_machineThreads;
+        MarkStackThreadSharedData m_sharedData;
         MarkStack m_markStack;
         HandleHeap m_handleHeap;
         HandleStack m_handleStack;
 
         size_t m_extraCost;
+
+#if ENABLE(GGC)
+        size_t m_sizeAfterLastFullCollection;
+        bool m_nextCollectionIsFull;
+#endif
+
+#if ENABLE(INCREMENTAL_MARKING)
+        double m_markingPauseBudget;
+        bool m_isMarkingIncrementally;
+        size_t m_incrementalMarkingAllocationLimit;
+#endif
     };
 
     inline bool Heap::isMarked(const JSCell* cell)
@@ -30,12 +30,101 @@
 #include "Heap.h"
 #include "JSArray.h"
 #include "JSCell.h"
+#include "JSGlobalData.h"
 #include "JSObject.h"
 #include "ScopeChain.h"
 #include "Structure.h"
+#include <wtf/CurrentTime.h>
 
 namespace JSC {
 
+#if ENABLE(PARALLEL_GC)
+// Helper threads never outnumber the cores, and past this many the shared
+// stack becomes the bottleneck.
+static const unsigned maximumNumberOfMarkers = 8;
+
+// A marker hands cells to the shared stack only when it has at least twice
+// this many, and checks whether it should at most once per this many visits.
+static const unsigned minimumNumberOfCellsToKeep = 64;
+static const unsigned visitsBetweenDonations = 128;
+
+// An idle marker steals at least this many cells at a time so that it does
+// not come back for the lock after every cell.
+static const size_t minimumNumberOfCellsToSteal = 100;
+#endif
+
+#if ENABLE(INCREMENTAL_MARKING)
+// Reading the clock after every visit would cost more than most visits do.
+static const unsigned visitsBetweenDeadlineChecks = 128;
+#endif
+
+MarkStackThreadSharedData::MarkStackThreadSharedData(JSGlobalData* globalData)
+    : m_globalData(globalData)
+#if ENABLE(PARALLEL_GC)
+    , m_haveStartedMarkingThreads(false)
+    , m_numberOfActiveParallelMarkers(0)
+    , m_parallelMarkersShouldExit(false)
+#endif
+{
+}
+
+MarkStackThreadSharedData::~MarkStackThreadSharedData()
+{
+#if ENABLE(PARALLEL_GC)
+    {
+        MutexLocker locker(m_markingLock);
+        m_parallelMarkersShouldExit = true;
+        m_markingCondition.broadcast();
+    }
+    for (unsigned i = 0; i < m_markingThreads.size(); ++i)
+        waitForThreadCompletion(m_markingThreads[i], 0);
+#endif
+}
+
+void MarkStackThreadSharedData::reset()
+{
+#if ENABLE(PARALLEL_GC)
+    ASSERT(m_sharedMarkStack.isEmpty());
+    ASSERT(!m_numberOfActiveParallelMarkers);
+    m_sharedMarkStack.shrinkCapacity(0);
+    m_opaqueRoots.clear();
+#endif
+}
+
+#if ENABLE(PARALLEL_GC)
+void MarkStackThreadSharedData::startMarkingThreads()
+{
+    // Started by the first collection, so heaps that never collect, such as those of
+    // short-lived workers, never pay for idle threads and their stacks.
+    ASSERT(!m_haveStartedMarkingThreads);
+    m_haveStartedMarkingThreads = true;
+
+    // The collector thread is a marker too.
+    unsigned numberOfMarkers = std::min(MarkStack::numberOfProcessorCores(), maximumNumberOfMarkers);
+    for (unsigned i = 1; i < numberOfMarkers; ++i) {
+        ThreadIdentifier thread = createThread(markingThreadStartFunc, this, "JavaScriptCore::Marking");
+        if (!thread)
+            break;
+        m_markingThreads.append(thread);
+    }
+}
+
+void* MarkStackThreadSharedData::markingThreadStartFunc(void* sharedData)
+{
+    static_cast<MarkStackThreadSharedData*>(sharedData)->markingThreadMain();
+    return 0;
+}
+
+void MarkStackThreadSharedData::markingThreadMain()
+{
+    MarkStack markStack(*this, m_globalData->jsArrayVPtr);
+    markStack.m_isInParallelMode = true;
+    // Only returns once the heap is going away.
+    markStack.drainFromShared(MarkStack::SlaveDrain);
+    markStack.m_isInParallelMode = false;
+}
+#endif
+
 size_t MarkStack::s_pageSize = 0;
 
 void MarkStack::reset()
@@ -44,6 +133,29 @@ void MarkStack::reset()
     m_values.shrinkAllocation(s_pageSize);
     m_markSets.shrinkAllocation(s_pageSize);
     m_opaqueRoots.clear();
+    m_shared.reset();
+}
+
+bool MarkStack::containsOpaqueRoot(void* root)
+{
+#if ENABLE(PARALLEL_GC)
+    ASSERT(!m_isInParallelMode);
+    return m_opaqueRoots.contains(root) || m_shared.m_opaqueRoots.contains(root);
+#else
+    return m_opaqueRoots.contains(root);
+#endif
+}
+
+int MarkStack::opaqueRootCount()
+{
+#if ENABLE(PARALLEL_GC)
+    // Only meaningful between drains, once every marker has merged its roots.
+    ASSERT(!m_isInParallelMode);
+    ASSERT(m_opaqueRoots.isEmpty() || m_shared.m_opaqueRoots.isEmpty());
+    return m_opaqueRoots.size() + m_shared.m_opaqueRoots.size();
+#else
+    return m_opaqueRoots.size();
+#endif
 }
 
 void MarkStack::append(ConservativeRoots& conservativeRoots)
@@ -124,12 +236,158 @@ void MarkStack::drain()
 
             visitChildren(cell);
         }
-        while (!m_values.isEmpty())
+        while (!m_values.isEmpty()) {
             visitChildren(m_values.removeLast());
+#if ENABLE(PARALLEL_GC)
+            if (m_isInParallelMode && !m_visitsUntilNextDonation--)
+                donateKnownParallel();
+#endif
+        }
     }
 #if !ASSERT_DISABLED
     m_isDraining = false;
 #endif
 }
 
+#if ENABLE(INCREMENTAL_MARKING)
+void MarkStack::appendMarkSetValues()
+{
+    while (!m_markSets.isEmpty()) {
+        MarkSet current = m_markSets.removeLast();
+        for (JSValue* value = current.m_values; value != current.m_end; ++value) {
+            if (*value)
+                internalAppend(*value);
+        }
+    }
+}
+
+bool MarkStack::drainUntil(double deadline)
+{
+#if !ASSERT_DISABLED
+    ASSERT(!m_isDraining);
+    m_isDraining = true;
+#endif
+    do {
+        appendMarkSetValues();
+        for (unsigned i = 0; i < visitsBetweenDeadlineChecks && !m_values.isEmpty(); ++i)
+            visitChildren(m_values.removeLast());
+    } while ((!m_values.isEmpty() || !m_markSets.isEmpty()) && currentTime() < deadline);
+    appendMarkSetValues();
+#if !ASSERT_DISABLED
+    m_isDraining = false;
+#endif
+    return m_values.isEmpty();
+}
+#endif
+
+void MarkStack::drainInParallel()
+{
+#if ENABLE(PARALLEL_GC)
+    if (!m_shared.m_haveStartedMarkingThreads)
+        m_shared.startMarkingThreads();
+    if (!m_shared.m_markingThreads.isEmpty()) {
+        m_isInParallelMode = true;
+        m_visitsUntilNextDonation = 0;
+        drain();
+        drainFromShared(MasterDrain);
+        m_isInParallelMode = false;
+        MutexLocker locker(m_shared.m_markingLock);
+        mergeOpaqueRoots();
+        return;
+    }
+#endif
+    drain();
+}
+
+#if ENABLE(PARALLEL_GC)
+void MarkStack::donateKnownParallel()
+{
+    m_visitsUntilNextDonation = visitsBetweenDonations;
+
+    // Keep enough work for ourselves, and leave the lock alone while the
+    // other markers still have something to steal.
+    if (m_values.size() < minimumNumberOfCellsToKeep * 2)
+        return;
+    if (!m_shared.m_markingLock.tryLock())
+        return;
+    if (m_shared.m_sharedMarkStack.isEmpty()
+        && m_shared.m_numberOfActiveParallelMarkers < m_shared.m_markingThreads.size() + 1) {
+        size_t cellsToDonate = m_values.size() / 2;
+        m_shared.m_sharedMarkStack.reserveCapacity(cellsToDonate);
+        for (size_t i = 0; i < cellsToDonate; ++i)
+            m_shared.m_sharedMarkStack.append(m_values.removeLast());
+        m_shared.m_markingCondition.broadcast();
+    }
+    m_shared.m_markingLock.unlock();
+}
+
+void MarkStack::drainFromShared(SharedDrainMode sharedDrainMode)
+{
+    ASSERT(m_isInParallelMode);
+    ASSERT(m_markSets.isEmpty());
+    ASSERT(m_values.isEmpty());
+
+    {
+        MutexLocker locker(m_shared.m_markingLock);
+        m_shared.m_numberOfActiveParallelMarkers++;
+    }
+
+    while (true) {
+        {
+            MutexLocker locker(m_shared.m_markingLock);
+
+            // The collector thread reads the merged roots once marking is done.
+            if (sharedDrainMode == SlaveDrain)
+                mergeOpaqueRoots();
+
+            m_shared.m_numberOfActiveParallelMarkers--;
+
+            if (sharedDrainMode == MasterDrain) {
+                // Marking is over once nobody is working and nothing is left to steal.
+                while (true) {
+                    if (!m_shared.m_numberOfActiveParallelMarkers && m_shared.m_sharedMarkStack.isEmpty())
+                        return;
+                    if (!m_shared.m_sharedMarkStack.isEmpty())
+                        break;
+                    m_shared.m_markingCondition.wait(m_shared.m_markingLock);
+                }
+            } else {
+                ASSERT(sharedDrainMode == SlaveDrain);
+                // The collector thread may be waiting for the last marker to go idle.
+                if (!m_shared.m_numberOfActiveParallelMarkers && m_shared.m_sharedMarkStack.isEmpty())
+                    m_shared.m_markingCondition.broadcast();
+
+                while (m_shared.m_sharedMarkStack.isEmpty() && !m_shared.m_parallelMarkersShouldExit)
+                    m_shared.m_markingCondition.wait(m_shared.m_markingLock);
+
+                if (m_shared.m_parallelMarkersShouldExit)
+                    return;
+            }
+
+            size_t sharedSize = m_shared.m_sharedMarkStack.size();
+            size_t cellsToSteal = std::min(sharedSize, std::max(minimumNumberOfCellsToSteal, sharedSize / (m_shared.m_markingThreads.size() + 1)));
+            for (size_t i = 0; i < cellsToSteal; ++i) {
+                m_values.append(m_shared.m_sharedMarkStack.last());
+                m_shared.m_sharedMarkStack.removeLast();
+            }
+
+            m_shared.m_numberOfActiveParallelMarkers++;
+        }
+
+        drain();
+    }
+}
+
+// Must be called with m_shared.m_markingLock held.
+void MarkStack::mergeOpaqueRoots()
+{
+    if (m_opaqueRoots.isEmpty())
+        return;
+    HashSet<void*>::iterator end = m_opaqueRoots.end();
+    for (HashSet<void*>::iterator it = m_opaqueRoots.begin(); it != end; ++it)
+        m_shared.m_opaqueRoots.add(*it);
+    m_opaqueRoots.clear();
+}
+#endif
+
 } // namespace JSC
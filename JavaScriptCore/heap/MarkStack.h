@@ -33,6 +33,7 @@
 #include <wtf/Vector.h>
 #include <wtf/Noncopyable.h>
 #include <wtf/OSAllocator.h>
+#include <wtf/Threading.h>
 
 namespace JSC {
 
@@ -41,12 +42,55 @@ namespace JSC {
     class Register;
     
     enum MarkSetProperties { MayContainNullValues, NoNullValues };
+
+    // State shared by the collector thread and the helper threads that mark
+    // alongside it: a pool of cells that idle markers steal from, and the
+    // opaque roots found by every marker.
+    class MarkStackThreadSharedData {
+        WTF_MAKE_NONCOPYABLE(MarkStackThreadSharedData);
+    public:
+        MarkStackThreadSharedData(JSGlobalData*);
+        ~MarkStackThreadSharedData();
+
+        void reset();
+
+    private:
+        friend class MarkStack;
+
+#if ENABLE(PARALLEL_GC)
+        void startMarkingThreads();
+        static void* markingThreadStartFunc(void* sharedData);
+        void markingThreadMain();
+#endif
+
+        JSGlobalData* m_globalData;
+
+#if ENABLE(PARALLEL_GC)
+        Vector<ThreadIdentifier> m_markingThreads;
+        bool m_haveStartedMarkingThreads;
+
+        Mutex m_markingLock;
+        ThreadCondition m_markingCondition;
+        Vector<JSCell*> m_sharedMarkStack;
+        unsigned m_numberOfActiveParallelMarkers;
+        bool m_parallelMarkersShouldExit;
+
+        // Guarded by m_markingLock.
+        HashSet<void*> m_opaqueRoots;
+#endif
+    };
     
     class MarkStack {
         WTF_MAKE_NONCOPYABLE(MarkStack);
+        friend class MarkStackThreadSharedData;
     public:
-        MarkStack(void* jsArrayVPtr)
+        MarkStack(MarkStackThreadSharedData& shared, void* jsArrayVPtr)
             : m_jsArrayVPtr(jsArrayVPtr)
+            , m_shared(shared)
+#if ENABLE(PARALLEL_GC)
+            , m_isInParallelMode(false)
+            , m_visitsUntilNextDonation(0)
+#endif
 #if !ASSERT_DISABLED
             , m_isCheckingForDefaultMarkViolation(false)
             , m_isDraining(false)
@@ -71,11 +115,24 @@ namespace JSC {
         
         void append(ConservativeRoots&);
 
+#if ENABLE(REMEMBERED_SET)
+        // Queues a cell that is already marked so that its children are visited again.
+        void appendChildren(JSCell* cell) { m_values.append(cell); }
+#endif
+
         bool addOpaqueRoot(void* root) { return m_opaqueRoots.add(root).second; }
-        bool containsOpaqueRoot(void* root) { return m_opaqueRoots.contains(root); }
-        int opaqueRootCount() { return m_opaqueRoots.size(); }
+        bool containsOpaqueRoot(void*);
+        int opaqueRootCount();
 
         void drain();
+        // Like drain(), but lets the helper threads share the work when there are any.
+        void drainInParallel();
+#if ENABLE(INCREMENTAL_MARKING)
+        // Like drain(), but gives up at the deadline (a currentTime() value). Returns true
+        // if there is nothing left to visit. Either way, no MarkSet is left on the stack,
+        // since the mutator may move the values one points to.
+        bool drainUntil(double deadline);
+#endif
         void reset();
 
     private:
@@ -87,6 +144,16 @@ namespace JSC {
         void internalAppend(JSCell*);
         void internalAppend(JSValue);
         void visitChildren(JSCell*);
+#if ENABLE(INCREMENTAL_MARKING)
+        void appendMarkSetValues();
+#endif
+
+#if ENABLE(PARALLEL_GC)
+        enum SharedDrainMode { SlaveDrain, MasterDrain };
+        void drainFromShared(SharedDrainMode);
+        void donateKnownParallel();
+        void mergeOpaqueRoots();
+#endif
 
         struct MarkSet {
             MarkSet(JSValue* values, JSValue* end, MarkSetProperties properties)
@@ -188,12 +255,20 @@ namespace JSC {
             T* m_data;
         };
 
+        static unsigned numberOfProcessorCores();
+
         void* m_jsArrayVPtr;
+        MarkStackThreadSharedData& m_shared;
         MarkStackArray<MarkSet> m_markSets;
         MarkStackArray<JSCell*> m_values;
         static size_t s_pageSize;
         HashSet<void*> m_opaqueRoots; // Handle-owning data structures not visible to the garbage collector.
 
+#if ENABLE(PARALLEL_GC)
+        bool m_isInParallelMode;
+        unsigned m_visitsUntilNextDonation;
+#endif
+
 #if !ASSERT_DISABLED
     public:
         bool m_isCheckingForDefaultMarkViolation;
@@ -43,47 +43,65 @@ MarkedBlock* MarkedBlock::create(JSGlobalData* globalData, size_t cellSize)
 
 void MarkedBlock::destroy(MarkedBlock* block)
 {
-    for (size_t i = block->firstAtom(); i < block->m_endAtom; i += block->m_atomsPerCell)
-        reinterpret_cast<JSCell*>(&block->atoms()[i])->~JSCell();
+    for (size_t i = block->firstAtom(); i < block->m_nextAtom; i += block->m_atomsPerCell) {
+        JSCell* cell = reinterpret_cast<JSCell*>(&block->atoms()[i]);
+        if (cell->vptr())
+            cell->~JSCell();
+    }
     block->m_allocation.deallocate();
 }
 
 MarkedBlock::MarkedBlock(const PageAllocationAligned& allocation, JSGlobalData* globalData, size_t cellSize)
-    : m_nextAtom(firstAtom())
+    : m_freeList(0)
+    , m_needsSweep(false)
+    , m_nextAtom(firstAtom())
     , m_allocation(allocation)
     , m_heap(&globalData->heap)
     , m_prev(0)
     , m_next(0)
+#if ENABLE(REMEMBERED_SET)
+    // Cells in a new block are often initialized without a write barrier, which is only
+    // safe if the block is rescanned whenever its cells may already have been marked.
+    , m_isRemembered(1)
+#endif
 {
+    ASSERT(cellSize >= sizeof(FreeCell));
     m_atomsPerCell = (cellSize + atomSize - 1) / atomSize;
     m_endAtom = atomsPerBlock - m_atomsPerCell + 1;
-
-    Structure* dummyMarkableCellStructure = globalData->dummyMarkableCellStructure.get();
-    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell)
-        new (&atoms()[i]) JSCell(*globalData, dummyMarkableCellStructure);
 }
 
 void MarkedBlock::sweep()
 {
-    Structure* dummyMarkableCellStructure = m_heap->globalData()->dummyMarkableCellStructure.get();
+    FreeCell* freeList = 0;
+    FreeCell** tail = &freeList;
 
-    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+    for (size_t i = firstAtom(); i < m_nextAtom; i += m_atomsPerCell) {
         if (m_marks.get(i))
             continue;
 
         JSCell* cell = reinterpret_cast<JSCell*>(&atoms()[i]);
+        if (cell->vptr()) {
 #if ENABLE(JSC_ZOMBIES)
-        if (cell->structure() && cell->structure() != dummyMarkableCellStructure && !cell->isZombie()) {
-            const ClassInfo* info = cell->classInfo();
+            if (!cell->isZombie()) {
+                const ClassInfo* info = cell->classInfo();
+                cell->~JSCell();
+                new (cell) JSZombie(*m_heap->globalData(), info, m_heap->globalData()->zombieStructure.get());
+                m_marks.set(i);
+                continue;
+            }
+#endif
             cell->~JSCell();
-            new (cell) JSZombie(*m_heap->globalData(), info, m_heap->globalData()->zombieStructure.get());
-            m_marks.set(i);
         }
-#else
-        cell->~JSCell();
-        new (cell) JSCell(*m_heap->globalData(), dummyMarkableCellStructure);
-#endif
+
+        FreeCell* freeCell = reinterpret_cast<FreeCell*>(cell);
+        freeCell->zappedVPtr = 0;
+        *tail = freeCell;
+        tail = &freeCell->next;
     }
+
+    *tail = 0;
+    m_freeList = freeList;
+    m_needsSweep = false;
 }
 
 } // namespace JSC
@@ -39,6 +39,8 @@ namespace JSC {
     class MarkedBlock {
     public:
         static const size_t atomSize = sizeof(double); // Ensures natural alignment for all built-in types.
+        static const size_t blockSize = 16 * KB;
+        static const size_t blockMask = ~(blockSize - 1); // blockSize must be a power of two.
 
         static MarkedBlock* create(JSGlobalData*, size_t cellSize);
         static void destroy(MarkedBlock*);
@@ -56,13 +58,37 @@ namespace JSC {
         
         void* allocate();
         void reset();
+
+        // Destroys the dead cells and threads them onto the free list that allocate() pops.
         void sweep();
-        
+        bool needsSweep();
+
         bool isEmpty();
 
         void clearMarks();
         size_t markCount();
 
+#if ENABLE(GGC)
+        // Restores the marks this block had at the end of the last collection, so that
+        // only cells allocated since then are unmarked.
+        void clearYoungMarks();
+#endif
+
+#if ENABLE(INCREMENTAL_MARKING)
+        // Clears the marks for a new incremental cycle while still treating every cell
+        // allocated so far as live, until reset() ends the cycle.
+        void beginIncrementalMarking();
+#endif
+
+#if ENABLE(REMEMBERED_SET)
+        // A block is remembered once one of its cells may have been handed a pointer to
+        // an unmarked cell. Every collection forgets all blocks.
+        void remember() { m_isRemembered = 1; }
+        bool isRemembered() { return m_isRemembered; }
+        void* addressOfIsRemembered() { return &m_isRemembered; }
+        static ptrdiff_t offsetOfIsRemembered() { return OBJECT_OFFSETOF(MarkedBlock, m_isRemembered); }
+#endif
+
         size_t cellSize();
 
         size_t size();
@@ -75,21 +101,31 @@ namespace JSC {
         void setMarked(const void*);
         
         template <typename Functor> void forEach(Functor&);
+#if ENABLE(REMEMBERED_SET)
+        template <typename Functor> void forEachMarkedCell(Functor&);
+#endif
 
     private:
-        static const size_t blockSize = 16 * KB;
-        static const size_t blockMask = ~(blockSize - 1); // blockSize must be a power of two.
-
         static const size_t atomMask = ~(atomSize - 1); // atomSize must be a power of two.
         
         static const size_t atomsPerBlock = blockSize / atomSize;
 
         typedef char Atom[atomSize];
 
+        // A free cell has already been destroyed. Its first word, where a live cell keeps
+        // its vtable pointer, is zeroed so that sweep() and destroy() can tell it apart
+        // from a dead cell whose destructor has yet to run.
+        struct FreeCell {
+            void* zappedVPtr;
+            FreeCell* next;
+        };
+
         MarkedBlock(const PageAllocationAligned&, JSGlobalData*, size_t cellSize);
         Atom* atoms();
 
-        size_t m_nextAtom;
+        FreeCell* m_freeList;
+        bool m_needsSweep;
+        size_t m_nextAtom; // Cells from here on have never been allocated, and are handed out in order.
         size_t m_endAtom; // This is a fuzzy end. Always test for < m_endAtom.
         size_t m_atomsPerCell;
         WTF::Bitmap<blockSize / atomSize> m_marks;
@@ -97,6 +133,10 @@ namespace JSC {
         Heap* m_heap;
         MarkedBlock* m_prev;
         MarkedBlock* m_next;
+#if ENABLE(REMEMBERED_SET)
+        WTF::Bitmap<blockSize / atomSize> m_oldMarks;
+        uint32_t m_isRemembered; // Stored to as a 32-bit word by JIT code.
+#endif
     };
 
     inline size_t MarkedBlock::firstAtom()
@@ -144,21 +184,77 @@ namespace JSC {
         return m_next;
     }
 
+    inline void* MarkedBlock::allocate()
+    {
+        if (FreeCell* cell = m_freeList) {
+            m_freeList = cell->next;
+            setMarked(cell);
+            return cell;
+        }
+
+        if (m_nextAtom < m_endAtom) {
+            m_marks.set(m_nextAtom);
+            void* cell = &atoms()[m_nextAtom];
+            m_nextAtom += m_atomsPerCell;
+            return cell;
+        }
+
+        return 0;
+    }
+
     inline void MarkedBlock::reset()
     {
-        m_nextAtom = firstAtom();
+        // The collection may have killed cells; the free list is rebuilt when the
+        // allocator, or the lazy sweeper, gets to this block.
+        m_freeList = 0;
+        m_needsSweep = true;
+#if ENABLE(REMEMBERED_SET)
+        // Everything that survived this collection is old from now on.
+        m_oldMarks = m_marks;
+        m_isRemembered = 0;
+#endif
+    }
+
+    inline bool MarkedBlock::needsSweep()
+    {
+        return m_needsSweep;
     }
 
     inline bool MarkedBlock::isEmpty()
     {
+#if ENABLE(INCREMENTAL_MARKING)
+        return m_marks.isEmpty() && m_oldMarks.isEmpty();
+#else
         return m_marks.isEmpty();
+#endif
     }
 
     inline void MarkedBlock::clearMarks()
     {
         m_marks.clearAll();
+#if ENABLE(INCREMENTAL_MARKING)
+        m_oldMarks.clearAll();
+#endif
     }
     
+#if ENABLE(GGC)
+    inline void MarkedBlock::clearYoungMarks()
+    {
+        m_marks = m_oldMarks;
+    }
+#endif
+
+#if ENABLE(INCREMENTAL_MARKING)
+    inline void MarkedBlock::beginIncrementalMarking()
+    {
+        // Outside a cycle, m_oldMarks is a subset of m_marks, so contains(), forEach()
+        // and isEmpty() can check both without knowing whether a cycle is running.
+        m_oldMarks = m_marks;
+        m_marks.clearAll();
+        m_isRemembered = 0;
+    }
+#endif
+
     inline size_t MarkedBlock::markCount()
     {
         return m_marks.count();
@@ -186,7 +282,11 @@ namespace JSC {
         // Even though we physically contain p, we only logically contain p if p
         // points to a live cell. (Claiming to contain a dead cell would trick the
         // conservative garbage collector into resurrecting the cell in a zombie state.)
+#if ENABLE(INCREMENTAL_MARKING)
+        return isMarked(p) || m_oldMarks.get(atomNumber(p));
+#else
         return isMarked(p);
+#endif
     }
 
     inline size_t MarkedBlock::atomNumber(const void* p)
@@ -201,7 +301,12 @@ namespace JSC {
 
     inline bool MarkedBlock::testAndSetMarked(const void* p)
     {
+#if ENABLE(PARALLEL_GC)
+        // Marking threads may race to set bits in the same word.
+        return m_marks.concurrentTestAndSet(atomNumber(p));
+#else
         return m_marks.testAndSet(atomNumber(p));
+#endif
     }
 
     inline void MarkedBlock::setMarked(const void* p)
@@ -210,6 +315,21 @@ namespace JSC {
     }
 
     template <typename Functor> inline void MarkedBlock::forEach(Functor& functor)
+    {
+        for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+#if ENABLE(INCREMENTAL_MARKING)
+            if (!m_marks.get(i) && !m_oldMarks.get(i))
+#else
+            if (!m_marks.get(i))
+#endif
+                continue;
+            functor(reinterpret_cast<JSCell*>(&atoms()[i]));
+        }
+    }
+
+#if ENABLE(REMEMBERED_SET)
+    // Unlike forEach(), skips cells that an incremental cycle has not reached yet.
+    template <typename Functor> inline void MarkedBlock::forEachMarkedCell(Functor& functor)
     {
         for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
             if (!m_marks.get(i))
@@ -217,6 +337,7 @@ namespace JSC {
             functor(reinterpret_cast<JSCell*>(&atoms()[i]));
         }
     }
+#endif
 
 } // namespace JSC
 
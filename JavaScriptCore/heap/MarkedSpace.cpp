@@ -75,10 +75,13 @@ void MarkedSpace::freeBlocks(DoublyLinkedList<MarkedBlock>& blocks)
 void* MarkedSpace::allocateFromSizeClass(SizeClass& sizeClass)
 {
     for (MarkedBlock*& block = sizeClass.nextBlock ; block; block = block->next()) {
+        if (block->needsSweep())
+            block->sweep();
         if (void* result = block->allocate())
             return result;
 
         m_waterMark += block->capacity();
+        sweepNextBlock(sizeClass);
     }
 
     if (m_waterMark < m_highWaterMark)
@@ -87,6 +90,42 @@ void* MarkedSpace::allocateFromSizeClass(SizeClass& sizeClass)
     return 0;
 }
 
+void MarkedSpace::sweepNextBlock(SizeClass& sizeClass)
+{
+    // The allocator sweeps each block it reaches that is still unswept, so the sweep
+    // cursor only has work to do while it is still ahead of the allocator.
+    MarkedBlock* block = sizeClass.nextBlockToSweep;
+    if (!block)
+        return;
+    if (block == sizeClass.nextBlock) {
+        sizeClass.nextBlockToSweep = 0;
+        return;
+    }
+
+    MarkedBlock* prev = block->prev();
+    sizeClass.nextBlockToSweep = prev == sizeClass.nextBlock ? 0 : prev;
+
+    block->sweep();
+    if (block->isEmpty()) {
+        sizeClass.blockList.remove(block);
+        m_blocks.remove(block);
+        MarkedBlock::destroy(block);
+    }
+}
+
+void MarkedSpace::beginLazySweep()
+{
+    for (size_t cellSize = preciseStep; cellSize < preciseCutoff; cellSize += preciseStep) {
+        SizeClass& sizeClass = sizeClassFor(cellSize);
+        sizeClass.nextBlockToSweep = sizeClass.blockList.tail();
+    }
+
+    for (size_t cellSize = impreciseStep; cellSize < impreciseCutoff; cellSize += impreciseStep) {
+        SizeClass& sizeClass = sizeClassFor(cellSize);
+        sizeClass.nextBlockToSweep = sizeClass.blockList.tail();
+    }
+}
+
 void MarkedSpace::shrink()
 {
     // We record a temporary list of empties to avoid modifying m_blocks while iterating it.
@@ -97,8 +136,13 @@ void MarkedSpace::shrink()
         MarkedBlock* block = *it;
         if (block->isEmpty()) {
             SizeClass& sizeClass = sizeClassFor(block->cellSize());
+            // Keep a lazy sweep going over the blocks that remain.
+            if (sizeClass.nextBlockToSweep == block)
+                sizeClass.nextBlockToSweep = block->prev();
             sizeClass.blockList.remove(block);
             sizeClass.nextBlock = sizeClass.blockList.head();
+            if (sizeClass.nextBlockToSweep == sizeClass.nextBlock)
+                sizeClass.nextBlockToSweep = 0;
             empties.append(block);
         }
     }
@@ -114,6 +158,36 @@ void MarkedSpace::clearMarks()
         (*it)->clearMarks();
 }
 
+#if ENABLE(GGC)
+void MarkedSpace::clearYoungMarks()
+{
+    BlockIterator end = m_blocks.end();
+    for (BlockIterator it = m_blocks.begin(); it != end; ++it)
+        (*it)->clearYoungMarks();
+}
+#endif
+
+#if ENABLE(INCREMENTAL_MARKING)
+void MarkedSpace::beginIncrementalMarking()
+{
+    for (size_t cellSize = preciseStep; cellSize < preciseCutoff; cellSize += preciseStep) {
+        SizeClass& sizeClass = sizeClassFor(cellSize);
+        sizeClass.nextBlock = 0;
+        sizeClass.nextBlockToSweep = 0;
+    }
+
+    for (size_t cellSize = impreciseStep; cellSize < impreciseCutoff; cellSize += impreciseStep) {
+        SizeClass& sizeClass = sizeClassFor(cellSize);
+        sizeClass.nextBlock = 0;
+        sizeClass.nextBlockToSweep = 0;
+    }
+
+    BlockIterator end = m_blocks.end();
+    for (BlockIterator it = m_blocks.begin(); it != end; ++it)
+        (*it)->beginIncrementalMarking();
+}
+#endif
+
 void MarkedSpace::sweep()
 {
     BlockIterator end = m_blocks.end();
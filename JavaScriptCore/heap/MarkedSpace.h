@@ -61,17 +61,33 @@ namespace JSC {
 
         JSGlobalData* globalData();
 
+        size_t waterMark();
         size_t highWaterMark();
         void setHighWaterMark(size_t);
 
         void* allocate(size_t);
 
         void clearMarks();
+#if ENABLE(GGC)
+        void clearYoungMarks();
+#endif
+#if ENABLE(INCREMENTAL_MARKING)
+        // Clears the marks for an incremental cycle. Until reset(), the allocator leaves
+        // existing blocks alone and only allocates out of new ones.
+        void beginIncrementalMarking();
+#endif
+#if ENABLE(REMEMBERED_SET)
+        template<typename Functor> void forEachRememberedCell(Functor&);
+#endif
         void markRoots();
         void reset();
         void sweep();
         void shrink();
 
+        // Defers sweeping to the allocator: from now on, each time allocation exhausts a block,
+        // one not yet reached block of the same size class is swept (and freed if it is empty).
+        void beginLazySweep();
+
         size_t size() const;
         size_t capacity() const;
         size_t objectCount() const;
@@ -98,6 +114,7 @@ namespace JSC {
             void reset();
 
             MarkedBlock* nextBlock;
+            MarkedBlock* nextBlockToSweep; // Walks back from the tail until it meets nextBlock.
             DoublyLinkedList<MarkedBlock> blockList;
             size_t cellSize;
         };
@@ -107,6 +124,7 @@ namespace JSC {
 
         SizeClass& sizeClassFor(size_t);
         void* allocateFromSizeClass(SizeClass&);
+        void sweepNextBlock(SizeClass&);
 
         void clearMarks(MarkedBlock*);
 
@@ -157,11 +175,27 @@ namespace JSC {
             (*it)->forEach(functor);
     }
 
+#if ENABLE(REMEMBERED_SET)
+    template <typename Functor> inline void MarkedSpace::forEachRememberedCell(Functor& functor)
+    {
+        BlockIterator end = m_blocks.end();
+        for (BlockIterator it = m_blocks.begin(); it != end; ++it) {
+            if ((*it)->isRemembered())
+                (*it)->forEachMarkedCell(functor);
+        }
+    }
+#endif
+
     inline JSGlobalData* MarkedSpace::globalData()
     {
         return m_globalData;
     }
 
+    inline size_t MarkedSpace::waterMark()
+    {
+        return m_waterMark;
+    }
+
     inline size_t MarkedSpace::highWaterMark()
     {
         return m_highWaterMark;
@@ -174,6 +208,7 @@ namespace JSC {
 
     inline MarkedSpace::SizeClass::SizeClass()
         : nextBlock(0)
+        , nextBlockToSweep(0)
         , cellSize(0)
     {
     }
@@ -181,6 +216,7 @@ namespace JSC {
     inline void MarkedSpace::SizeClass::reset()
     {
         nextBlock = blockList.head();
+        nextBlockToSweep = 0;
     }
 
 } // namespace JSC
@@ -58,6 +58,7 @@
 #include "RegExpObject.h"
 #include "RegExpPrototype.h"
 #include "Register.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
 #include "StrictEvalActivation.h"
 #include "UStringConcatenate.h"
@@ -412,10 +413,10 @@ NEVER_INLINE JSValue Interpreter::callEval(CallFrame* callFrame, RegisterFile* r
     return callFrame->globalData().interpreter->execute(eval, callFrame, callFrame->uncheckedR(codeBlock->thisRegister()).jsValue().toThisObject(callFrame), callFrame->registers() - registerFile->start() + registerOffset, scopeChain);
 }
 
-Interpreter::Interpreter(JSGlobalData& globalData)
+Interpreter::Interpreter(JSGlobalData& globalData, size_t registerFileCapacity)
     : m_sampleEntryDepth(0)
     , m_reentryDepth(0)
-    , m_registerFile(globalData)
+    , m_registerFile(globalData, registerFileCapacity)
 {
 #if ENABLE(COMPUTED_GOTO_INTERPRETER)
     privateExecute(InitializeAndReturn, 0, 0);
@@ -1228,9 +1229,13 @@ NEVER_INLINE void Interpreter::tryCachePutByID(CallFrame* callFrame, CodeBlock*
             return;
         }
 
-        // Second miss: give up.
-        vPC[0] = getOpcode(op_put_by_id_generic);
-        return;
+        // Second miss: only stores to existing properties can go polymorphic
+        // later on, so cache those for the current Structure and give up on the rest.
+        if (slot.type() != PutPropertySlot::ExistingProperty) {
+            vPC[0] = getOpcode(op_put_by_id_generic);
+            return;
+        }
+        vPC[4].u.structure.set(callFrame->globalData(), codeBlock->ownerExecutable(), structure);
     }
 
     // Cache hit: Specialize instruction and ref Structures.
@@ -1271,6 +1276,55 @@ NEVER_INLINE void Interpreter::uncachePutByID(CodeBlock*, Instruction* vPC)
     vPC[4] = 0;
 }
 
+NEVER_INLINE void Interpreter::tryCachePutByIDList(CallFrame* callFrame, CodeBlock* codeBlock, Instruction* vPC, Opcode expectedOpcode, JSValue baseValue, const PutPropertySlot& slot)
+{
+    // Recursive invocation may already have specialized this instruction.
+    if (vPC[0].u.opcode != expectedOpcode)
+        return;
+
+    bool isList = expectedOpcode == getOpcode(op_put_by_id_replace_list);
+
+    // Only stores to existing properties of the base object are cached polymorphically.
+    if (!baseValue.isCell() || slot.type() != PutPropertySlot::ExistingProperty || slot.base() != baseValue || baseValue.asCell()->structure()->isUncacheableDictionary()) {
+        if (isList) {
+            delete vPC[4].u.polymorphicStructures;
+            vPC[0] = getOpcode(op_put_by_id_generic);
+        } else
+            uncachePutByID(codeBlock, vPC);
+        return;
+    }
+
+    JSGlobalData& globalData = callFrame->globalData();
+    JSCell* owner = codeBlock->ownerExecutable();
+    Structure* structure = baseValue.asCell()->structure();
+
+    PolymorphicAccessStructureList* polymorphicStructures;
+    int listSize;
+    if (isList) {
+        polymorphicStructures = vPC[4].u.polymorphicStructures;
+        listSize = vPC[5].u.operand;
+    } else {
+        ASSERT(expectedOpcode == getOpcode(op_put_by_id_replace));
+        polymorphicStructures = new PolymorphicAccessStructureList(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), vPC[4].u.structure.get());
+        polymorphicStructures->list[0].cachedOffset = vPC[5].u.operand;
+        listSize = 1;
+    }
+
+    if (listSize == POLYMORPHIC_LIST_CACHE_SIZE) {
+        delete polymorphicStructures;
+        vPC[0] = getOpcode(op_put_by_id_generic);
+        return;
+    }
+
+    polymorphicStructures->list[listSize].set(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), structure);
+    polymorphicStructures->list[listSize].cachedOffset = slot.cachedOffset();
+    ++listSize;
+
+    vPC[0] = getOpcode(op_put_by_id_replace_list);
+    vPC[4] = polymorphicStructures;
+    vPC[5] = listSize;
+}
+
 NEVER_INLINE void Interpreter::tryCacheGetByID(CallFrame* callFrame, CodeBlock* codeBlock, Instruction* vPC, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot)
 {
     // Recursive invocation may already have specialized this instruction.
@@ -1316,9 +1370,13 @@ NEVER_INLINE void Interpreter::tryCacheGetByID(CallFrame* callFrame, CodeBlock*
             return;
         }
 
-        // Second miss: give up.
-        vPC[0] = getOpcode(op_get_by_id_generic);
-        return;
+        // Second miss: plain values can go polymorphic later on, so cache those
+        // for the current Structure and give up on getters and custom properties.
+        if (!slot.isCacheableValue()) {
+            vPC[0] = getOpcode(op_get_by_id_generic);
+            return;
+        }
+        vPC[4].u.structure.set(callFrame->globalData(), codeBlock->ownerExecutable(), structure);
     }
 
     // Cache hit: Specialize instruction and ref Structures.
@@ -1406,12 +1464,153 @@ NEVER_INLINE void Interpreter::tryCacheGetByID(CallFrame* callFrame, CodeBlock*
     vPC[6] = count;
 }
 
+// Call sites remember the last JSFunction they invoked, so that calling it again
+// can skip the virtual getCallData() / getConstructData() lookup. Host functions
+// keep their NativeFunction alongside the callee. JS functions are re-read from
+// the callee, which keeps the cache valid after FunctionExecutable::discardCode().
+static ALWAYS_INLINE void cacheCallee(CallFrame* callFrame, CodeBlock* codeBlock, Instruction* vPC, JSValue callee, NativeFunction function)
+{
+    JSGlobalData& globalData = callFrame->globalData();
+    if (!getJSFunction(globalData, callee))
+        return;
+    vPC[4].u.jsCell.set(globalData, codeBlock->ownerExecutable(), callee.asCell());
+    vPC[5] = function;
+}
+
+// Returns the object holding the property cached by info, or 0 if the prototypes
+// on the way to it no longer have the Structures that were cached.
+static ALWAYS_INLINE JSObject* polymorphicAccessSlotBase(CallFrame* callFrame, JSCell* baseCell, const PolymorphicAccessStructureList::PolymorphicStubInfo& info)
+{
+    if (info.isChain) {
+        WriteBarrier<Structure>* it = info.u.chain->head();
+        WriteBarrier<Structure>* end = it + info.count;
+
+        while (true) {
+            JSObject* baseObject = asObject(baseCell->structure()->prototypeForLookup(callFrame));
+            if (baseObject->structure() != (*it).get())
+                return 0;
+            if (++it == end)
+                return baseObject;
+            baseCell = baseObject;
+        }
+    }
+
+    if (info.u.proto) {
+        JSObject* protoObject = asObject(baseCell->structure()->prototypeForLookup(callFrame));
+        return protoObject->structure() == info.u.proto.get() ? protoObject : 0;
+    }
+
+    return asObject(baseCell);
+}
+
 NEVER_INLINE void Interpreter::uncacheGetByID(CodeBlock*, Instruction* vPC)
 {
     vPC[0] = getOpcode(op_get_by_id);
     vPC[4] = 0;
 }
 
+NEVER_INLINE void Interpreter::tryCacheGetByIDList(CallFrame* callFrame, CodeBlock* codeBlock, Instruction* vPC, Opcode expectedOpcode, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot)
+{
+    // Recursive invocation may already have specialized this instruction.
+    if (vPC[0].u.opcode != expectedOpcode)
+        return;
+
+    bool isList = expectedOpcode == getOpcode(op_get_by_id_self_list) || expectedOpcode == getOpcode(op_get_by_id_proto_list);
+    JSGlobalData& globalData = callFrame->globalData();
+
+    // Work out how to find the property for this Structure. Only plain values
+    // are cached polymorphically; getters and custom properties go generic.
+    Structure* structure = 0;
+    Structure* prototypeStructure = 0;
+    StructureChain* chain = 0;
+    size_t offset = 0;
+    size_t count = 0;
+    bool isCacheable = baseValue.isCell() && slot.isCacheableValue();
+    if (isCacheable) {
+        structure = baseValue.asCell()->structure();
+        offset = slot.cachedOffset();
+        if (structure->isUncacheableDictionary())
+            isCacheable = false;
+        else if (slot.slotBase() != baseValue) {
+            if (structure->isDictionary())
+                isCacheable = false;
+            else if (slot.slotBase() == structure->prototypeForLookup(callFrame)) {
+                JSObject* baseObject = asObject(slot.slotBase());
+
+                // Since we're accessing a prototype in a loop, it's a good bet that it
+                // should not be treated as a dictionary.
+                if (baseObject->structure()->isDictionary()) {
+                    baseObject->flattenDictionaryObject(globalData);
+                    offset = baseObject->structure()->get(globalData, propertyName);
+                }
+                prototypeStructure = baseObject->structure();
+            } else if ((count = normalizePrototypeChain(callFrame, baseValue, slot.slotBase(), propertyName, offset)))
+                chain = structure->prototypeChain(callFrame);
+            else
+                isCacheable = false;
+        }
+    }
+
+    if (!isCacheable) {
+        if (isList)
+            delete vPC[4].u.polymorphicStructures;
+        vPC[0] = getOpcode(op_get_by_id_generic);
+        return;
+    }
+
+    JSCell* owner = codeBlock->ownerExecutable();
+    PolymorphicAccessStructureList* polymorphicStructures;
+    int listSize;
+    if (isList) {
+        polymorphicStructures = vPC[4].u.polymorphicStructures;
+        listSize = vPC[5].u.operand;
+    } else {
+        // Seed the list with the access this instruction is currently specialized for.
+        if (expectedOpcode == getOpcode(op_get_by_id_self)) {
+            polymorphicStructures = new PolymorphicAccessStructureList(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), vPC[4].u.structure.get());
+            polymorphicStructures->list[0].cachedOffset = vPC[5].u.operand;
+        } else if (expectedOpcode == getOpcode(op_get_by_id_proto)) {
+            polymorphicStructures = new PolymorphicAccessStructureList(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), vPC[4].u.structure.get(), vPC[5].u.structure.get());
+            polymorphicStructures->list[0].cachedOffset = vPC[6].u.operand;
+        } else {
+            ASSERT(expectedOpcode == getOpcode(op_get_by_id_chain));
+            polymorphicStructures = new PolymorphicAccessStructureList(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), vPC[4].u.structure.get(), vPC[5].u.structureChain.get());
+            polymorphicStructures->list[0].count = vPC[6].u.operand;
+            polymorphicStructures->list[0].cachedOffset = vPC[7].u.operand;
+        }
+        listSize = 1;
+    }
+
+    // A prototype on the path may have changed shape since we cached this
+    // Structure; if so, overwrite the stale entry rather than adding another.
+    int index = 0;
+    while (index < listSize && polymorphicStructures->list[index].base.get() != structure)
+        ++index;
+    if (index == POLYMORPHIC_LIST_CACHE_SIZE) {
+        delete polymorphicStructures;
+        vPC[0] = getOpcode(op_get_by_id_generic);
+        return;
+    }
+    if (index == listSize)
+        ++listSize;
+
+    PolymorphicAccessStructureList::PolymorphicStubInfo& info = polymorphicStructures->list[index];
+    if (chain)
+        info.set(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), structure, chain);
+    else if (prototypeStructure)
+        info.set(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), structure, prototypeStructure);
+    else
+        info.set(globalData, owner, PolymorphicAccessStructureListStubRoutineType(), structure);
+    info.cachedOffset = offset;
+    info.count = count;
+
+    // Lists holding only own properties can skip the prototype checks.
+    bool isSelfList = (expectedOpcode == getOpcode(op_get_by_id_self) || expectedOpcode == getOpcode(op_get_by_id_self_list)) && !chain && !prototypeStructure;
+    vPC[0] = getOpcode(isSelfList ? op_get_by_id_self_list : op_get_by_id_proto_list);
+    vPC[4] = polymorphicStructures;
+    vPC[5] = listSize;
+}
+
 #endif // ENABLE(INTERPRETER)
 
 JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFile, CallFrame* callFrame)
@@ -1450,7 +1649,6 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
     CodeBlock* codeBlock = callFrame->codeBlock();
     Instruction* vPC = codeBlock->instructions().begin();
     Profiler** enabledProfilerReference = Profiler::enabledProfilerReference();
-    unsigned tickCount = globalData->timeoutChecker.ticksUntilNextCheck();
     JSValue functionReturnValue;
 
 #define CHECK_FOR_EXCEPTION() \
@@ -1465,13 +1663,22 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
     OpcodeStats::resetLastInstruction();
 #endif
 
+#define CHECK_FOR_SAMPLE() \
+    if (UNLIKELY(globalData->samplingProfiler && globalData->samplingProfiler->sampleIsDue())) \
+        globalData->samplingProfiler->takeSample(callFrame, vPC);
+
 #define CHECK_FOR_TIMEOUT() \
-    if (!--tickCount) { \
-        if (globalData->terminator.shouldTerminate() || globalData->timeoutChecker.didTimeOut(callFrame)) { \
-            exceptionValue = jsNull(); \
+    if (UNLIKELY(globalData->timeoutChecker.interruptRequested())) { \
+        globalData->timeoutChecker.clearInterruptRequest(); \
+        CHECK_FOR_SAMPLE(); \
+        if (globalData->terminator.shouldTerminate()) { \
+            exceptionValue = createTerminatedExecutionException(globalData); \
+            goto vm_throw; \
+        } \
+        if (globalData->timeoutChecker.didTimeOut(callFrame)) { \
+            exceptionValue = createInterruptedExecutionException(globalData); \
             goto vm_throw; \
         } \
-        tickCount = globalData->timeoutChecker.ticksUntilNextCheck(); \
     }
     
 #if ENABLE(OPCODE_SAMPLING)
@@ -2508,8 +2715,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         /* op_get_by_id_self dst(r) base(r) property(id) structure(sID) offset(n) nop(n) nop(n)
 
            Cached property access: Attempts to get a cached property from the
-           value base. If the cache misses, op_get_by_id_self reverts to
-           op_get_by_id.
+           value base. If the cache misses, op_get_by_id_self becomes
+           op_get_by_id_self_list or op_get_by_id_proto_list, or
+           op_get_by_id_generic if the property cannot be cached.
         */
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
@@ -2532,7 +2740,17 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
             }
         }
 
-        uncacheGetByID(codeBlock, vPC);
+        // Miss: look the property up generically and try to cache it polymorphically.
+        int dst = vPC[1].u.operand;
+        Identifier& ident = codeBlock->identifier(vPC[3].u.operand);
+        PropertySlot slot(baseValue);
+        JSValue result = baseValue.get(callFrame, ident, slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCacheGetByIDList(callFrame, codeBlock, vPC, getOpcode(op_get_by_id_self), baseValue, ident, slot);
+
+        callFrame->uncheckedR(dst) = result;
+        vPC += OPCODE_LENGTH(op_get_by_id_self);
         NEXT_INSTRUCTION();
     }
     DEFINE_OPCODE(op_get_by_id_proto) {
@@ -2540,7 +2758,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
            Cached property access: Attempts to get a cached property from the
            value base's prototype. If the cache misses, op_get_by_id_proto
-           reverts to op_get_by_id.
+           becomes op_get_by_id_proto_list, or op_get_by_id_generic if the
+           property cannot be cached.
         */
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
@@ -2568,7 +2787,17 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
             }
         }
 
-        uncacheGetByID(codeBlock, vPC);
+        // Miss: look the property up generically and try to cache it polymorphically.
+        int dst = vPC[1].u.operand;
+        Identifier& ident = codeBlock->identifier(vPC[3].u.operand);
+        PropertySlot slot(baseValue);
+        JSValue result = baseValue.get(callFrame, ident, slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCacheGetByIDList(callFrame, codeBlock, vPC, getOpcode(op_get_by_id_proto), baseValue, ident, slot);
+
+        callFrame->uncheckedR(dst) = result;
+        vPC += OPCODE_LENGTH(op_get_by_id_proto);
         NEXT_INSTRUCTION();
     }
 #if USE(GCC_COMPUTED_GOTO_WORKAROUND)
@@ -2659,16 +2888,94 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
     skip_id_custom_proto:
 #endif
     DEFINE_OPCODE(op_get_by_id_self_list) {
-        // Polymorphic self access caching currently only supported when JITting.
-        ASSERT_NOT_REACHED();
-        // This case of the switch must not be empty, else (op_get_by_id_self_list == op_get_by_id_chain)!
+        /* op_get_by_id_self_list dst(r) base(r) property(id) structureList(sL) listSize(n) nop(n) nop(n)
+
+           Polymorphic cached property access: Attempts to get a cached property
+           from the value base, for any of the Structures in structureList. If
+           the cache misses, the property is added to the list, which may turn
+           this instruction into op_get_by_id_proto_list or op_get_by_id_generic.
+        */
+        int base = vPC[2].u.operand;
+        JSValue baseValue = callFrame->r(base).jsValue();
+
+        if (LIKELY(baseValue.isCell())) {
+            Structure* structure = baseValue.asCell()->structure();
+            PolymorphicAccessStructureList::PolymorphicStubInfo* it = vPC[4].u.polymorphicStructures->list;
+            PolymorphicAccessStructureList::PolymorphicStubInfo* end = it + vPC[5].u.operand;
+
+            for (; it != end; ++it) {
+                if (it->base.get() == structure) {
+                    ASSERT(baseValue.isObject());
+                    JSObject* baseObject = asObject(baseValue);
+                    int dst = vPC[1].u.operand;
+
+                    ASSERT(baseObject->get(callFrame, codeBlock->identifier(vPC[3].u.operand)) == baseObject->getDirectOffset(it->cachedOffset));
+                    callFrame->uncheckedR(dst) = JSValue(baseObject->getDirectOffset(it->cachedOffset));
+
+                    vPC += OPCODE_LENGTH(op_get_by_id_self_list);
+                    NEXT_INSTRUCTION();
+                }
+            }
+        }
+
+        // Miss: look the property up generically and try to cache it polymorphically.
+        int dst = vPC[1].u.operand;
+        Identifier& ident = codeBlock->identifier(vPC[3].u.operand);
+        PropertySlot slot(baseValue);
+        JSValue result = baseValue.get(callFrame, ident, slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCacheGetByIDList(callFrame, codeBlock, vPC, getOpcode(op_get_by_id_self_list), baseValue, ident, slot);
+
+        callFrame->uncheckedR(dst) = result;
         vPC += OPCODE_LENGTH(op_get_by_id_self_list);
         NEXT_INSTRUCTION();
     }
     DEFINE_OPCODE(op_get_by_id_proto_list) {
-        // Polymorphic prototype access caching currently only supported when JITting.
-        ASSERT_NOT_REACHED();
-        // This case of the switch must not be empty, else (op_get_by_id_proto_list == op_get_by_id_chain)!
+        /* op_get_by_id_proto_list dst(r) base(r) property(id) structureList(sL) listSize(n) nop(n) nop(n)
+
+           Polymorphic cached property access: Attempts to get a cached property
+           from the value base, its prototype or its prototype chain, for any of
+           the Structures in structureList. If the cache misses, the property is
+           added to the list, or this instruction reverts to op_get_by_id_generic
+           once the list is full.
+        */
+        int base = vPC[2].u.operand;
+        JSValue baseValue = callFrame->r(base).jsValue();
+
+        if (LIKELY(baseValue.isCell())) {
+            JSCell* baseCell = baseValue.asCell();
+            Structure* structure = baseCell->structure();
+            PolymorphicAccessStructureList::PolymorphicStubInfo* it = vPC[4].u.polymorphicStructures->list;
+            PolymorphicAccessStructureList::PolymorphicStubInfo* end = it + vPC[5].u.operand;
+
+            for (; it != end; ++it) {
+                if (it->base.get() != structure)
+                    continue;
+
+                if (JSObject* slotBase = polymorphicAccessSlotBase(callFrame, baseCell, *it)) {
+                    int dst = vPC[1].u.operand;
+
+                    ASSERT(baseValue.get(callFrame, codeBlock->identifier(vPC[3].u.operand)) == slotBase->getDirectOffset(it->cachedOffset));
+                    callFrame->uncheckedR(dst) = JSValue(slotBase->getDirectOffset(it->cachedOffset));
+
+                    vPC += OPCODE_LENGTH(op_get_by_id_proto_list);
+                    NEXT_INSTRUCTION();
+                }
+                break;
+            }
+        }
+
+        // Miss: look the property up generically and try to cache it polymorphically.
+        int dst = vPC[1].u.operand;
+        Identifier& ident = codeBlock->identifier(vPC[3].u.operand);
+        PropertySlot slot(baseValue);
+        JSValue result = baseValue.get(callFrame, ident, slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCacheGetByIDList(callFrame, codeBlock, vPC, getOpcode(op_get_by_id_proto_list), baseValue, ident, slot);
+
+        callFrame->uncheckedR(dst) = result;
         vPC += OPCODE_LENGTH(op_get_by_id_proto_list);
         NEXT_INSTRUCTION();
     }
@@ -2708,7 +3015,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
            Cached property access: Attempts to get a cached property from the
            value base's prototype chain. If the cache misses, op_get_by_id_chain
-           reverts to op_get_by_id.
+           becomes op_get_by_id_proto_list, or op_get_by_id_generic if the
+           property cannot be cached.
         */
         int base = vPC[2].u.operand;
         JSValue baseValue = callFrame->r(base).jsValue();
@@ -2746,7 +3054,17 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
             }
         }
 
-        uncacheGetByID(codeBlock, vPC);
+        // Miss: look the property up generically and try to cache it polymorphically.
+        int dst = vPC[1].u.operand;
+        Identifier& ident = codeBlock->identifier(vPC[3].u.operand);
+        PropertySlot slot(baseValue);
+        JSValue result = baseValue.get(callFrame, ident, slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCacheGetByIDList(callFrame, codeBlock, vPC, getOpcode(op_get_by_id_chain), baseValue, ident, slot);
+
+        callFrame->uncheckedR(dst) = result;
+        vPC += OPCODE_LENGTH(op_get_by_id_chain);
         NEXT_INSTRUCTION();
     }
 #if USE(GCC_COMPUTED_GOTO_WORKAROUND)
@@ -3100,7 +3418,8 @@ skip_id_custom_self:
            Cached property access: Attempts to set a pre-existing, cached
            property named by identifier property, belonging to register base,
            to register value. If the cache misses, op_put_by_id_replace
-           reverts to op_put_by_id.
+           becomes op_put_by_id_replace_list, or reverts to op_put_by_id if
+           the store was not to an existing property.
 
            Unlike many opcodes, this one does not write any output to
            the register file.
@@ -3126,7 +3445,77 @@ skip_id_custom_self:
             }
         }
 
-        uncachePutByID(codeBlock, vPC);
+        // Miss: store generically and try to cache the store polymorphically.
+        int property = vPC[2].u.operand;
+        int value = vPC[3].u.operand;
+        int direct = vPC[8].u.operand;
+
+        Identifier& ident = codeBlock->identifier(property);
+        PutPropertySlot slot(codeBlock->isStrictMode());
+        if (direct) {
+            baseValue.putDirect(callFrame, ident, callFrame->r(value).jsValue(), slot);
+            ASSERT(slot.base() == baseValue);
+        } else
+            baseValue.put(callFrame, ident, callFrame->r(value).jsValue(), slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCachePutByIDList(callFrame, codeBlock, vPC, getOpcode(op_put_by_id_replace), baseValue, slot);
+
+        vPC += OPCODE_LENGTH(op_put_by_id_replace);
+        NEXT_INSTRUCTION();
+    }
+    DEFINE_OPCODE(op_put_by_id_replace_list) {
+        /* op_put_by_id_replace_list base(r) property(id) value(r) structureList(sL) listSize(n) nop(n) nop(n) direct(b)
+
+           Polymorphic cached property access: Attempts to set a pre-existing,
+           cached property named by identifier property, belonging to register
+           base, for any of the Structures in structureList. If the cache
+           misses, the store is added to the list, or this instruction reverts
+           to op_put_by_id_generic once the list is full.
+
+           Unlike many opcodes, this one does not write any output to
+           the register file.
+        */
+        int base = vPC[1].u.operand;
+        JSValue baseValue = callFrame->r(base).jsValue();
+
+        if (LIKELY(baseValue.isCell())) {
+            Structure* structure = baseValue.asCell()->structure();
+            PolymorphicAccessStructureList::PolymorphicStubInfo* it = vPC[4].u.polymorphicStructures->list;
+            PolymorphicAccessStructureList::PolymorphicStubInfo* end = it + vPC[5].u.operand;
+
+            for (; it != end; ++it) {
+                if (it->base.get() == structure) {
+                    ASSERT(baseValue.isObject());
+                    JSObject* baseObject = asObject(baseValue);
+                    int value = vPC[3].u.operand;
+
+                    ASSERT(baseObject->offsetForLocation(baseObject->getDirectLocation(*globalData, codeBlock->identifier(vPC[2].u.operand))) == it->cachedOffset);
+                    baseObject->putDirectOffset(callFrame->globalData(), it->cachedOffset, callFrame->r(value).jsValue());
+
+                    vPC += OPCODE_LENGTH(op_put_by_id_replace_list);
+                    NEXT_INSTRUCTION();
+                }
+            }
+        }
+
+        // Miss: store generically and try to cache the store polymorphically.
+        int property = vPC[2].u.operand;
+        int value = vPC[3].u.operand;
+        int direct = vPC[8].u.operand;
+
+        Identifier& ident = codeBlock->identifier(property);
+        PutPropertySlot slot(codeBlock->isStrictMode());
+        if (direct) {
+            baseValue.putDirect(callFrame, ident, callFrame->r(value).jsValue(), slot);
+            ASSERT(slot.base() == baseValue);
+        } else
+            baseValue.put(callFrame, ident, callFrame->r(value).jsValue(), slot);
+        CHECK_FOR_EXCEPTION();
+
+        tryCachePutByIDList(callFrame, codeBlock, vPC, getOpcode(op_put_by_id_replace_list), baseValue, slot);
+
+        vPC += OPCODE_LENGTH(op_put_by_id_replace_list);
         NEXT_INSTRUCTION();
     }
     DEFINE_OPCODE(op_put_by_id_generic) {
@@ -3314,7 +3703,7 @@ skip_id_custom_self:
                 JSArray* jsArray = asArray(baseValue);
                 if (jsArray->canSetIndex(i))
                     jsArray->setIndex(*globalData, i, callFrame->r(value).jsValue());
-                else
+                else if (!jsArray->trySetUnboxedIndex(i, callFrame->r(value).jsValue()))
                     jsArray->JSArray::put(callFrame, i, callFrame->r(value).jsValue());
             } else if (isJSByteArray(globalData, baseValue) && asByteArray(baseValue)->canAccessIndex(i)) {
                 JSByteArray* jsByteArray = asByteArray(baseValue);
@@ -3813,7 +4202,7 @@ skip_id_custom_self:
         NEXT_INSTRUCTION();
     }
     DEFINE_OPCODE(op_call_eval) {
-        /* call_eval func(r) argCount(n) registerOffset(n)
+        /* call_eval func(r) argCount(n) registerOffset(n) callee(c) nativeFunction(n)
 
            Call a function named "eval" with no explicit "this" value
            (which may therefore be the eval operator). If register
@@ -3851,7 +4240,7 @@ skip_id_custom_self:
         // fall through to op_call
     }
     DEFINE_OPCODE(op_call) {
-        /* call func(r) argCount(n) registerOffset(n)
+        /* call func(r) argCount(n) registerOffset(n) callee(c) nativeFunction(n)
 
            Perform a function call.
            
@@ -3859,6 +4248,10 @@ skip_id_custom_self:
            before the VM initializes the new call frame's header.
            
            dst is where op_ret should store its result.
+
+           callee caches the last JSFunction called from this site, and
+           nativeFunction its host function (or 0 for a JS function), so
+           repeat calls to the same function skip getCallData().
          */
 
         int func = vPC[1].u.operand;
@@ -3868,7 +4261,22 @@ skip_id_custom_self:
         JSValue v = callFrame->r(func).jsValue();
 
         CallData callData;
-        CallType callType = getCallData(v, callData);
+        CallType callType;
+        if (v.isCell() && v.asCell() == vPC[4].u.jsCell.get()) {
+            if (NativeFunction function = vPC[5].u.nativeFunction) {
+                callType = CallTypeHost;
+                callData.native.function = function;
+            } else {
+                JSFunction* callee = asFunction(v);
+                callType = CallTypeJS;
+                callData.js.functionExecutable = callee->jsExecutable();
+                callData.js.scopeChain = callee->scope();
+            }
+        } else {
+            callType = getCallData(v, callData);
+            if (callType != CallTypeNone)
+                cacheCallee(callFrame, codeBlock, vPC, v, callType == CallTypeHost ? callData.native.function : 0);
+        }
 
         if (callType == CallTypeJS) {
             ScopeChainNode* callDataScopeChain = callData.js.scopeChain;
@@ -4149,6 +4557,7 @@ skip_id_custom_self:
 
         int result = vPC[1].u.operand;
 
+        CHECK_FOR_SAMPLE();
         JSValue returnValue = callFrame->r(result).jsValue();
 
         vPC = callFrame->returnVPC();
@@ -4187,6 +4596,7 @@ skip_id_custom_self:
 
         int result = vPC[1].u.operand;
 
+        CHECK_FOR_SAMPLE();
         JSValue returnValue = callFrame->r(result).jsValue();
 
         if (UNLIKELY(!returnValue.isObject()))
@@ -4347,7 +4757,7 @@ skip_id_custom_self:
         NEXT_INSTRUCTION();
     }
     DEFINE_OPCODE(op_construct) {
-        /* construct func(r) argCount(n) registerOffset(n) proto(r) thisRegister(r)
+        /* construct func(r) argCount(n) registerOffset(n) callee(c) nativeConstructor(n)
 
            Invoke register "func" as a constructor. For JS
            functions, the calling convention is exactly as for the
@@ -4356,9 +4766,8 @@ skip_id_custom_self:
            value is passed. In either case, the argCount and registerOffset
            registers are interpreted as for the "call" opcode.
 
-           Register proto must contain the prototype property of
-           register func. This is to enable polymorphic inline
-           caching of this lookup.
+           callee and nativeConstructor cache the last JSFunction
+           constructed from this site, as for the "call" opcode.
         */
 
         int func = vPC[1].u.operand;
@@ -4368,7 +4777,22 @@ skip_id_custom_self:
         JSValue v = callFrame->r(func).jsValue();
 
         ConstructData constructData;
-        ConstructType constructType = getConstructData(v, constructData);
+        ConstructType constructType;
+        if (v.isCell() && v.asCell() == vPC[4].u.jsCell.get()) {
+            if (NativeConstructor function = vPC[5].u.nativeFunction) {
+                constructType = ConstructTypeHost;
+                constructData.native.function = function;
+            } else {
+                JSFunction* callee = asFunction(v);
+                constructType = ConstructTypeJS;
+                constructData.js.functionExecutable = callee->jsExecutable();
+                constructData.js.scopeChain = callee->scope();
+            }
+        } else {
+            constructType = getConstructData(v, constructData);
+            if (constructType != ConstructTypeNone)
+                cacheCallee(callFrame, codeBlock, vPC, v, constructType == ConstructTypeHost ? constructData.native.function : 0);
+        }
 
         if (constructType == ConstructTypeJS) {
             ScopeChainNode* callDataScopeChain = constructData.js.scopeChain;
@@ -4637,6 +5061,7 @@ skip_id_custom_self:
         */
 
         int result = vPC[1].u.operand;
+        CHECK_FOR_SAMPLE();
         return callFrame->r(result).jsValue();
     }
     DEFINE_OPCODE(op_put_getter) {
@@ -4760,11 +5185,6 @@ skip_id_custom_self:
     }
     vm_throw: {
         globalData->exception = JSValue();
-        if (!tickCount) {
-            // The exceptionValue is a lie! (GCC produces bad code for reasons I 
-            // cannot fathom if we don't assign to the exceptionValue before branching)
-            exceptionValue = createInterruptedExecutionException(globalData);
-        }
         JSGlobalObject* globalObject = callFrame->lexicalGlobalObject();
         handler = throwException(callFrame, exceptionValue, vPC - codeBlock->instructions().begin());
         if (!handler) {
@@ -4785,6 +5205,7 @@ skip_id_custom_self:
     #undef DEFINE_OPCODE
     #undef CHECK_FOR_EXCEPTION
     #undef CHECK_FOR_TIMEOUT
+    #undef CHECK_FOR_SAMPLE
 #endif // ENABLE(INTERPRETER)
 }
 
@@ -69,7 +69,7 @@ namespace JSC {
         friend class JIT;
         friend class CachedCall;
     public:
-        Interpreter(JSGlobalData&);
+        Interpreter(JSGlobalData&, size_t registerFileCapacity);
 
         RegisterFile& registerFile() { return m_registerFile; }
         
@@ -133,8 +133,10 @@ namespace JSC {
         NEVER_INLINE ScopeChainNode* createExceptionScope(CallFrame*, const Instruction* vPC);
 
         void tryCacheGetByID(CallFrame*, CodeBlock*, Instruction*, JSValue baseValue, const Identifier& propertyName, const PropertySlot&);
+        void tryCacheGetByIDList(CallFrame*, CodeBlock*, Instruction*, Opcode expectedOpcode, JSValue baseValue, const Identifier& propertyName, const PropertySlot&);
         void uncacheGetByID(CodeBlock*, Instruction* vPC);
         void tryCachePutByID(CallFrame*, CodeBlock*, Instruction*, JSValue baseValue, const PutPropertySlot&);
+        void tryCachePutByIDList(CallFrame*, CodeBlock*, Instruction*, Opcode expectedOpcode, JSValue baseValue, const PutPropertySlot&);
         void uncachePutByID(CodeBlock*, Instruction* vPC);        
 #endif // ENABLE(INTERPRETER)
 
@@ -54,7 +54,15 @@ RegisterFile::~RegisterFile()
 
 void RegisterFile::gatherConservativeRoots(ConservativeRoots& conservativeRoots)
 {
-    for (Register* it = start(); it != end(); ++it) {
+#if ENABLE(REMEMBERED_SET)
+    // Global code stores to the globals below start() like any other register, without
+    // a write barrier, so young and incremental collections cannot rely on the global
+    // object to reach them.
+    Register* begin = lastGlobal();
+#else
+    Register* begin = start();
+#endif
+    for (Register* it = begin; it != end(); ++it) {
         JSValue v = it->jsValue();
         if (!v.isCell())
             continue;
@@ -64,10 +72,19 @@ void RegisterFile::gatherConservativeRoots(ConservativeRoots& conservativeRoots)
 
 void RegisterFile::releaseExcessCapacity()
 {
-    m_reservation.decommit(m_start, reinterpret_cast<intptr_t>(m_commitEnd) - reinterpret_cast<intptr_t>(m_start));
-    addToCommittedByteCount(-(reinterpret_cast<intptr_t>(m_commitEnd) - reinterpret_cast<intptr_t>(m_start)));
-    m_commitEnd = m_start;
-    m_maxUsed = m_start;
+    Register* highWaterMark = m_highWaterMark;
+    m_highWaterMark = m_end;
+    if (m_commitEnd - highWaterMark <= maxExcessCapacity)
+        return;
+
+    // Commits are made in commitSize steps from the base of the reservation, so keep to that grid.
+    char* base = static_cast<char*>(m_reservation.base());
+    size_t usedSize = roundUpAllocationSize(reinterpret_cast<char*>(highWaterMark) - base, commitSize);
+    Register* newCommitEnd = reinterpret_cast_ptr<Register*>(base + usedSize);
+    size_t excessSize = reinterpret_cast<char*>(m_commitEnd) - reinterpret_cast<char*>(newCommitEnd);
+    m_reservation.decommit(newCommitEnd, excessSize);
+    addToCommittedByteCount(-static_cast<long>(excessSize));
+    m_commitEnd = newCommitEnd;
 }
 
 void RegisterFile::setGlobalObject(JSGlobalObject* globalObject)
@@ -108,7 +108,7 @@ namespace JSC {
         static const size_t defaultCapacity = 512 * 1024;
         static const size_t defaultMaxGlobals = 8 * 1024;
         static const size_t commitSize = 16 * 1024;
-        // Allow 8k of excess registers before we start trying to reap the registerfile
+        // Allow 8k of committed registers beyond the high water mark before we start trying to reap the registerfile
         static const ptrdiff_t maxExcessCapacity = 8 * 1024;
 
         RegisterFile(JSGlobalData&, size_t capacity = defaultCapacity, size_t maxGlobals = defaultMaxGlobals);
@@ -132,6 +132,11 @@ namespace JSC {
 
         Register* lastGlobal() const { return m_start - m_numGlobals; }
         
+        // Decommits the pages above the deepest point the register file has reached
+        // since the previous call, so that the memory committed by a burst of deep
+        // recursion is returned once the recursion has not recurred for a while.
+        void releaseExcessCapacity();
+
         static size_t committedByteCount();
         static void initializeThreading();
 
@@ -141,14 +146,13 @@ namespace JSC {
         }
 
     private:
-        void releaseExcessCapacity();
         void addToCommittedByteCount(long);
         size_t m_numGlobals;
         const size_t m_maxGlobals;
         Register* m_start;
         Register* m_end;
         Register* m_max;
-        Register* m_maxUsed;
+        Register* m_highWaterMark; // The highest m_end since the last releaseExcessCapacity().
         Register* m_commitEnd;
         PageReservation m_reservation;
 
@@ -180,7 +184,7 @@ namespace JSC {
         m_commitEnd = reinterpret_cast_ptr<Register*>(reinterpret_cast<char*>(base) + committedSize);
         m_start = static_cast<Register*>(base) + maxGlobals;
         m_end = m_start;
-        m_maxUsed = m_end;
+        m_highWaterMark = m_end;
         m_max = m_start + capacity;
     }
 
@@ -189,8 +193,6 @@ namespace JSC {
         if (newEnd >= m_end)
             return;
         m_end = newEnd;
-        if (m_end == m_start && (m_maxUsed - m_start) > maxExcessCapacity)
-            releaseExcessCapacity();
     }
 
     inline bool RegisterFile::grow(Register* newEnd)
@@ -208,8 +210,8 @@ namespace JSC {
             m_commitEnd = reinterpret_cast_ptr<Register*>(reinterpret_cast<char*>(m_commitEnd) + size);
         }
 
-        if (newEnd > m_maxUsed)
-            m_maxUsed = newEnd;
+        if (newEnd > m_highWaterMark)
+            m_highWaterMark = newEnd;
 
         m_end = newEnd;
         return true;
@@ -29,12 +29,20 @@
 
 #if ENABLE(ASSEMBLER)
 
+#if ENABLE(EXECUTABLE_ALLOCATOR_DEMAND)
+#include "TCSpinLock.h"
+#endif
+
 namespace JSC {
 
 size_t ExecutableAllocator::pageSize = 0;
+size_t ExecutableAllocator::s_memoryBudget = 0;
 
 #if ENABLE(EXECUTABLE_ALLOCATOR_DEMAND)
 
+static SpinLock spinlock = SPINLOCK_INITIALIZER;
+static size_t committedBytes = 0;
+
 void ExecutableAllocator::intializePageSize()
 {
 #if OS(SYMBIAN) && CPU(ARMV5_OR_LOWER)
@@ -54,11 +62,18 @@ ExecutablePool::Allocation ExecutablePool::systemAlloc(size_t size)
     PageAllocation allocation = PageAllocation::allocate(size, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
     if (!allocation)
         CRASH();
+    SpinLockHolder lockHolder(&spinlock);
+    committedBytes += allocation.size();
     return allocation;
 }
 
 void ExecutablePool::systemRelease(ExecutablePool::Allocation& allocation)
 {
+    {
+        SpinLockHolder lockHolder(&spinlock);
+        ASSERT(committedBytes >= allocation.size());
+        committedBytes -= allocation.size();
+    }
     allocation.deallocate();
 }
 
@@ -69,12 +84,15 @@ bool ExecutableAllocator::isValid() const
     
 bool ExecutableAllocator::underMemoryPressure()
 {
-    return false;
+    // Allocating on demand never runs out of address space, so only an
+    // explicit budget can put us under pressure. Stale data is fine here.
+    return s_memoryBudget && committedBytes > s_memoryBudget;
 }
     
 size_t ExecutableAllocator::committedByteCount()
 {
-    return 0;
+    SpinLockHolder lockHolder(&spinlock);
+    return committedBytes;
 } 
 
 #endif
@@ -194,6 +194,13 @@ public:
 
     static bool underMemoryPressure();
 
+    // A non-zero budget bounds the executable memory the JIT may keep
+    // committed; once it is exceeded, underMemoryPressure() asks the VM to
+    // discard JIT code at the next safe point. Zero (the default) leaves the
+    // allocator's own heuristic in charge.
+    static size_t memoryBudget() { return s_memoryBudget; }
+    static void setMemoryBudget(size_t budget) { s_memoryBudget = budget; }
+
     PassRefPtr<ExecutablePool> poolForSize(size_t n)
     {
         // Try to fit in the existing small allocator
@@ -338,6 +345,7 @@ private:
 #endif
 
     RefPtr<ExecutablePool> m_smallAllocationPool;
+    static size_t s_memoryBudget;
     static void intializePageSize();
 };
 
@@ -508,7 +508,11 @@ bool ExecutableAllocator::underMemoryPressure()
 {
     // Technically we should take the spin lock here, but we don't care if we get stale data.
     // This is only really a heuristic anyway.
-    return allocator && (allocator->allocated() > (FixedVMPoolPageTables::size() / 2));
+    if (!allocator)
+        return false;
+    if (s_memoryBudget)
+        return allocator->allocated() > s_memoryBudget;
+    return allocator->allocated() > (FixedVMPoolPageTables::size() / 2);
 }
 
 ExecutablePool::Allocation ExecutablePool::systemAlloc(size_t size)
@@ -92,18 +92,20 @@ JIT::JIT(JSGlobalData* globalData, CodeBlock* codeBlock)
 #if USE(JSVALUE32_64)
 void JIT::emitTimeoutCheck()
 {
-    Jump skipTimeout = branchSub32(NonZero, TrustedImm32(1), timeoutCheckRegister);
+    move(TrustedImmPtr(m_globalData->timeoutChecker.addressOfInterruptRequested()), timeoutCheckRegister);
+    Jump skipTimeout = branchTest8(Zero, Address(timeoutCheckRegister));
     JITStubCall stubCall(this, cti_timeout_check);
     stubCall.addArgument(regT1, regT0); // save last result registers.
-    stubCall.call(timeoutCheckRegister);
+    stubCall.call();
     stubCall.getArgument(0, regT1, regT0); // reload last result registers.
     skipTimeout.link(this);
 }
 #else
 void JIT::emitTimeoutCheck()
 {
-    Jump skipTimeout = branchSub32(NonZero, TrustedImm32(1), timeoutCheckRegister);
-    JITStubCall(this, cti_timeout_check).call(timeoutCheckRegister);
+    move(TrustedImmPtr(m_globalData->timeoutChecker.addressOfInterruptRequested()), timeoutCheckRegister);
+    Jump skipTimeout = branchTest8(Zero, Address(timeoutCheckRegister));
+    JITStubCall(this, cti_timeout_check).call();
     skipTimeout.link(this);
 
     killLastResultRegister();
@@ -337,6 +339,7 @@ void JIT::privateCompileMainPass()
         case op_get_string_length:
         case op_put_by_id_generic:
         case op_put_by_id_replace:
+        case op_put_by_id_replace_list:
         case op_put_by_id_transition:
             ASSERT_NOT_REACHED();
         }
@@ -479,6 +482,11 @@ JITCode JIT::privateCompile(CodePtr* functionEntryArityCheck)
         // In the case of a fast linked call, we do not set this up in the caller.
         emitPutImmediateToCallFrameHeader(m_codeBlock, RegisterFile::CodeBlock);
 
+        // Under an executable memory budget, count entries so that cold code
+        // can be told apart from hot code when memory has to be released.
+        if (ExecutableAllocator::memoryBudget())
+            add32(TrustedImm32(1), AbsoluteAddress(m_codeBlock->addressOfExecuteCounter()));
+
         addPtr(Imm32(m_codeBlock->m_numCalleeRegisters * sizeof(Register)), callFrameRegister, regT1);
         registerFileCheck = branchPtr(Below, AbsoluteAddress(m_globalData->interpreter->registerFile().addressOfEnd()), regT1);
     }
@@ -602,8 +610,11 @@ void JIT::linkCall(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBlock* ca
     if (!calleeCodeBlock || (callerArgCount == calleeCodeBlock->m_numParameters)) {
         ASSERT(!callLinkInfo->isLinked());
         callLinkInfo->callee.set(*globalData, callerCodeBlock->ownerExecutable(), callee);
+        callLinkInfo->caller = callerCodeBlock;
         repatchBuffer.repatch(callLinkInfo->hotPathBegin, callee);
         repatchBuffer.relink(callLinkInfo->hotPathOther, code);
+        if (calleeCodeBlock)
+            calleeCodeBlock->linkIncomingCall(callLinkInfo);
     }
 
     // patch the call so we do not continue to try to link.
@@ -619,13 +630,29 @@ void JIT::linkConstruct(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBloc
     if (!calleeCodeBlock || (callerArgCount == calleeCodeBlock->m_numParameters)) {
         ASSERT(!callLinkInfo->isLinked());
         callLinkInfo->callee.set(*globalData, callerCodeBlock->ownerExecutable(), callee);
+        callLinkInfo->caller = callerCodeBlock;
         repatchBuffer.repatch(callLinkInfo->hotPathBegin, callee);
         repatchBuffer.relink(callLinkInfo->hotPathOther, code);
+        if (calleeCodeBlock)
+            calleeCodeBlock->linkIncomingCall(callLinkInfo);
     }
 
     // patch the call so we do not continue to try to link.
     repatchBuffer.relink(callLinkInfo->callReturnLocation, globalData->jitStubs->ctiVirtualConstruct());
 }
+
+void JIT::unlinkCall(CallLinkInfo* callLinkInfo, bool isConstruct, JSGlobalData* globalData)
+{
+    ASSERT(callLinkInfo->isLinked());
+    RepatchBuffer repatchBuffer(callLinkInfo->caller);
+
+    // Put the call site back the way the JIT left it, so the next call goes
+    // through the slow case and may link again once the callee is recompiled.
+    repatchBuffer.repatch(callLinkInfo->hotPathBegin, 0);
+    repatchBuffer.relink(callLinkInfo->callReturnLocation, isConstruct ? globalData->jitStubs->ctiVirtualConstructLink() : globalData->jitStubs->ctiVirtualCallLink());
+    callLinkInfo->setUnlinked();
+    callLinkInfo->remove();
+}
 #endif // ENABLE(JIT_OPTIMIZE_CALL)
 
 } // namespace JSC
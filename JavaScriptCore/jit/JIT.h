@@ -246,6 +246,7 @@ namespace JSC {
 
         static void linkCall(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBlock* calleeCodeBlock, CodePtr, CallLinkInfo*, int callerArgCount, JSGlobalData*);
         static void linkConstruct(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBlock* calleeCodeBlock, CodePtr, CallLinkInfo*, int callerArgCount, JSGlobalData*);
+        static void unlinkCall(CallLinkInfo*, bool isConstruct, JSGlobalData*);
 
     private:
         struct JSRInfo {
@@ -936,6 +937,10 @@ namespace JSC {
         void emitLoadCharacterString(RegisterID src, RegisterID dst, JumpList& failures);
         
         void emitTimeoutCheck();
+
+        // Puts the owner's block in the heap's remembered set; see writeBarrier().
+        void emitWriteBarrier(RegisterID owner, RegisterID scratch);
+        void emitWriteBarrier(JSCell* owner);
 #ifndef NDEBUG
         void printBytecodeOperandTypes(unsigned src1, unsigned src2);
 #endif
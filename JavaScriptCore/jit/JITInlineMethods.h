@@ -89,6 +89,8 @@ ALWAYS_INLINE void JIT::emitLoadCharacterString(RegisterID src, RegisterID dst,
     failures.append(branch32(NotEqual, MacroAssembler::Address(src, ThunkHelpers::jsStringLengthOffset()), TrustedImm32(1)));
     loadPtr(MacroAssembler::Address(src, ThunkHelpers::jsStringValueOffset()), dst);
     loadPtr(MacroAssembler::Address(dst, ThunkHelpers::stringImplDataOffset()), dst);
+    // 8-bit strings have no 16-bit buffer until the slow path asks for one.
+    failures.append(branchTestPtr(Zero, dst));
     load16(MacroAssembler::Address(dst, 0), dst);
 }
 
@@ -266,6 +268,27 @@ ALWAYS_INLINE void JIT::restoreArgumentReferenceForTrampoline()
     // In the trampoline on x86-64, the first argument register is not overwritten.
 }
 
+ALWAYS_INLINE void JIT::emitWriteBarrier(RegisterID owner, RegisterID scratch)
+{
+#if ENABLE(REMEMBERED_SET)
+    move(owner, scratch);
+    andPtr(TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch);
+    store32(TrustedImm32(1), Address(scratch, MarkedBlock::offsetOfIsRemembered()));
+#else
+    UNUSED_PARAM(owner);
+    UNUSED_PARAM(scratch);
+#endif
+}
+
+ALWAYS_INLINE void JIT::emitWriteBarrier(JSCell* owner)
+{
+#if ENABLE(REMEMBERED_SET)
+    store32(TrustedImm32(1), MarkedBlock::blockFor(owner)->addressOfIsRemembered());
+#else
+    UNUSED_PARAM(owner);
+#endif
+}
+
 ALWAYS_INLINE JIT::Jump JIT::checkStructure(RegisterID reg, Structure* structure)
 {
     return branchPtr(NotEqual, Address(reg, JSCell::structureOffset()), TrustedImmPtr(structure));
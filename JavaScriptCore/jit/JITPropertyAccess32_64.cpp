@@ -278,6 +278,8 @@ JIT::CodePtr JIT::stringGetByValStubGenerator(JSGlobalData* globalData, Executab
     jit.load32(Address(regT0, ThunkHelpers::jsStringLengthOffset()), regT1);
     jit.loadPtr(Address(regT0, ThunkHelpers::jsStringValueOffset()), regT0);
     jit.loadPtr(Address(regT0, ThunkHelpers::stringImplDataOffset()), regT0);
+    // 8-bit strings have no 16-bit buffer until the slow path asks for one.
+    failures.append(jit.branchTestPtr(Zero, regT0));
     
     // Do an unsigned compare to simultaneously filter negative indices as well as indices that are too large
     failures.append(jit.branch32(AboveOrEqual, regT2, regT1));
@@ -364,6 +366,8 @@ void JIT::emit_op_put_by_val(Instruction* currentInstruction)
     addSlowCase(branchPtr(NotEqual, Address(regT0), TrustedImmPtr(m_globalData->jsArrayVPtr)));
     addSlowCase(branch32(AboveOrEqual, regT2, Address(regT0, JSArray::vectorLengthOffset())));
     
+    // The base's tag is dead once it is known to be an array; value loading refills regT1.
+    emitWriteBarrier(regT0, regT1);
     loadPtr(Address(regT0, JSArray::storageOffset()), regT3);
     
     Jump empty = branch32(Equal, BaseIndex(regT3, regT2, TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.tag)), TrustedImm32(JSValue::EmptyValueTag));
@@ -496,6 +500,13 @@ void JIT::emit_op_put_by_id(Instruction* currentInstruction)
     emitLoad2(base, regT1, regT0, value, regT3, regT2);
     
     emitJumpSlowCaseIfNotJSCell(base, regT1);
+
+    // The barrier goes ahead of the patchable sequence, which must keep its layout. The base's
+    // tag is restored afterwards because the slow case passes it on.
+#if ENABLE(REMEMBERED_SET)
+    emitWriteBarrier(regT0, regT1);
+    move(TrustedImm32(JSValue::CellTag), regT1);
+#endif
     
     BEGIN_UNINTERRUPTED_SEQUENCE(sequencePutById);
     
@@ -603,6 +614,7 @@ void JIT::privateCompilePutByIdTransition(StructureStubInfo* stubInfo, Structure
         restoreReturnAddressBeforeReturn(regT3);
     }
 
+    emitWriteBarrier(regT0, regT2);
     storePtrWithWriteBarrier(TrustedImmPtr(newStructure), regT0, Address(regT0, JSCell::structureOffset()));
     
 #if CPU(MIPS) || CPU(SH4)
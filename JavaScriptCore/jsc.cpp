@@ -31,6 +31,7 @@
 #include "JSFunction.h"
 #include "JSLock.h"
 #include "JSString.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
 #include <math.h>
 #include <stdio.h>
@@ -106,6 +107,7 @@ struct Options {
 
     bool interactive;
     bool dump;
+    UString profileFile;
     Vector<Script> scripts;
     Vector<UString> arguments;
 };
@@ -194,7 +196,7 @@ EncodedJSValue JSC_HOST_CALL functionDebug(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL functionGC(ExecState* exec)
 {
     JSLock lock(SilenceAssertionsOnly);
-    exec->heap()->collectAllGarbage();
+    exec->heap()->collectAllGarbage(Heap::SweepNow);
     return JSValue::encode(jsUndefined());
 }
 
@@ -472,6 +474,7 @@ static NO_RETURN void printUsageStatement(JSGlobalData* globalData, bool help =
     fprintf(stderr, "  -f         Specifies a source file (deprecated)\n");
     fprintf(stderr, "  -h|--help  Prints this help message\n");
     fprintf(stderr, "  -i         Enables interactive mode (default if no files are specified)\n");
+    fprintf(stderr, "  -p <file>  Samples the JavaScript stack and writes it to file as folded stacks\n");
 #if HAVE(SIGNAL_H)
     fprintf(stderr, "  -s         Installs signal handlers that exit on a crash (Unix platforms only)\n");
 #endif
@@ -505,6 +508,12 @@ static void parseArguments(int argc, char** argv, Options& options, JSGlobalData
             options.dump = true;
             continue;
         }
+        if (!strcmp(arg, "-p")) {
+            if (++i == argc)
+                printUsageStatement(globalData);
+            options.profileFile = argv[i];
+            continue;
+        }
         if (!strcmp(arg, "-s")) {
 #if HAVE(SIGNAL_H)
             signal(SIGILL, _exit);
@@ -537,11 +546,26 @@ int jscmain(int argc, char** argv, JSGlobalData* globalData)
     Options options;
     parseArguments(argc, argv, options, globalData);
 
+    if (!options.profileFile.isNull()) {
+        globalData->samplingProfiler = adoptPtr(new SamplingProfiler(*globalData));
+        globalData->samplingProfiler->start();
+    }
+
     GlobalObject* globalObject = new (globalData) GlobalObject(*globalData, GlobalObject::createStructure(*globalData, jsNull()), options.arguments);
     bool success = runWithScripts(globalObject, options.scripts, options.dump);
     if (options.interactive && success)
         runInteractive(globalObject);
 
+    if (globalData->samplingProfiler) {
+        globalData->samplingProfiler->stop();
+        if (FILE* profile = fopen(options.profileFile.utf8().data(), "w")) {
+            CString stacks = globalData->samplingProfiler->foldedStacks().utf8();
+            fwrite(stacks.data(), 1, stacks.length(), profile);
+            fclose(profile);
+        } else
+            fprintf(stderr, "Could not open file: %s\n", options.profileFile.utf8().data());
+    }
+
     return success ? 0 : 3;
 }
 
@@ -474,12 +474,14 @@ private:
         {
             ASSERT(m_isFunction);
             m_usesEval = info->usesEval;
+            // Items restored from a serialized cache hold plain strings; identifier sets are keyed by
+            // pointer, so make sure every name is uniqued. This is a no-op for names that already are.
             unsigned size = info->usedVariables.size();
             for (unsigned i = 0; i < size; ++i)
-                m_usedVariables.add(info->usedVariables[i]);
+                m_usedVariables.add(Identifier(m_globalData, info->usedVariables[i].get()).impl());
             size = info->writtenVariables.size();
             for (unsigned i = 0; i < size; ++i)
-                m_writtenVariables.add(info->writtenVariables[i]);
+                m_writtenVariables.add(Identifier(m_globalData, info->writtenVariables[i].get()).impl());
         }
 
     private:
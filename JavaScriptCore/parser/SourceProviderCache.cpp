@@ -27,9 +27,88 @@
 #include "SourceProviderCache.h"
 
 #include "SourceProviderCacheItem.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/SHA1.h>
 
 namespace JSC {
 
+// Bump this whenever the layout written by serialize() or the meaning of SourceProviderCacheItem changes.
+static const unsigned serializationVersion = 2;
+
+typedef Vector<uint8_t, 20> SourceDigest;
+
+static void computeSourceDigest(const UChar* source, unsigned sourceLength, SourceDigest& digest)
+{
+    SHA1 sha1;
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(source), sourceLength * sizeof(UChar));
+    sha1.computeHash(digest);
+}
+
+template <typename T> static inline void appendValue(Vector<char>& buffer, T value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendIdentifiers(Vector<char>& buffer, const Vector<RefPtr<StringImpl> >& identifiers)
+{
+    appendValue<unsigned>(buffer, identifiers.size());
+    for (size_t i = 0; i < identifiers.size(); ++i) {
+        StringImpl* identifier = identifiers[i].get();
+        appendValue<unsigned>(buffer, identifier->length());
+        buffer.append(reinterpret_cast<const char*>(identifier->characters()), identifier->length() * sizeof(UChar));
+    }
+}
+
+class SerializedDataReader {
+public:
+    SerializedDataReader(const char* data, size_t size)
+        : m_position(data)
+        , m_end(data + size)
+    {
+    }
+
+    template <typename T> bool read(T& value)
+    {
+        if (static_cast<size_t>(m_end - m_position) < sizeof(T))
+            return false;
+        memcpy(&value, m_position, sizeof(T));
+        m_position += sizeof(T);
+        return true;
+    }
+
+    bool readIdentifiers(Vector<RefPtr<StringImpl> >& identifiers)
+    {
+        unsigned count;
+        if (!read(count))
+            return false;
+        for (unsigned i = 0; i < count; ++i) {
+            unsigned length;
+            if (!read(length) || static_cast<size_t>(m_end - m_position) / sizeof(UChar) < length)
+                return false;
+            UChar* characters;
+            RefPtr<StringImpl> identifier = StringImpl::createUninitialized(length, characters);
+            memcpy(characters, m_position, length * sizeof(UChar));
+            m_position += length * sizeof(UChar);
+            identifiers.append(identifier.release());
+        }
+        return true;
+    }
+
+    bool readAndCompare(const SourceDigest& digest)
+    {
+        if (static_cast<size_t>(m_end - m_position) < digest.size() || memcmp(m_position, digest.data(), digest.size()))
+            return false;
+        m_position += digest.size();
+        return true;
+    }
+
+    bool atEnd() const { return m_position == m_end; }
+
+private:
+    const char* m_position;
+    const char* m_end;
+};
+
 SourceProviderCache::~SourceProviderCache()
 {
     clear();
@@ -53,4 +132,75 @@ void SourceProviderCache::add(int sourcePosition, PassOwnPtr<SourceProviderCache
     m_contentByteSize += size;
 }
 
+void SourceProviderCache::serialize(const UChar* source, unsigned sourceLength, Vector<char>& buffer) const
+{
+    SourceDigest digest;
+    computeSourceDigest(source, sourceLength, digest);
+
+    appendValue<unsigned>(buffer, serializationVersion);
+    appendValue<unsigned>(buffer, sourceLength);
+    buffer.append(reinterpret_cast<const char*>(digest.data()), digest.size());
+    appendValue<unsigned>(buffer, m_map.size());
+    HashMap<int, SourceProviderCacheItem*>::const_iterator end = m_map.end();
+    for (HashMap<int, SourceProviderCacheItem*>::const_iterator it = m_map.begin(); it != end; ++it) {
+        const SourceProviderCacheItem* item = it->second;
+        appendValue<int>(buffer, it->first);
+        appendValue<int>(buffer, item->closeBraceLine);
+        appendValue<int>(buffer, item->closeBracePos);
+        appendValue<char>(buffer, item->usesEval);
+        appendIdentifiers(buffer, item->usedVariables);
+        appendIdentifiers(buffer, item->writtenVariables);
+    }
+}
+
+bool SourceProviderCache::deserialize(const UChar* source, unsigned sourceLength, const char* data, size_t size)
+{
+    SerializedDataReader reader(data, size);
+    unsigned version;
+    unsigned length;
+    unsigned count;
+    if (!reader.read(version) || version != serializationVersion)
+        return false;
+    if (!reader.read(length) || length != sourceLength)
+        return false;
+    SourceDigest digest;
+    computeSourceDigest(source, sourceLength, digest);
+    if (!reader.readAndCompare(digest))
+        return false;
+    if (!reader.read(count))
+        return false;
+
+    // Parse everything before touching the map so that a truncated or corrupt buffer is ignored as a whole.
+    Vector<std::pair<int, SourceProviderCacheItem*> > items;
+    bool succeeded = true;
+    for (unsigned i = 0; succeeded && i < count; ++i) {
+        int sourcePosition;
+        int closeBraceLine;
+        int closeBracePos;
+        char usesEval;
+        if (!reader.read(sourcePosition) || !reader.read(closeBraceLine) || !reader.read(closeBracePos) || !reader.read(usesEval)) {
+            succeeded = false;
+            break;
+        }
+        SourceProviderCacheItem* item = new SourceProviderCacheItem(closeBraceLine, closeBracePos);
+        item->usesEval = usesEval;
+        items.append(std::make_pair(sourcePosition, item));
+        succeeded = reader.readIdentifiers(item->usedVariables) && reader.readIdentifiers(item->writtenVariables);
+    }
+    if (!succeeded || !reader.atEnd()) {
+        for (size_t i = 0; i < items.size(); ++i)
+            delete items[i].second;
+        return false;
+    }
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        OwnPtr<SourceProviderCacheItem> item = adoptPtr(items[i].second);
+        if (m_map.contains(items[i].first))
+            continue;
+        unsigned size = item->approximateByteSize();
+        add(items[i].first, item.release(), size);
+    }
+    return true;
+}
+
 }
@@ -25,6 +25,8 @@
 
 #include <wtf/HashMap.h>
 #include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/unicode/Unicode.h>
 
 namespace JSC {
 
@@ -39,6 +41,19 @@ public:
     unsigned byteSize() const;
     void add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>, unsigned size);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
+    bool isEmpty() const { return m_map.isEmpty(); }
+    unsigned size() const { return m_map.size(); }
+
+    // Flattens the cached function information into a buffer that an embedder can persist
+    // alongside the script source (e.g. as cached resource metadata), so a later load of the
+    // same source can skip straight over function bodies the first time they are parsed.
+    // The buffer is tagged with the length and a SHA-1 digest of the source, and is only
+    // meaningful on the architecture and build that produced it.
+    void serialize(const UChar* source, unsigned sourceLength, Vector<char>&) const;
+    // Adds the items from a buffer produced by serialize() to this cache. Returns false and
+    // leaves the cache untouched if the buffer was produced for a different source or by an
+    // incompatible version.
+    bool deserialize(const UChar* source, unsigned sourceLength, const char*, size_t);
 
 private:
     HashMap<int, SourceProviderCacheItem*> m_map;
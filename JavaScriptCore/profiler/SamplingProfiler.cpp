@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of Apple Computer, Inc. ("Apple") nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#include "CallFrame.h"
+#include "CodeBlock.h"
+#include "Executable.h"
+#include "JSGlobalData.h"
+#include "UStringBuilder.h"
+#include <algorithm>
+#include <string.h>
+#include <wtf/CurrentTime.h>
+
+using namespace std;
+
+namespace JSC {
+
+// Deeper stacks are cut off at the root end.
+static const unsigned maximumStackDepth = 128;
+
+// Number of words buffered before pending samples are folded into the stack counts.
+static const size_t pendingSamplesCapacity = 16 * 1024;
+
+// A folded stack key holds each frame as two 32-bit words.
+static const unsigned charactersPerFrame = 2 * sizeof(uint32_t) / sizeof(UChar);
+
+SamplingProfiler::SamplingProfiler(JSGlobalData& globalData)
+    : m_globalData(globalData)
+    , m_sampleIsDue(false)
+    , m_timerThread(0)
+    , m_timerShouldStop(false)
+    , m_sampleInterval(0)
+    , m_sampleCount(0)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::start(unsigned samplesPerSecond)
+{
+    stop();
+
+    m_pendingSamples.clear();
+    m_pendingSamples.reserveCapacity(pendingSamplesCapacity + 1 + 2 * maximumStackDepth);
+    m_stackCounts.clear();
+    m_sampleCount = 0;
+    m_frameIDs.clear();
+    m_frameNames.clear();
+
+    m_sampleInterval = 1.0 / max(samplesPerSecond, 1u);
+    m_timerShouldStop = false;
+    m_timerThread = createThread(timerThreadEntryPoint, this, "JSC::SamplingProfiler");
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_timerThread)
+        return;
+
+    {
+        MutexLocker locker(m_timerMutex);
+        m_timerShouldStop = true;
+        m_timerCondition.signal();
+    }
+    waitForThreadCompletion(m_timerThread, 0);
+    m_timerThread = 0;
+    m_sampleIsDue = false;
+}
+
+void* SamplingProfiler::timerThreadEntryPoint(void* profiler)
+{
+    static_cast<SamplingProfiler*>(profiler)->runTimer();
+    return 0;
+}
+
+void SamplingProfiler::runTimer()
+{
+    MutexLocker locker(m_timerMutex);
+    double nextSampleTime = currentTime();
+    while (!m_timerShouldStop) {
+        // Keep to the schedule despite wakeup latency, but do not try to make up for ticks
+        // that were missed altogether.
+        double now = currentTime();
+        nextSampleTime += m_sampleInterval;
+        if (nextSampleTime < now)
+            nextSampleTime = now + m_sampleInterval;
+
+        // A signal means stop() wants us to exit; anything else is a timeout or a spurious wakeup.
+        if (!m_timerCondition.timedWait(m_timerMutex, nextSampleTime)) {
+            m_sampleIsDue = true;
+            m_globalData.timeoutChecker.requestInterrupt();
+        }
+    }
+}
+
+void SamplingProfiler::discardDueSample()
+{
+    m_sampleIsDue = false;
+}
+
+static UString frameName(CodeBlock* codeBlock)
+{
+    ScriptExecutable* executable = codeBlock->ownerExecutable();
+
+    UStringBuilder builder;
+    switch (codeBlock->codeType()) {
+    case GlobalCode:
+        builder.append("(program)");
+        break;
+    case EvalCode:
+        builder.append("(eval)");
+        break;
+    case FunctionCode: {
+        const Identifier& name = static_cast<FunctionExecutable*>(executable)->name();
+        if (name.isEmpty())
+            builder.append("(anonymous function)");
+        else
+            builder.append(name.ustring());
+        break;
+    }
+    }
+    builder.append(' ');
+    builder.append(executable->sourceURL());
+    return builder.toUString();
+}
+
+unsigned SamplingProfiler::frameIDFor(CodeBlock* codeBlock)
+{
+    pair<HashMap<CodeBlock*, unsigned>::iterator, bool> result = m_frameIDs.add(codeBlock, m_frameNames.size());
+    if (result.second)
+        m_frameNames.append(frameName(codeBlock));
+    return result.first->second;
+}
+
+void SamplingProfiler::takeSample(ExecState* exec, Instruction* vPC)
+{
+    m_sampleIsDue = false;
+
+#if ENABLE(INTERPRETER)
+    size_t sampleStart = m_pendingSamples.size();
+    m_pendingSamples.append(0);
+
+    unsigned depth = 0;
+    for (CallFrame* callFrame = exec; callFrame && depth < maximumStackDepth; callFrame = callFrame->callerFrame()->removeHostCallFrameFlag()) {
+        // Host function frames have no CodeBlock, and frames entered from host code have no return vPC.
+        if (CodeBlock* codeBlock = callFrame->codeBlock()) {
+            unsigned bytecodeOffset = vPC ? codeBlock->bytecodeOffset(vPC) : 0;
+            m_pendingSamples.append(frameIDFor(codeBlock));
+            m_pendingSamples.append(codeBlock->lineNumberForBytecodeOffset(bytecodeOffset));
+            ++depth;
+        }
+        vPC = callFrame->returnVPC();
+    }
+
+    if (!depth) {
+        m_pendingSamples.shrink(sampleStart);
+        return;
+    }
+
+    m_pendingSamples[sampleStart] = depth;
+    ++m_sampleCount;
+
+    if (m_pendingSamples.size() >= pendingSamplesCapacity)
+        flushPendingSamples();
+#else
+    UNUSED_PARAM(exec);
+    UNUSED_PARAM(vPC);
+#endif
+}
+
+void SamplingProfiler::flushPendingSamples()
+{
+    for (size_t i = 0; i < m_pendingSamples.size(); ) {
+        unsigned depth = m_pendingSamples[i++];
+        RefPtr<StringImpl> stack = StringImpl::create(reinterpret_cast<const UChar*>(&m_pendingSamples[i]), depth * charactersPerFrame);
+        ++m_stackCounts.add(stack.release(), 0).first->second;
+        i += 2 * depth;
+    }
+    m_pendingSamples.shrink(0);
+}
+
+UString SamplingProfiler::foldedStacks()
+{
+    flushPendingSamples();
+
+    Vector<UString> lines;
+    Vector<uint32_t> frames;
+    HashMap<RefPtr<StringImpl>, unsigned, StringHash>::iterator end = m_stackCounts.end();
+    for (HashMap<RefPtr<StringImpl>, unsigned, StringHash>::iterator it = m_stackCounts.begin(); it != end; ++it) {
+        unsigned depth = it->first->length() / charactersPerFrame;
+        frames.resize(2 * depth);
+        memcpy(frames.data(), it->first->characters(), frames.size() * sizeof(uint32_t));
+
+        UStringBuilder builder;
+        for (unsigned i = depth; i--; ) {
+            builder.append(m_frameNames[frames[2 * i]]);
+            builder.append(':');
+            builder.append(UString::number(frames[2 * i + 1]));
+            builder.append(i ? ';' : ' ');
+        }
+        builder.append(UString::number(it->second));
+        builder.append('\n');
+        lines.append(builder.toUString());
+    }
+    std::sort(lines.begin(), lines.end());
+
+    UStringBuilder result;
+    for (size_t i = 0; i < lines.size(); ++i)
+        result.append(lines[i]);
+    return result.toUString();
+}
+
+} // namespace JSC
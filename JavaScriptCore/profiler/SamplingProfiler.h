@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of Apple Computer, Inc. ("Apple") nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#include "UString.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+
+namespace JSC {
+
+    class CodeBlock;
+    class ExecState;
+    class JSGlobalData;
+    struct Instruction;
+
+    // Statistical profiler for interpreted JavaScript that can be switched on in a
+    // release build. A timer thread marks a sample as due at a fixed rate and
+    // raises the TimeoutChecker's interrupt flag; the interpreter notices at the
+    // next loop back-edge or return, and records the stack of (CodeBlock, line)
+    // pairs there. Stacks are exported in the "folded" format that flame graph
+    // tools consume: one line per distinct stack, root frame first, frames
+    // separated by ';', followed by the number of samples.
+    //
+    // Everything except the flags belongs to the thread that runs the JSGlobalData.
+    class SamplingProfiler {
+        WTF_MAKE_NONCOPYABLE(SamplingProfiler); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        static const unsigned defaultSamplesPerSecond = 1000;
+
+        explicit SamplingProfiler(JSGlobalData&);
+        ~SamplingProfiler();
+
+        // Starting discards the samples of the previous run.
+        void start(unsigned samplesPerSecond = defaultSamplesPerSecond);
+        void stop();
+        bool isRunning() const { return m_timerThread; }
+
+        bool sampleIsDue() const { return m_sampleIsDue; }
+        void takeSample(ExecState*, Instruction* vPC);
+
+        // A tick that arrived while no JavaScript was running measured idle time.
+        void discardDueSample();
+
+        void codeBlockWillBeDestroyed(CodeBlock* codeBlock)
+        {
+            if (!m_frameIDs.isEmpty())
+                m_frameIDs.remove(codeBlock);
+        }
+
+        unsigned sampleCount() const { return m_sampleCount; }
+        UString foldedStacks();
+
+    private:
+        static void* timerThreadEntryPoint(void*);
+        void runTimer();
+
+        unsigned frameIDFor(CodeBlock*);
+        void flushPendingSamples();
+
+        JSGlobalData& m_globalData;
+        volatile bool m_sampleIsDue;
+
+        ThreadIdentifier m_timerThread;
+        Mutex m_timerMutex;
+        ThreadCondition m_timerCondition;
+        bool m_timerShouldStop;
+        double m_sampleInterval;
+
+        // Each pending sample is its depth followed by a (frame ID, line) pair per frame,
+        // innermost first. They are folded into m_stackCounts in batches.
+        Vector<uint32_t> m_pendingSamples;
+        HashMap<RefPtr<StringImpl>, unsigned, StringHash> m_stackCounts;
+        unsigned m_sampleCount;
+
+        // Frame IDs outlive the CodeBlocks they were assigned to, so that a stack can
+        // still be named after the code it sampled has been thrown away.
+        HashMap<CodeBlock*, unsigned> m_frameIDs;
+        Vector<UString> m_frameNames;
+    };
+
+} // namespace JSC
+
+#endif // SamplingProfiler_h
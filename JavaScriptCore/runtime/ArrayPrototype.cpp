@@ -344,7 +344,13 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncConcat(ExecState* exec)
         if (curArg.inherits(&JSArray::s_info)) {
             unsigned length = curArg.get(exec, exec->propertyNames().length).toUInt32(exec);
             JSObject* curObject = curArg.toObject(exec);
-            for (unsigned k = 0; k < length; ++k) {
+            unsigned k = 0;
+            if (isJSArray(&exec->globalData(), curObject)) {
+                JSArray* array = asArray(curObject);
+                for (; k < length && array->canGetIndex(k); ++k)
+                    arr->put(exec, n++, array->getIndex(k));
+            }
+            for (; k < length; ++k) {
                 if (JSValue v = getProperty(exec, curObject, k))
                     arr->put(exec, n, v);
                 n++;
@@ -390,9 +396,13 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncPush(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
 
-    if (isJSArray(&exec->globalData(), thisValue) && exec->argumentCount() == 1) {
+    if (isJSArray(&exec->globalData(), thisValue)) {
         JSArray* array = asArray(thisValue);
-        array->push(exec, exec->argument(0));
+        for (unsigned n = 0; n < exec->argumentCount(); n++) {
+            array->push(exec, exec->argument(n));
+            if (exec->hadException())
+                return JSValue::encode(jsUndefined());
+        }
         return JSValue::encode(jsNumber(array->length()));
     }
 
@@ -477,10 +487,6 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSlice(ExecState* exec)
     // http://developer.netscape.com/docs/manuals/js/client/jsref/array.htm#1193713 or 15.4.4.10
     JSObject* thisObj = exec->hostThisValue().toThisObject(exec);
 
-    // We return a new array
-    JSArray* resObj = constructEmptyArray(exec);
-    JSValue result = resObj;
-
     unsigned length = thisObj->get(exec, exec->propertyNames().length).toUInt32(exec);
     if (exec->hadException())
         return JSValue::encode(jsUndefined());
@@ -488,6 +494,15 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSlice(ExecState* exec)
     unsigned begin = argumentClampedIndexFromStartOrEnd(exec, 0, length);
     unsigned end = argumentClampedIndexFromStartOrEnd(exec, 1, length, length);
 
+    if (isJSArray(&exec->globalData(), thisObj)) {
+        if (JSArray* result = asArray(thisObj)->fastSlice(exec, begin, end > begin ? end - begin : 0))
+            return JSValue::encode(result);
+    }
+
+    // We return a new array
+    JSArray* resObj = constructEmptyArray(exec);
+    JSValue result = resObj;
+
     unsigned n = 0;
     for (unsigned k = begin; k < end; k++, n++) {
         if (JSValue v = getProperty(exec, thisObj, k))
@@ -582,15 +597,27 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSplice(ExecState* exec)
             deleteCount = static_cast<unsigned>(deleteDouble);
     }
 
-    JSArray* resObj = new (exec) JSArray(exec->globalData(), exec->lexicalGlobalObject()->arrayStructure(), deleteCount, CreateCompact);
-    JSValue result = resObj;
     JSGlobalData& globalData = exec->globalData();
-    for (unsigned k = 0; k < deleteCount; k++)
-        resObj->uncheckedSetIndex(globalData, k, getProperty(exec, thisObj, k + begin));
-
-    resObj->setLength(deleteCount);
+    JSArray* resObj = 0;
+    if (isJSArray(&globalData, thisObj))
+        resObj = asArray(thisObj)->fastSlice(exec, begin, deleteCount);
+    if (!resObj) {
+        resObj = new (exec) JSArray(globalData, exec->lexicalGlobalObject()->arrayStructure(), deleteCount, CreateCompact);
+        for (unsigned k = 0; k < deleteCount; k++)
+            resObj->uncheckedSetIndex(globalData, k, getProperty(exec, thisObj, k + begin));
+
+        resObj->setLength(deleteCount);
+    }
+    JSValue result = resObj;
 
     unsigned additionalArgs = std::max<int>(exec->argumentCount() - 2, 0);
+    if (isJSArray(&globalData, thisObj) && asArray(thisObj)->length() == length) {
+        // Only point past the start and delete count when there are items after them.
+        ArgList args(exec);
+        const JSValue* items = additionalArgs ? args.begin() + 2 : 0;
+        if (asArray(thisObj)->fastSplice(exec, begin, deleteCount, items, additionalArgs))
+            return JSValue::encode(result);
+    }
     if (additionalArgs != deleteCount) {
         if (additionalArgs < deleteCount) {
             if ((!begin) && (isJSArray(&exec->globalData(), thisObj)))
@@ -1099,6 +1126,13 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
 
     unsigned index = argumentClampedIndexFromStartOrEnd(exec, 1, length);
     JSValue searchElement = exec->argument(0);
+    if (isJSArray(&exec->globalData(), thisObj)) {
+        JSArray* array = asArray(thisObj);
+        for (; index < length && array->canGetIndex(index); ++index) {
+            if (JSValue::strictEqual(exec, searchElement, array->getIndex(index)))
+                return JSValue::encode(jsNumber(index));
+        }
+    }
     for (; index < length; ++index) {
         JSValue e = getProperty(exec, thisObj, index);
         if (!e)
@@ -1132,6 +1166,15 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncLastIndexOf(ExecState* exec)
     }
 
     JSValue searchElement = exec->argument(0);
+    if (isJSArray(&exec->globalData(), thisObj)) {
+        JSArray* array = asArray(thisObj);
+        while (array->canGetIndex(index)) {
+            if (JSValue::strictEqual(exec, searchElement, array->getIndex(index)))
+                return JSValue::encode(jsNumber(index));
+            if (!index--)
+                return JSValue::encode(jsNumber(-1));
+        }
+    }
     do {
         ASSERT(index < length);
         JSValue e = getProperty(exec, thisObj, index);
@@ -368,6 +368,26 @@ void FunctionExecutable::discardCode()
 #endif
 }
 
+#if ENABLE(JIT)
+unsigned FunctionExecutable::executeCount() const
+{
+    unsigned count = 0;
+    if (m_codeBlockForCall)
+        count += m_codeBlockForCall->executeCounter();
+    if (m_codeBlockForConstruct)
+        count += m_codeBlockForConstruct->executeCounter();
+    return count;
+}
+
+void FunctionExecutable::resetExecuteCounters()
+{
+    if (m_codeBlockForCall)
+        m_codeBlockForCall->resetExecuteCounter();
+    if (m_codeBlockForConstruct)
+        m_codeBlockForConstruct->resetExecuteCounter();
+}
+#endif
+
 FunctionExecutable* FunctionExecutable::fromGlobalCode(const Identifier& functionName, ExecState* exec, Debugger* debugger, const SourceCode& source, JSObject** exception)
 {
     JSGlobalObject* lexicalGlobalObject = exec->lexicalGlobalObject();
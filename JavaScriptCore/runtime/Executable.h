@@ -376,6 +376,12 @@ namespace JSC {
         SharedSymbolTable* symbolTable() const { return m_symbolTable; }
 
         void discardCode();
+#if ENABLE(JIT)
+        bool hasCode() const { return m_codeBlockForCall || m_codeBlockForConstruct; }
+        // Entries into the generated code since the last resetExecuteCounters().
+        unsigned executeCount() const;
+        void resetExecuteCounters();
+#endif
         void visitChildren(SlotVisitor&);
         static FunctionExecutable* fromGlobalCode(const Identifier&, ExecState*, Debugger*, const SourceCode&, JSObject** exception);
         static Structure* createStructure(JSGlobalData& globalData, JSValue proto)
@@ -46,6 +46,12 @@ public:
     virtual void operator()() {}
     virtual void synchronize() {}
 
+    // Lets the embedder hold back collections scheduled by the callback while it is doing
+    // latency sensitive work, such as running an animation.
+    virtual void setDeferred(bool) {}
+    // Hints that the user is idle, so a collection that is due need not wait any longer.
+    virtual void didBecomeIdle() {}
+
 protected:
     GCActivityCallback() {}
 };
@@ -61,6 +67,10 @@ public:
 
     void operator()();
     void synchronize();
+#if PLATFORM(QT)
+    void setDeferred(bool);
+    void didBecomeIdle();
+#endif
 
 #if USE(CF)
 protected:
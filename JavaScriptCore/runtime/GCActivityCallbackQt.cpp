@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1.  Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer. 
+ * 2.  Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution. 
+ * 3.  Neither the name of Apple Computer, Inc. ("Apple") nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission. 
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE AND ITS CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL APPLE OR ITS CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "GCActivityCallback.h"
+
+#include "APIShims.h"
+#include "Heap.h"
+#include "JSGlobalData.h"
+#include "JSLock.h"
+#include "JSObject.h"
+#include "ScopeChain.h"
+#include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QBasicTimer>
+#include <QtCore/QObject>
+#include <QtCore/QTimerEvent>
+
+#if !PLATFORM(QT)
+#error "This file should only be used on Qt platforms."
+#endif
+
+namespace JSC {
+
+// How long the heap must have been left alone after a collection before we start
+// looking for an idle moment to collect again.
+static const int triggerInterval = 2000; // milliseconds
+
+struct DefaultGCActivityCallbackPlatformData : public QObject {
+    DefaultGCActivityCallbackPlatformData(Heap*);
+
+    void scheduleCollectionWhenIdle();
+    void collect();
+
+    virtual void timerEvent(QTimerEvent*);
+
+    Heap* heap;
+    QBasicTimer triggerTimer;
+    QBasicTimer idleTimer;
+    bool collectionIsDue;
+    bool deferred;
+};
+
+DefaultGCActivityCallbackPlatformData::DefaultGCActivityCallbackPlatformData(Heap* heap)
+    : heap(heap)
+    , collectionIsDue(false)
+    , deferred(false)
+{
+}
+
+void DefaultGCActivityCallbackPlatformData::scheduleCollectionWhenIdle()
+{
+    collectionIsDue = true;
+    // A zero timeout only fires once the event loop has run out of pending events.
+    if (!deferred)
+        idleTimer.start(0, this);
+}
+
+void DefaultGCActivityCallbackPlatformData::collect()
+{
+    collectionIsDue = false;
+    if (!heap->globalData())
+        return;
+
+    APIEntryShim shim(heap->globalData());
+    heap->collectAllGarbage();
+    // Collecting rearms the trigger, but nothing new has been allocated since.
+    triggerTimer.stop();
+}
+
+void DefaultGCActivityCallbackPlatformData::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() == triggerTimer.timerId()) {
+        triggerTimer.stop();
+        scheduleCollectionWhenIdle();
+        return;
+    }
+
+    if (event->timerId() == idleTimer.timerId()) {
+        idleTimer.stop();
+        if (collectionIsDue && !deferred)
+            collect();
+        return;
+    }
+
+    QObject::timerEvent(event);
+}
+
+DefaultGCActivityCallback::DefaultGCActivityCallback(Heap* heap)
+{
+    // The timers can only fire on a thread that runs a Qt event loop. Heaps created elsewhere,
+    // such as those of web workers, keep relying on allocation-triggered collections.
+    if (QAbstractEventDispatcher::instance())
+        d = adoptPtr(new DefaultGCActivityCallbackPlatformData(heap));
+}
+
+DefaultGCActivityCallback::~DefaultGCActivityCallback()
+{
+}
+
+void DefaultGCActivityCallback::operator()()
+{
+    if (!d)
+        return;
+    d->triggerTimer.start(triggerInterval, d.get());
+}
+
+void DefaultGCActivityCallback::synchronize()
+{
+    // Unlike a CFRunLoopTimer, a QObject can only be handed to another thread by the thread
+    // that owns it, so the timers stay with the thread that created the heap.
+}
+
+void DefaultGCActivityCallback::setDeferred(bool deferred)
+{
+    if (!d)
+        return;
+    d->deferred = deferred;
+    if (deferred)
+        d->idleTimer.stop();
+    else if (d->collectionIsDue)
+        d->idleTimer.start(0, d.get());
+}
+
+void DefaultGCActivityCallback::didBecomeIdle()
+{
+    // Only bother if there has been allocation activity the trigger has not caught up with yet.
+    if (!d || !d->triggerTimer.isActive())
+        return;
+    d->triggerTimer.stop();
+    d->scheduleCollectionWhenIdle();
+}
+
+}
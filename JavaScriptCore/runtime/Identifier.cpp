@@ -69,6 +69,9 @@ void deleteIdentifierTable(IdentifierTable* table)
 
 bool Identifier::equal(const StringImpl* r, const char* s)
 {
+    if (r->is8Bit())
+        return WTF::equal(r, s);
+
     int length = r->length();
     const UChar* d = r->characters();
     for (int i = 0; i != length; ++i)
@@ -81,6 +84,13 @@ bool Identifier::equal(const StringImpl* r, const UChar* s, unsigned length)
 {
     if (r->length() != length)
         return false;
+    if (r->is8Bit()) {
+        const LChar* d = r->characters8();
+        for (unsigned i = 0; i != length; ++i)
+            if (d[i] != s[i])
+                return false;
+        return true;
+    }
     const UChar* d = r->characters();
     for (unsigned i = 0; i != length; ++i)
         if (d[i] != s[i])
@@ -102,10 +112,9 @@ struct IdentifierCStringTranslator {
     static void translate(StringImpl*& location, const char* c, unsigned hash)
     {
         size_t length = strlen(c);
-        UChar* d;
+        LChar* d;
         StringImpl* r = StringImpl::createUninitialized(length, d).leakRef();
-        for (size_t i = 0; i != length; i++)
-            d[i] = static_cast<unsigned char>(c[i]); // use unsigned char to zero-extend instead of sign-extend
+        memcpy(d, c, length);
         r->setHash(hash);
         location = r;
     }
@@ -161,10 +170,7 @@ struct IdentifierUCharBufferTranslator {
 
     static void translate(StringImpl*& location, const UCharBuffer& buf, unsigned hash)
     {
-        UChar* d;
-        StringImpl* r = StringImpl::createUninitialized(buf.length, d).leakRef();
-        for (unsigned i = 0; i != buf.length; i++)
-            d[i] = buf.s[i];
+        StringImpl* r = StringImpl::create8BitIfPossible(buf.s, buf.length).leakRef();
         r->setHash(hash);
         location = r; 
     }
@@ -27,6 +27,7 @@
 #include "CachedCall.h"
 #include "Error.h"
 #include "Executable.h"
+#include "JSGlobalObject.h"
 #include "PropertyNameArray.h"
 #include <wtf/AVLTree.h>
 #include <wtf/Assertions.h>
@@ -113,6 +114,37 @@ static inline size_t storageSize(unsigned vectorLength)
     return size;
 }
 
+// Unboxed int32 elements are packed two to a JSValue sized slot.
+static inline unsigned unboxedVectorLength(ArrayStorageType storageType, unsigned capacity)
+{
+    ASSERT(storageType != GenericArrayStorage);
+    if (storageType == Int32ArrayStorage)
+        return capacity / 2 + (capacity & 1);
+    return capacity;
+}
+
+static inline unsigned unboxedCapacityForVectorLength(ArrayStorageType storageType, unsigned vectorLength)
+{
+    ASSERT(storageType != GenericArrayStorage);
+    if (storageType == Int32ArrayStorage)
+        return min(vectorLength * 2, MAX_STORAGE_VECTOR_LENGTH);
+    return vectorLength;
+}
+
+// Code generated by the JIT indexes m_vector directly, and would take its slow cases on every
+// access to an array with unboxed storage, so only the interpreter uses unboxed storage.
+static inline ArrayStorageType initialStorageType(JSGlobalData& globalData)
+{
+    return globalData.canUseJIT() ? GenericArrayStorage : Int32ArrayStorage;
+}
+
+static int compareDoublesForQSort(const void* a, const void* b)
+{
+    double da = *static_cast<const double*>(a);
+    double db = *static_cast<const double*>(b);
+    return (da > db) - (da < db);
+}
+
 static inline bool isDenseEnoughForVector(unsigned length, unsigned numValues)
 {
     return length / minDensityMultiplier <= numValues;
@@ -140,6 +172,7 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure)
 
     m_storage = static_cast<ArrayStorage*>(fastZeroedMalloc(storageSize(initialCapacity)));
     m_storage->m_allocBase = m_storage;
+    m_storage->m_storageType = initialStorageType(globalData);
     m_indexBias = 0;
     m_vectorLength = initialCapacity;
 
@@ -164,6 +197,8 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, unsigned initia
     m_storage->m_length = initialLength;
     m_indexBias = 0;
     m_vectorLength = initialCapacity;
+    m_storage->m_storageType = GenericArrayStorage;
+    m_storage->m_unboxedCapacity = 0;
     m_storage->m_sparseValueMap = 0;
     m_storage->subclassData = 0;
     m_storage->reportedMapCapacity = 0;
@@ -180,9 +215,16 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, unsigned initia
 #endif
         m_storage->m_length = initialLength;
         m_storage->m_numValuesInVector = 0;
-        WriteBarrier<Unknown>* vector = m_storage->m_vector;
-        for (size_t i = 0; i < initialCapacity; ++i)
-            vector[i].clear();
+        ArrayStorageType storageType = initialStorageType(globalData);
+        if (storageType != GenericArrayStorage) {
+            m_storage->m_storageType = storageType;
+            m_storage->m_unboxedCapacity = unboxedCapacityForVectorLength(storageType, initialCapacity);
+            m_vectorLength = 0;
+        } else {
+            WriteBarrier<Unknown>* vector = m_storage->m_vector;
+            for (size_t i = 0; i < initialCapacity; ++i)
+                vector[i].clear();
+        }
     }
 
     checkConsistency();
@@ -218,13 +260,37 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, const ArgList&
     m_storage->m_inCompactInitialization = false;
 #endif
 
-    size_t i = 0;
-    WriteBarrier<Unknown>* vector = m_storage->m_vector;
+    ArrayStorageType storageType = initialStorageType(globalData);
     ArgList::const_iterator end = list.end();
-    for (ArgList::const_iterator it = list.begin(); it != end; ++it, ++i)
-        vector[i].set(globalData, this, *it);
-    for (; i < initialStorage; i++)
-        vector[i].clear();
+    for (ArgList::const_iterator it = list.begin(); it != end && storageType != GenericArrayStorage; ++it) {
+        if (!it->isNumber())
+            storageType = GenericArrayStorage;
+        else if (!it->isInt32())
+            storageType = DoubleArrayStorage;
+    }
+    m_storage->m_storageType = storageType;
+
+    size_t i = 0;
+    if (storageType == Int32ArrayStorage) {
+        m_storage->m_unboxedCapacity = unboxedCapacityForVectorLength(storageType, initialStorage);
+        m_vectorLength = 0;
+        int32_t* vector = int32Vector();
+        for (ArgList::const_iterator it = list.begin(); it != end; ++it, ++i)
+            vector[i] = it->asInt32();
+    } else if (storageType == DoubleArrayStorage) {
+        m_storage->m_unboxedCapacity = unboxedCapacityForVectorLength(storageType, initialStorage);
+        m_vectorLength = 0;
+        double* vector = doubleVector();
+        for (ArgList::const_iterator it = list.begin(); it != end; ++it, ++i)
+            vector[i] = it->uncheckedGetNumber();
+    } else {
+        m_storage->m_unboxedCapacity = 0;
+        WriteBarrier<Unknown>* vector = m_storage->m_vector;
+        for (ArgList::const_iterator it = list.begin(); it != end; ++it, ++i)
+            vector[i].set(globalData, this, *it);
+        for (; i < initialStorage; i++)
+            vector[i].clear();
+    }
 
     checkConsistency();
 
@@ -256,6 +322,9 @@ bool JSArray::getOwnPropertySlot(ExecState* exec, unsigned i, PropertySlot& slot
             slot.setValue(value);
             return true;
         }
+    } else if (i < storage->m_numValuesInVector) {
+        slot.setValue(getUnboxedIndex(i));
+        return true;
     } else if (SparseArrayValueMap* map = storage->m_sparseValueMap) {
         if (i >= MIN_SPARSE_ARRAY_INDEX) {
             SparseArrayValueMap::iterator it = map->find(i);
@@ -304,6 +373,9 @@ bool JSArray::getOwnPropertyDescriptor(ExecState* exec, const Identifier& proper
                 descriptor.setDescriptor(value.get(), 0);
                 return true;
             }
+        } else if (i < storage->m_numValuesInVector) {
+            descriptor.setDescriptor(getUnboxedIndex(i), 0);
+            return true;
         } else if (SparseArrayValueMap* map = storage->m_sparseValueMap) {
             if (i >= MIN_SPARSE_ARRAY_INDEX) {
                 SparseArrayValueMap::iterator it = map->find(i);
@@ -346,6 +418,15 @@ void JSArray::put(ExecState* exec, unsigned i, JSValue value)
 
     ArrayStorage* storage = m_storage;
 
+    if (storage->m_storageType != GenericArrayStorage) {
+        if (putUnboxed(i, value)) {
+            checkConsistency();
+            return;
+        }
+        convertToGenericStorage();
+        storage = m_storage;
+    }
+
     unsigned length = storage->m_length;
     if (i >= length && i <= MAX_ARRAY_INDEX) {
         length = i + 1;
@@ -368,6 +449,133 @@ void JSArray::put(ExecState* exec, unsigned i, JSValue value)
     putSlowCase(exec, i, value);
 }
 
+bool JSArray::putUnboxed(unsigned i, JSValue value)
+{
+    if (trySetUnboxedIndex(i, value))
+        return true;
+
+    // Anything other than a number, or a store that would leave a hole, needs generic storage.
+    ArrayStorage* storage = m_storage;
+    if (i > storage->m_numValuesInVector || !value.isNumber())
+        return false;
+
+    if (storage->m_storageType == Int32ArrayStorage && !value.isInt32())
+        convertToDoubleStorage();
+
+    storage = m_storage;
+    if (i >= storage->m_unboxedCapacity && !increaseUnboxedCapacity(i + 1))
+        return false;
+
+    bool stored = trySetUnboxedIndex(i, value);
+    ASSERT_UNUSED(stored, stored);
+    return true;
+}
+
+bool JSArray::increaseUnboxedCapacity(unsigned newLength)
+{
+    ArrayStorage* storage = m_storage;
+    ArrayStorageType storageType = static_cast<ArrayStorageType>(storage->m_storageType);
+
+    unsigned capacity = storage->m_unboxedCapacity;
+    ASSERT(storageType != GenericArrayStorage);
+    ASSERT(!m_indexBias);
+    ASSERT(newLength > capacity);
+    if (newLength > MAX_STORAGE_VECTOR_LENGTH)
+        return false;
+
+    // Same growth policy as getNewVectorLength(), counted in elements rather than JSValue slots.
+    unsigned newCapacity;
+    unsigned maxInitLength = min(storage->m_length, 100000U);
+    if (newLength < maxInitLength)
+        newCapacity = maxInitLength;
+    else if (!capacity)
+        newCapacity = max(newLength, FIRST_VECTOR_GROW);
+    else
+        newCapacity = newLength + (newLength >> 1) + (newLength & 1);
+    newCapacity = min(newCapacity, MAX_STORAGE_VECTOR_LENGTH);
+
+    unsigned vectorLength = unboxedVectorLength(storageType, capacity);
+    unsigned newVectorLength = unboxedVectorLength(storageType, newCapacity);
+    void* baseStorage = storage->m_allocBase;
+    if (!tryFastRealloc(baseStorage, storageSize(newVectorLength)).getValue(baseStorage))
+        return false;
+
+    m_storage = static_cast<ArrayStorage*>(baseStorage);
+    m_storage->m_allocBase = baseStorage;
+    m_storage->m_unboxedCapacity = newCapacity;
+
+    Heap::heap(this)->reportExtraMemoryCost(storageSize(newVectorLength) - storageSize(vectorLength));
+
+    return true;
+}
+
+void JSArray::convertToDoubleStorage()
+{
+    ArrayStorage* storage = m_storage;
+    ASSERT(storage->m_storageType == Int32ArrayStorage);
+    ASSERT(!m_indexBias);
+
+    unsigned capacity = storage->m_unboxedCapacity;
+    unsigned vectorLength = unboxedVectorLength(Int32ArrayStorage, capacity);
+    unsigned newVectorLength = unboxedVectorLength(DoubleArrayStorage, capacity);
+
+    ArrayStorage* newStorage = static_cast<ArrayStorage*>(fastMalloc(storageSize(newVectorLength)));
+    memcpy(newStorage, storage, storageSize(0));
+    newStorage->m_allocBase = newStorage;
+    newStorage->m_storageType = DoubleArrayStorage;
+
+    int32_t* from = int32Vector();
+    double* to = reinterpret_cast_ptr<double*>(newStorage->m_vector);
+    for (unsigned i = 0; i < storage->m_numValuesInVector; ++i)
+        to[i] = from[i];
+
+    m_storage = newStorage;
+    fastFree(storage);
+
+    Heap::heap(this)->reportExtraMemoryCost(storageSize(newVectorLength) - storageSize(vectorLength));
+}
+
+void JSArray::convertToGenericStorage()
+{
+    ArrayStorage* storage = m_storage;
+    ArrayStorageType storageType = static_cast<ArrayStorageType>(storage->m_storageType);
+    ASSERT(storageType != GenericArrayStorage);
+    ASSERT(!m_indexBias && !m_vectorLength && !storage->m_sparseValueMap);
+
+    unsigned numValuesInVector = storage->m_numValuesInVector;
+    unsigned vectorLength = unboxedVectorLength(storageType, storage->m_unboxedCapacity);
+
+    if (!numValuesInVector) {
+        // Nothing needs boxing, so the existing allocation will do.
+        WriteBarrier<Unknown>* vector = storage->m_vector;
+        for (unsigned i = 0; i < vectorLength; ++i)
+            vector[i].clear();
+        m_vectorLength = vectorLength;
+    } else {
+        unsigned newVectorLength = max(vectorLength, numValuesInVector);
+        ArrayStorage* newStorage = static_cast<ArrayStorage*>(fastMalloc(storageSize(newVectorLength)));
+        memcpy(newStorage, storage, storageSize(0));
+        newStorage->m_allocBase = newStorage;
+
+        // Numbers are never cells, so no write barrier is needed.
+        WriteBarrier<Unknown>* vector = newStorage->m_vector;
+        unsigned i = 0;
+        for (; i < numValuesInVector; ++i)
+            vector[i].setWithoutWriteBarrier(getUnboxedIndex(i));
+        for (; i < newVectorLength; ++i)
+            vector[i].clear();
+
+        m_storage = newStorage;
+        m_vectorLength = newVectorLength;
+        fastFree(storage);
+
+        Heap::heap(this)->reportExtraMemoryCost(storageSize(newVectorLength) - storageSize(vectorLength));
+    }
+
+    m_storage->m_storageType = GenericArrayStorage;
+    m_storage->m_unboxedCapacity = 0;
+}
+
 NEVER_INLINE void JSArray::putSlowCase(ExecState* exec, unsigned i, JSValue value)
 {
     ArrayStorage* storage = m_storage;
@@ -496,6 +704,17 @@ bool JSArray::deleteProperty(ExecState* exec, unsigned i)
     checkConsistency();
 
     ArrayStorage* storage = m_storage;
+
+    if (storage->m_storageType != GenericArrayStorage && i < storage->m_numValuesInVector) {
+        // Unboxed storage can represent a hole at the end, but not anywhere else.
+        if (i + 1 == storage->m_numValuesInVector) {
+            --storage->m_numValuesInVector;
+            checkConsistency();
+            return true;
+        }
+        convertToGenericStorage();
+        storage = m_storage;
+    }
     
     if (i < m_vectorLength) {
         WriteBarrier<Unknown>& valueSlot = storage->m_vector[i];
@@ -535,6 +754,11 @@ void JSArray::getOwnPropertyNames(ExecState* exec, PropertyNameArray& propertyNa
     // which almost certainly means a different structure for PropertyNameArray.
 
     ArrayStorage* storage = m_storage;
+
+    if (storage->m_storageType != GenericArrayStorage) {
+        for (unsigned i = 0; i < storage->m_numValuesInVector; ++i)
+            propertyNames.add(Identifier::from(exec, i));
+    }
     
     unsigned usedVectorLength = min(storage->m_length, m_vectorLength);
     for (unsigned i = 0; i < usedVectorLength; ++i) {
@@ -659,6 +883,9 @@ void JSArray::setLength(unsigned newLength)
     unsigned length = storage->m_length;
 
     if (newLength < length) {
+        if (storage->m_storageType != GenericArrayStorage)
+            storage->m_numValuesInVector = min(storage->m_numValuesInVector, newLength);
+
         unsigned usedVectorLength = min(length, m_vectorLength);
         for (unsigned i = newLength; i < usedVectorLength; ++i) {
             WriteBarrier<Unknown>& valueSlot = storage->m_vector[i];
@@ -708,6 +935,9 @@ JSValue JSArray::pop()
             valueSlot.clear();
         } else
             result = jsUndefined();
+    } else if (length < storage->m_numValuesInVector) {
+        result = getUnboxedIndex(length);
+        --storage->m_numValuesInVector;
     } else {
         result = jsUndefined();
         if (SparseArrayValueMap* map = storage->m_sparseValueMap) {
@@ -742,6 +972,15 @@ void JSArray::push(ExecState* exec, JSValue value)
         return;
     }
 
+    if (storage->m_storageType != GenericArrayStorage) {
+        if (putUnboxed(storage->m_length, value)) {
+            checkConsistency();
+            return;
+        }
+        convertToGenericStorage();
+        storage = m_storage;
+    }
+
     if (storage->m_length < m_vectorLength) {
         storage->m_vector[storage->m_length].set(exec->globalData(), this, value);
         ++storage->m_numValuesInVector;
@@ -773,6 +1012,9 @@ void JSArray::push(ExecState* exec, JSValue value)
 void JSArray::shiftCount(ExecState* exec, int count)
 {
     ASSERT(count > 0);
+
+    if (m_storage->m_storageType != GenericArrayStorage)
+        convertToGenericStorage();
     
     ArrayStorage* storage = m_storage;
     
@@ -823,6 +1065,9 @@ void JSArray::shiftCount(ExecState* exec, int count)
     
 void JSArray::unshiftCount(ExecState* exec, int count)
 {
+    if (m_storage->m_storageType != GenericArrayStorage)
+        convertToGenericStorage();
+
     ArrayStorage* storage = m_storage;
 
     ASSERT(m_indexBias >= 0);
@@ -863,6 +1108,104 @@ void JSArray::unshiftCount(ExecState* exec, int count)
         vector[i].clear();
 }
 
+JSArray* JSArray::fastSlice(ExecState* exec, unsigned startIndex, unsigned count)
+{
+    if (!isDense() || startIndex > m_storage->m_length || count > m_storage->m_length - startIndex)
+        return 0;
+
+    JSGlobalData& globalData = exec->globalData();
+    JSArray* result = new (exec) JSArray(globalData, exec->lexicalGlobalObject()->arrayStructure(), count, CreateCompact);
+
+    ArrayStorage* storage = m_storage;
+    ArrayStorageType storageType = static_cast<ArrayStorageType>(storage->m_storageType);
+    if (storageType == GenericArrayStorage) {
+        WriteBarrier<Unknown>* vector = storage->m_vector + startIndex;
+        for (unsigned i = 0; i < count; ++i)
+            result->uncheckedSetIndex(globalData, i, vector[i].get());
+    } else {
+        // A compact vector has room for count unboxed elements of either type.
+        ArrayStorage* resultStorage = result->m_storage;
+        if (storageType == Int32ArrayStorage)
+            memcpy(resultStorage->m_vector, int32Vector() + startIndex, count * sizeof(int32_t));
+        else
+            memcpy(resultStorage->m_vector, doubleVector() + startIndex, count * sizeof(double));
+        resultStorage->m_storageType = storageType;
+        resultStorage->m_unboxedCapacity = unboxedCapacityForVectorLength(storageType, count);
+        result->m_vectorLength = 0;
+    }
+    result->setLength(count);
+
+    return result;
+}
+
+bool JSArray::fastSplice(ExecState* exec, unsigned startIndex, unsigned deleteCount, const JSValue* items, unsigned itemCount)
+{
+    ArrayStorage* storage = m_storage;
+
+    unsigned length = storage->m_length;
+    if (!isDense() || startIndex > length || deleteCount > length - startIndex)
+        return false;
+    if (itemCount > deleteCount && itemCount - deleteCount > MAX_STORAGE_VECTOR_INDEX - length)
+        return false;
+
+    // shiftCount() and unshiftCount() can move the start of a generic vector instead of moving its elements.
+    if (!startIndex && deleteCount != itemCount && storage->m_storageType == GenericArrayStorage)
+        return false;
+
+    for (unsigned i = 0; i < itemCount && m_storage->m_storageType != GenericArrayStorage; ++i) {
+        if (!items[i].isNumber())
+            convertToGenericStorage();
+        else if (!items[i].isInt32() && m_storage->m_storageType == Int32ArrayStorage)
+            convertToDoubleStorage();
+    }
+
+    unsigned newLength = length - deleteCount + itemCount;
+    unsigned tailIndex = startIndex + deleteCount;
+    unsigned newTailIndex = startIndex + itemCount;
+
+    storage = m_storage;
+    if (storage->m_storageType == GenericArrayStorage) {
+        if (newLength > m_vectorLength) {
+            if (!increaseVectorLength(newLength))
+                return false;
+            storage = m_storage;
+        }
+
+        WriteBarrier<Unknown>* vector = storage->m_vector;
+        memmove(vector + newTailIndex, vector + tailIndex, (length - tailIndex) * sizeof(JSValue));
+        JSGlobalData& globalData = exec->globalData();
+        for (unsigned i = 0; i < itemCount; ++i)
+            vector[startIndex + i].set(globalData, this, items[i]);
+        for (unsigned i = newLength; i < length; ++i)
+            vector[i].clear();
+    } else {
+        if (newLength > storage->m_unboxedCapacity) {
+            if (!increaseUnboxedCapacity(newLength))
+                return false;
+            storage = m_storage;
+        }
+
+        if (storage->m_storageType == Int32ArrayStorage) {
+            int32_t* vector = int32Vector();
+            memmove(vector + newTailIndex, vector + tailIndex, (length - tailIndex) * sizeof(int32_t));
+            for (unsigned i = 0; i < itemCount; ++i)
+                vector[startIndex + i] = items[i].asInt32();
+        } else {
+            double* vector = doubleVector();
+            memmove(vector + newTailIndex, vector + tailIndex, (length - tailIndex) * sizeof(double));
+            for (unsigned i = 0; i < itemCount; ++i)
+                vector[startIndex + i] = items[i].uncheckedGetNumber();
+        }
+    }
+
+    storage->m_numValuesInVector = newLength;
+    storage->m_length = newLength;
+
+    checkConsistency();
+
+    return true;
+}
+
 void JSArray::visitChildren(SlotVisitor& visitor)
 {
     visitChildrenDirect(visitor);
@@ -886,6 +1229,18 @@ void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType cal
 {
     ArrayStorage* storage = m_storage;
 
+    // Unboxed storage is already compact, with any holes at the end.
+    if (storage->m_storageType == Int32ArrayStorage) {
+        std::sort(int32Vector(), int32Vector() + storage->m_numValuesInVector);
+        checkConsistency(SortConsistencyCheck);
+        return;
+    }
+    if (storage->m_storageType == DoubleArrayStorage) {
+        qsort(doubleVector(), storage->m_numValuesInVector, sizeof(double), compareDoublesForQSort);
+        checkConsistency(SortConsistencyCheck);
+        return;
+    }
+
     unsigned lengthNotIncludingUndefined = compactForSorting();
     if (storage->m_sparseValueMap) {
         throwOutOfMemoryError(exec);
@@ -917,6 +1272,9 @@ void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType cal
 
 void JSArray::sort(ExecState* exec)
 {
+    if (m_storage->m_storageType != GenericArrayStorage)
+        convertToGenericStorage();
+
     ArrayStorage* storage = m_storage;
 
     unsigned lengthNotIncludingUndefined = compactForSorting();
@@ -1067,6 +1425,9 @@ void JSArray::sort(ExecState* exec, JSValue compareFunction, CallType callType,
 {
     checkConsistency();
 
+    if (m_storage->m_storageType != GenericArrayStorage)
+        convertToGenericStorage();
+
     ArrayStorage* storage = m_storage;
 
     // FIXME: This ignores exceptions raised in the compare function or in toNumber.
@@ -1182,9 +1543,14 @@ void JSArray::fillArgList(ExecState* exec, MarkedArgumentBuffer& args)
 {
     ArrayStorage* storage = m_storage;
 
+    unsigned i = 0;
+    if (storage->m_storageType != GenericArrayStorage) {
+        for (; i < storage->m_numValuesInVector; ++i)
+            args.append(getUnboxedIndex(i));
+    }
+
     WriteBarrier<Unknown>* vector = storage->m_vector;
     unsigned vectorEnd = min(storage->m_length, m_vectorLength);
-    unsigned i = 0;
     for (; i < vectorEnd; ++i) {
         WriteBarrier<Unknown>& v = vector[i];
         if (!v)
@@ -1200,9 +1566,15 @@ void JSArray::copyToRegisters(ExecState* exec, Register* buffer, uint32_t maxSiz
 {
     ASSERT(m_storage->m_length >= maxSize);
     UNUSED_PARAM(maxSize);
+    unsigned i = 0;
+    if (m_storage->m_storageType != GenericArrayStorage) {
+        unsigned unboxedEnd = min(maxSize, m_storage->m_numValuesInVector);
+        for (; i < unboxedEnd; ++i)
+            buffer[i] = getUnboxedIndex(i);
+    }
+
     WriteBarrier<Unknown>* vector = m_storage->m_vector;
     unsigned vectorEnd = min(maxSize, m_vectorLength);
-    unsigned i = 0;
     for (; i < vectorEnd; ++i) {
         WriteBarrier<Unknown>& v = vector[i];
         if (!v)
@@ -1294,6 +1666,15 @@ void JSArray::checkConsistency(ConsistencyCheckType type)
     if (type == SortConsistencyCheck)
         ASSERT(!storage->m_sparseValueMap);
 
+    if (storage->m_storageType != GenericArrayStorage) {
+        ASSERT(!m_vectorLength);
+        ASSERT(!m_indexBias);
+        ASSERT(!storage->m_sparseValueMap);
+        ASSERT(storage->m_numValuesInVector <= storage->m_unboxedCapacity);
+        ASSERT(storage->m_numValuesInVector <= storage->m_length);
+        return;
+    }
+
     unsigned numValuesInVector = 0;
     for (unsigned i = 0; i < m_vectorLength; ++i) {
         if (JSValue value = storage->m_vector[i]) {
@@ -29,6 +29,13 @@ namespace JSC {
 
     typedef HashMap<unsigned, WriteBarrier<Unknown> > SparseArrayValueMap;
 
+    // Dense arrays of numbers keep their elements unboxed until the first store that the
+    // storage type cannot represent, at which point the array switches to generic storage
+    // for good.  An array with unboxed storage has no holes below m_numValuesInVector and
+    // nothing at or above it, no sparse map and no index bias, and its m_vectorLength is
+    // zero so that anything that indexes m_vector directly sees no elements at all.
+    enum ArrayStorageType { GenericArrayStorage, Int32ArrayStorage, DoubleArrayStorage };
+
     // This struct holds the actual data values of an array.  A JSArray object points to it's contained ArrayStorage
     // struct by pointing to m_vector.  To access the contained ArrayStorage struct, use the getStorage() and 
     // setStorage() methods.  It is important to note that there may be space before the ArrayStorage that 
@@ -37,6 +44,8 @@ namespace JSC {
     struct ArrayStorage {
         unsigned m_length; // The "length" property on the array
         unsigned m_numValuesInVector;
+        unsigned m_storageType; // An ArrayStorageType.
+        unsigned m_unboxedCapacity; // The number of unboxed elements that fit in m_vector.
         SparseArrayValueMap* m_sparseValueMap;
         void* subclassData; // A JSArray subclass can use this to fill the vector lazily.
         void* m_allocBase; // Pointer to base address returned by malloc().  Keeping this pointer does eliminate false positives from the leak detector.
@@ -88,11 +97,28 @@ namespace JSC {
         void shiftCount(ExecState*, int count);
         void unshiftCount(ExecState*, int count);
 
-        bool canGetIndex(unsigned i) { return i < m_vectorLength && m_storage->m_vector[i]; }
+        // True if every index below length() holds a value of the array's own, so reading
+        // any of them never reaches the prototype chain.
+        bool isDense() const { return m_storage->m_numValuesInVector == m_storage->m_length; }
+
+        // Fast paths for Array.prototype functions on dense arrays.  They return 0 or false,
+        // having changed nothing observable, when the array is not dense over the range.
+        JSArray* fastSlice(ExecState*, unsigned startIndex, unsigned count);
+        bool fastSplice(ExecState*, unsigned startIndex, unsigned deleteCount, const JSValue* items, unsigned itemCount);
+
+        bool canGetIndex(unsigned i)
+        {
+            if (i < m_vectorLength)
+                return m_storage->m_vector[i];
+            // Only arrays with unboxed storage have values past the end of the vector.
+            return i < m_storage->m_numValuesInVector;
+        }
         JSValue getIndex(unsigned i)
         {
             ASSERT(canGetIndex(i));
-            return m_storage->m_vector[i].get();
+            if (LIKELY(i < m_vectorLength))
+                return m_storage->m_vector[i].get();
+            return getUnboxedIndex(i);
         }
 
         bool canSetIndex(unsigned i) { return i < m_vectorLength; }
@@ -109,6 +135,34 @@ namespace JSC {
             }
             x.set(globalData, this, v);
         }
+
+        // Stores to an array with unboxed storage if that needs neither a change of storage
+        // type nor a larger vector.
+        bool trySetUnboxedIndex(unsigned i, JSValue v)
+        {
+            ArrayStorage* storage = m_storage;
+            unsigned numValuesInVector = storage->m_numValuesInVector;
+            if (i >= numValuesInVector && (i > numValuesInVector || i >= storage->m_unboxedCapacity))
+                return false;
+
+            if (storage->m_storageType == Int32ArrayStorage) {
+                if (!v.isInt32())
+                    return false;
+                int32Vector()[i] = v.asInt32();
+            } else if (storage->m_storageType == DoubleArrayStorage) {
+                if (!v.isNumber())
+                    return false;
+                doubleVector()[i] = v.uncheckedGetNumber();
+            } else
+                return false;
+
+            if (i == numValuesInVector) {
+                storage->m_numValuesInVector = i + 1;
+                if (i >= storage->m_length)
+                    storage->m_length = i + 1;
+            }
+            return true;
+        }
         
         void uncheckedSetIndex(JSGlobalData& globalData, unsigned i, JSValue v)
         {
@@ -152,6 +206,21 @@ namespace JSC {
         void setSubclassData(void*);
 
     private:
+        int32_t* int32Vector() { return reinterpret_cast_ptr<int32_t*>(m_storage->m_vector); }
+        double* doubleVector() { return reinterpret_cast_ptr<double*>(m_storage->m_vector); }
+        JSValue getUnboxedIndex(unsigned i)
+        {
+            ASSERT(m_storage->m_storageType != GenericArrayStorage && i < m_storage->m_numValuesInVector);
+            if (m_storage->m_storageType == Int32ArrayStorage)
+                return jsNumber(int32Vector()[i]);
+            return jsNumber(doubleVector()[i]);
+        }
+
+        bool putUnboxed(unsigned propertyName, JSValue);
+        bool increaseUnboxedCapacity(unsigned newLength);
+        void convertToDoubleStorage();
+        void convertToGenericStorage();
+
         bool getOwnPropertySlotSlowCase(ExecState*, unsigned propertyName, PropertySlot&);
         void putSlowCase(ExecState*, unsigned propertyName, JSValue);
 
@@ -52,7 +52,11 @@
 #include "Nodes.h"
 #include "Parser.h"
 #include "RegExpCache.h"
+#include "SamplingProfiler.h"
 #include "StrictEvalActivation.h"
+#include <errno.h>
+#include <limits>
+#include <wtf/ASCIICType.h>
 #include <wtf/WTFThreadData.h>
 #if ENABLE(REGEXP_TRACING)
 #include "RegExp.h"
@@ -89,6 +93,74 @@ inline void Recompiler::operator()(JSCell* cell)
     function->jsExecutable()->discardCode();
 }
 
+#if ENABLE(JIT)
+class ExecuteCountAverager {
+public:
+    ExecuteCountAverager()
+        : m_total(0)
+        , m_count(0)
+    {
+    }
+
+    void operator()(JSCell*);
+    unsigned average() const { return m_count ? m_total / m_count : 0; }
+
+private:
+    uint64_t m_total;
+    unsigned m_count;
+};
+
+inline void ExecuteCountAverager::operator()(JSCell* cell)
+{
+    if (!cell->inherits(&JSFunction::s_info))
+        return;
+    JSFunction* function = asFunction(cell);
+    if (function->executable()->isHostFunction() || !function->jsExecutable()->hasCode())
+        return;
+    m_total += function->jsExecutable()->executeCount();
+    ++m_count;
+}
+
+class ColdCodeDiscarder {
+public:
+    ColdCodeDiscarder(unsigned threshold)
+        : m_threshold(threshold)
+    {
+    }
+
+    void operator()(JSCell*);
+
+private:
+    unsigned m_threshold;
+};
+
+inline void ColdCodeDiscarder::operator()(JSCell* cell)
+{
+    if (!cell->inherits(&JSFunction::s_info))
+        return;
+    JSFunction* function = asFunction(cell);
+    if (function->executable()->isHostFunction())
+        return;
+    if (function->jsExecutable()->executeCount() < m_threshold)
+        function->jsExecutable()->discardCode();
+}
+
+class ExecuteCounterResetter {
+public:
+    void operator()(JSCell*);
+};
+
+inline void ExecuteCounterResetter::operator()(JSCell* cell)
+{
+    if (!cell->inherits(&JSFunction::s_info))
+        return;
+    JSFunction* function = asFunction(cell);
+    if (function->executable()->isHostFunction())
+        return;
+    function->jsExecutable()->resetExecuteCounters();
+}
+#endif
+
 } // namespace
 
 namespace JSC {
@@ -144,7 +216,7 @@ void JSGlobalData::storeVPtrs()
     JSGlobalData::jsFunctionVPtr = jsFunction->vptr();
 }
 
-JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType threadStackType)
+JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType threadStackType, size_t registerFileCapacity)
     : globalDataType(globalDataType)
     , clientData(0)
     , arrayTable(fastNew<HashTable>(JSC::arrayTable))
@@ -162,6 +234,7 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
     , lexer(new Lexer(this))
     , parser(new Parser)
     , interpreter(0)
+    , terminator(timeoutChecker)
     , heap(this)
     , globalObjectCount(0)
     , dynamicGlobalObject(0)
@@ -175,7 +248,7 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
     , exclusiveThread(0)
 #endif
 {
-    interpreter = new Interpreter(*this);
+    interpreter = new Interpreter(*this, registerFileCapacity);
     if (globalDataType == Default)
         m_stack = wtfThreadData().stack();
 
@@ -200,7 +273,6 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
     evalExecutableStructure.set(*this, EvalExecutable::createStructure(*this, jsNull()));
     programExecutableStructure.set(*this, ProgramExecutable::createStructure(*this, jsNull()));
     functionExecutableStructure.set(*this, FunctionExecutable::createStructure(*this, jsNull()));
-    dummyMarkableCellStructure.set(*this, JSCell::createDummyStructure(*this));
     structureChainStructure.set(*this, StructureChain::createStructure(*this, jsNull()));
 
 #if ENABLE(JSC_ZOMBIES)
@@ -232,6 +304,17 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
 #endif
 #endif
 #if ENABLE(JIT)
+#if OS(UNIX)
+    // The executable memory budget is given in kilobytes. Values that are not a plain
+    // positive number, or that overflow, are ignored.
+    if (char* budgetString = getenv("JavaScriptCoreJITMemoryBudget")) {
+        char* end;
+        errno = 0;
+        unsigned long budget = strtoul(budgetString, &end, 10);
+        if (isASCIIDigit(*budgetString) && !*end && !errno && budget && budget <= std::numeric_limits<size_t>::max() / 1024)
+            ExecutableAllocator::setMemoryBudget(static_cast<size_t>(budget) * 1024);
+    }
+#endif
 #if ENABLE(INTERPRETER)
     if (m_canUseJIT)
         m_canUseJIT = executableAllocator.isValid();
@@ -260,7 +343,6 @@ void JSGlobalData::clearBuiltinStructures()
     evalExecutableStructure.clear();
     programExecutableStructure.clear();
     functionExecutableStructure.clear();
-    dummyMarkableCellStructure.clear();
     structureChainStructure.clear();
     
 #if ENABLE(JSC_ZOMBIES)
@@ -318,12 +400,17 @@ JSGlobalData::~JSGlobalData()
 
 PassRefPtr<JSGlobalData> JSGlobalData::createContextGroup(ThreadStackType type)
 {
-    return adoptRef(new JSGlobalData(APIContextGroup, type));
+    return adoptRef(new JSGlobalData(APIContextGroup, type, RegisterFile::defaultCapacity));
 }
 
 PassRefPtr<JSGlobalData> JSGlobalData::create(ThreadStackType type)
 {
-    return adoptRef(new JSGlobalData(Default, type));
+    return create(type, RegisterFile::defaultCapacity);
+}
+
+PassRefPtr<JSGlobalData> JSGlobalData::create(ThreadStackType type, size_t registerFileCapacity)
+{
+    return adoptRef(new JSGlobalData(Default, type, registerFileCapacity));
 }
 
 PassRefPtr<JSGlobalData> JSGlobalData::createLeaked(ThreadStackType type)
@@ -340,7 +427,7 @@ JSGlobalData& JSGlobalData::sharedInstance()
 {
     JSGlobalData*& instance = sharedInstanceInternal();
     if (!instance) {
-        instance = adoptRef(new JSGlobalData(APIShared, ThreadStackTypeSmall)).leakRef();
+        instance = adoptRef(new JSGlobalData(APIShared, ThreadStackTypeSmall, RegisterFile::defaultCapacity)).leakRef();
 #if ENABLE(JSC_MULTIPLE_THREADS)
         instance->makeUsableFromMultipleThreads();
 #endif
@@ -409,6 +496,30 @@ void JSGlobalData::recompileAllJSFunctions()
     heap.forEach(recompiler);
 }
 
+void JSGlobalData::releaseExecutableMemory()
+{
+    // As in recompileAllJSFunctions(), code that is live on the stack must not be thrown away.
+    ASSERT(!dynamicGlobalObject);
+
+#if ENABLE(JIT)
+    // Start with the functions that have been entered less often than average
+    // since the last pass, so the code a page keeps running stays compiled.
+    // Several JSFunctions can share one executable, so counters are only
+    // reset once every function has been looked at.
+    ExecuteCountAverager averager;
+    heap.forEach(averager);
+    ColdCodeDiscarder discarder(averager.average());
+    heap.forEach(discarder);
+    ExecuteCounterResetter resetter;
+    heap.forEach(resetter);
+
+    if (!ExecutableAllocator::underMemoryPressure())
+        return;
+#endif
+
+    recompileAllJSFunctions();
+}
+
 #if ENABLE(REGEXP_TRACING)
 void JSGlobalData::addRegExpToTrace(PassRefPtr<RegExp> regExp)
 {
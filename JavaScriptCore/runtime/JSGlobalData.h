@@ -67,6 +67,7 @@ namespace JSC {
     class NativeExecutable;
     class Parser;
     class RegExpCache;
+    class SamplingProfiler;
     class Stringifier;
     class Structure;
     class UString;
@@ -124,6 +125,8 @@ namespace JSC {
         static JSGlobalData& sharedInstance();
 
         static PassRefPtr<JSGlobalData> create(ThreadStackType);
+        // Reserves room for registerFileCapacity registers of JavaScript stack instead of the default.
+        static PassRefPtr<JSGlobalData> create(ThreadStackType, size_t registerFileCapacity);
         static PassRefPtr<JSGlobalData> createLeaked(ThreadStackType);
         static PassRefPtr<JSGlobalData> createContextGroup(ThreadStackType);
         ~JSGlobalData();
@@ -164,7 +167,6 @@ namespace JSC {
         Strong<Structure> evalExecutableStructure;
         Strong<Structure> programExecutableStructure;
         Strong<Structure> functionExecutableStructure;
-        Strong<Structure> dummyMarkableCellStructure;
         Strong<Structure> structureChainStructure;
 
 #if ENABLE(JSC_ZOMBIES)
@@ -219,6 +221,7 @@ namespace JSC {
 
         TimeoutChecker timeoutChecker;
         Terminator terminator;
+        OwnPtr<SamplingProfiler> samplingProfiler;
         Heap heap;
 
         JSValue exception;
@@ -261,6 +264,7 @@ namespace JSC {
         void stopSampling();
         void dumpSampleData(ExecState* exec);
         void recompileAllJSFunctions();
+        void releaseExecutableMemory();
         RegExpCache* regExpCache() { return m_regExpCache; }
 #if ENABLE(REGEXP_TRACING)
         void addRegExpToTrace(PassRefPtr<RegExp> regExp);
@@ -271,7 +275,7 @@ namespace JSC {
         void clearBuiltinStructures();
 
     private:
-        JSGlobalData(GlobalDataType, ThreadStackType);
+        JSGlobalData(GlobalDataType, ThreadStackType, size_t registerFileCapacity);
         static JSGlobalData*& sharedInstanceInternal();
         void createNativeThunk();
 #if ENABLE(JIT) && ENABLE(INTERPRETER)
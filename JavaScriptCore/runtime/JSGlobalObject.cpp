@@ -63,6 +63,7 @@
 #include "RegExpMatchesArray.h"
 #include "RegExpObject.h"
 #include "RegExpPrototype.h"
+#include "SamplingProfiler.h"
 #include "ScopeChainMark.h"
 #include "StringConstructor.h"
 #include "StringPrototype.h"
@@ -181,6 +182,7 @@ void JSGlobalObject::reset(JSValue prototype)
     m_functionPrototype->structure()->setPrototypeWithoutTransition(exec->globalData(), m_objectPrototype.get());
 
     m_emptyObjectStructure.set(exec->globalData(), this, m_objectPrototype->inheritorID(exec->globalData()));
+    m_emptyObjectStructure->stopSamplingStorageSize();
     m_nullPrototypeObjectStructure.set(exec->globalData(), this, createEmptyObjectStructure(exec->globalData(), jsNull()));
 
     m_callbackFunctionStructure.set(exec->globalData(), this, JSCallbackFunction::createStructure(exec->globalData(), m_functionPrototype.get()));
@@ -448,11 +450,14 @@ DynamicGlobalObjectScope::DynamicGlobalObjectScope(JSGlobalData& globalData, JSG
     if (!m_dynamicGlobalObjectSlot) {
 #if ENABLE(ASSEMBLER)
         if (ExecutableAllocator::underMemoryPressure())
-            globalData.recompileAllJSFunctions();
+            globalData.releaseExecutableMemory();
 #endif
 
         m_dynamicGlobalObjectSlot = dynamicGlobalObject;
 
+        if (globalData.samplingProfiler)
+            globalData.samplingProfiler->discardDueSample();
+
         // Reset the date cache between JS invocations to force the VM
         // to observe time zone changes.
         globalData.resetDateCache();
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "JSONObject.h"
 
+#include "ArrayPrototype.h"
 #include "BooleanObject.h"
 #include "Error.h"
 #include "ExceptionHelpers.h"
@@ -35,10 +36,13 @@
 #include "Local.h"
 #include "LocalScope.h"
 #include "Lookup.h"
+#include "ObjectPrototype.h"
 #include "PropertyNameArray.h"
+#include "Strong.h"
 #include "UStringBuilder.h"
 #include "UStringConcatenate.h"
 #include <wtf/MathExtras.h>
+#include <wtf/RefCounted.h>
 
 namespace JSC {
 
@@ -87,6 +91,22 @@ public:
     void visitAggregate(SlotVisitor&);
 
 private:
+    // The enumerable properties of a plain data structure, that is one holding no getters
+    // or setters, in enumeration order and with their names already quoted.
+    struct StructureProperties : RefCounted<StructureProperties> {
+        StructureProperties(JSGlobalData& globalData, Structure* structure)
+            : structure(globalData, structure)
+        {
+        }
+
+        Strong<Structure> structure;
+        Vector<Identifier> names;
+        Vector<size_t> offsets;
+        Vector<UString> quotedNames;
+        bool hasToJSON;
+    };
+    typedef HashMap<Structure*, RefPtr<StructureProperties> > StructurePropertiesMap;
+
     class Holder {
     public:
         Holder(JSGlobalData&, JSObject*);
@@ -102,11 +122,19 @@ private:
         unsigned m_index;
         unsigned m_size;
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        // Set instead of m_propertyNames when the object has a plain data structure.
+        Structure* m_structure;
+        const StructureProperties* m_structureProperties;
     };
 
     friend class Holder;
 
     static void appendQuotedString(UStringBuilder&, const UString&);
+    static void appendNumber(UStringBuilder&, JSValue);
+    static bool appendPrimitive(UStringBuilder&, ExecState*, JSValue);
+
+    const StructureProperties* structureProperties(JSObject*);
+    bool mayHaveToJSON(JSObject*);
 
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
 
@@ -129,10 +157,19 @@ private:
     Vector<Holder, 16> m_holderStack;
     UString m_repeatedGap;
     UString m_indent;
+
+    StructurePropertiesMap m_structureProperties;
+    // The structures of Object.prototype and Array.prototype when neither had a toJSON
+    // property, or 0 if they did, or could change without changing structure.
+    Structure* m_objectPrototypeStructure;
+    Structure* m_arrayPrototypeStructure;
 };
 
 // ------------------------------ helper functions --------------------------------
 
+// Bounds the space reserved for the result based on the size of its first element.
+static const uint64_t maxEstimatedLength = 16 * 1024 * 1024;
+
 static inline JSValue unwrapBoxedPrimitive(ExecState* exec, JSValue value)
 {
     if (!value.isObject())
@@ -210,6 +247,8 @@ Stringifier::Stringifier(ExecState* exec, const Local<Unknown>* replacer, const
     , m_arrayReplacerPropertyNames(exec)
     , m_replacerCallType(CallTypeNone)
     , m_gap(gap(exec, space->get()))
+    , m_objectPrototypeStructure(0)
+    , m_arrayPrototypeStructure(0)
 #else
 Stringifier::Stringifier(ExecState* exec, const Local<Unknown>& replacer, const Local<Unknown>& space)
     : m_exec(exec)
@@ -218,8 +257,18 @@ Stringifier::Stringifier(ExecState* exec, const Local<Unknown>& replacer, const
     , m_arrayReplacerPropertyNames(exec)
     , m_replacerCallType(CallTypeNone)
     , m_gap(gap(exec, space.get()))
+    , m_objectPrototypeStructure(0)
+    , m_arrayPrototypeStructure(0)
 #endif
 {
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+    const Identifier& toJSONName = exec->globalData().propertyNames->toJSON;
+    if (!globalObject->objectPrototype()->structure()->isDictionary() && !globalObject->objectPrototype()->hasProperty(exec, toJSONName)) {
+        m_objectPrototypeStructure = globalObject->objectPrototype()->structure();
+        if (!globalObject->arrayPrototype()->structure()->isDictionary() && !globalObject->arrayPrototype()->hasProperty(exec, toJSONName))
+            m_arrayPrototypeStructure = globalObject->arrayPrototype()->structure();
+    }
+
     if (!m_replacer.isObject())
         return;
 
@@ -277,6 +326,7 @@ Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
 #endif
 
     UStringBuilder result;
+    result.reserveCapacity(64);
 #if COMPILER(WINSCW)
     if (appendStringifiedValue(result, value->get(), object, emptyPropertyName) != StringifySucceeded)
 #else
@@ -344,10 +394,108 @@ void Stringifier::appendQuotedString(UStringBuilder& builder, const UString& val
     builder.append('"');
 }
 
+void Stringifier::appendNumber(UStringBuilder& builder, JSValue value)
+{
+    ASSERT(value.isNumber());
+    if (value.isInt32()) {
+        int32_t number = value.asInt32();
+        UChar buffer[11];
+        UChar* end = buffer + WTF_ARRAY_LENGTH(buffer);
+        UChar* p = end;
+        uint32_t magnitude = number < 0 ? -static_cast<uint32_t>(number) : number;
+        do {
+            *--p = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        if (number < 0)
+            *--p = '-';
+        builder.append(p, end - p);
+        return;
+    }
+
+    double number = value.asDouble();
+    if (!isfinite(number))
+        builder.append("null");
+    else
+        builder.append(UString::number(number));
+}
+
+// Appends a value that needs no toJSON call, replacer call or cycle check, as an element
+// of an array.  Returns false, having appended nothing, for any other kind of value.
+bool Stringifier::appendPrimitive(UStringBuilder& builder, ExecState* exec, JSValue value)
+{
+    if (value.isNumber())
+        appendNumber(builder, value);
+    else if (value.isString())
+        appendQuotedString(builder, asString(value)->value(exec));
+    else if (value.isBoolean())
+        builder.append(value.getBoolean() ? "true" : "false");
+    else if (value.isUndefinedOrNull())
+        builder.append("null");
+    else
+        return false;
+    return true;
+}
+
+const Stringifier::StructureProperties* Stringifier::structureProperties(JSObject* object)
+{
+    Structure* structure = object->structure();
+    if (object->classInfo() != &JSObject::s_info || structure->isDictionary() || structure->hasGetterSetterProperties())
+        return 0;
+
+    StructurePropertiesMap::iterator it = m_structureProperties.find(structure);
+    if (it != m_structureProperties.end())
+        return it->second.get();
+
+    JSGlobalData& globalData = m_exec->globalData();
+    RefPtr<StructureProperties> properties = adoptRef(new StructureProperties(globalData, structure));
+    PropertyNameArray propertyNames(m_exec);
+    structure->getPropertyNames(globalData, propertyNames, ExcludeDontEnumProperties);
+    const PropertyNameArrayData::PropertyNameVector& names = propertyNames.data()->propertyNameVector();
+    for (size_t i = 0; i < names.size(); ++i) {
+        unsigned attributes;
+        JSCell* specificValue;
+        size_t offset = structure->get(globalData, names[i], attributes, specificValue);
+        ASSERT(offset != notFound);
+        UStringBuilder quotedName;
+        appendQuotedString(quotedName, names[i].ustring());
+        properties->names.append(names[i]);
+        properties->offsets.append(offset);
+        properties->quotedNames.append(quotedName.toUString());
+    }
+    properties->hasToJSON = structure->get(globalData, globalData.propertyNames->toJSON) != notFound;
+
+    m_structureProperties.set(structure, properties);
+    return properties.get();
+}
+
+// Checking the structures of the object and its prototype is much cheaper than looking
+// toJSON up along the prototype chain, which would otherwise be done for every object.
+inline bool Stringifier::mayHaveToJSON(JSObject* object)
+{
+    JSGlobalObject* globalObject = m_exec->lexicalGlobalObject();
+    if (!m_objectPrototypeStructure || globalObject->objectPrototype()->structure() != m_objectPrototypeStructure)
+        return true;
+
+    if (object->prototype() == JSValue(globalObject->objectPrototype())) {
+        const StructureProperties* properties = structureProperties(object);
+        return !properties || properties->hasToJSON;
+    }
+
+    if (object->prototype() == JSValue(globalObject->arrayPrototype()) && isJSArray(&m_exec->globalData(), object)) {
+        if (!m_arrayPrototypeStructure || globalObject->arrayPrototype()->structure() != m_arrayPrototypeStructure)
+            return true;
+        Structure* structure = object->structure();
+        return structure->isDictionary() || structure->get(m_exec->globalData(), m_exec->globalData().propertyNames->toJSON) != notFound;
+    }
+
+    return true;
+}
+
 inline JSValue Stringifier::toJSON(JSValue value, const PropertyNameForFunctionCall& propertyName)
 {
     ASSERT(!m_exec->hadException());
-    if (!value.isObject() || !asObject(value)->hasProperty(m_exec, m_exec->globalData().propertyNames->toJSON))
+    if (!value.isObject() || !mayHaveToJSON(asObject(value)) || !asObject(value)->hasProperty(m_exec, m_exec->globalData().propertyNames->toJSON))
         return value;
 
     JSValue toJSONFunction = asObject(value)->get(m_exec, m_exec->globalData().propertyNames->toJSON);
@@ -408,12 +556,8 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(UStringBuilder&
         return StringifySucceeded;
     }
 
-    double numericValue;
-    if (value.getNumber(numericValue)) {
-        if (!isfinite(numericValue))
-            builder.append("null");
-        else
-            builder.append(UString::number(numericValue));
+    if (value.isNumber()) {
+        appendNumber(builder, value);
         return StringifySucceeded;
     }
 
@@ -444,19 +588,14 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(UStringBuilder&
         return StringifySucceeded;
 
     // If this is the outermost call, then loop to handle everything on the holder stack.
-    TimeoutChecker localTimeoutChecker(m_exec->globalData().timeoutChecker);
-    localTimeoutChecker.reset();
-    unsigned tickCount = localTimeoutChecker.ticksUntilNextCheck();
+    TimeoutChecker& timeoutChecker = m_exec->globalData().timeoutChecker;
     do {
         while (m_holderStack.last().appendNextProperty(*this, builder)) {
             if (m_exec->hadException())
                 return StringifyFailed;
-            if (!--tickCount) {
-                if (localTimeoutChecker.didTimeOut(m_exec)) {
-                    throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
-                    return StringifyFailed;
-                }
-                tickCount = localTimeoutChecker.ticksUntilNextCheck();
+            if (UNLIKELY(timeoutChecker.interruptRequested()) && timeoutChecker.didTimeOut(m_exec)) {
+                throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
+                return StringifyFailed;
             }
         }
         m_holderStack.removeLast();
@@ -497,6 +636,8 @@ inline Stringifier::Holder::Holder(JSGlobalData& globalData, JSObject* object)
     : m_object(globalData, object)
     , m_isArray(object->inherits(&JSArray::s_info))
     , m_index(0)
+    , m_structure(0)
+    , m_structureProperties(0)
 {
 }
 
@@ -515,17 +656,39 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         } else {
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
+            else if ((m_structureProperties = stringifier.structureProperties(m_object.get())))
+                m_structure = m_object->structure();
             else {
                 PropertyNameArray objectPropertyNames(exec);
                 m_object->getOwnPropertyNames(exec, objectPropertyNames);
                 m_propertyNames = objectPropertyNames.releaseData();
             }
-            m_size = m_propertyNames->propertyNameVector().size();
+            m_size = m_structureProperties ? m_structureProperties->names.size() : m_propertyNames->propertyNameVector().size();
             builder.append('{');
         }
         stringifier.indent();
     }
 
+    // Elements of a JSArray that are primitives need no toJSON lookup or cycle check, so
+    // unless there is a replacer function, append a whole run of them at once.
+    if (m_isArray && m_isJSArray && stringifier.m_replacerCallType == CallTypeNone) {
+        JSArray* array = asArray(m_object.get());
+        while (m_index < m_size && array->canGetIndex(m_index)) {
+            JSValue value = array->getIndex(m_index);
+            if (value.isObject())
+                break;
+            unsigned rollBackPoint = builder.length();
+            if (m_index)
+                builder.append(',');
+            stringifier.startNewLine(builder);
+            if (!appendPrimitive(builder, exec, value)) {
+                builder.resize(rollBackPoint);
+                break;
+            }
+            ++m_index;
+        }
+    }
+
     // Last time through, finish up and return false.
     if (m_index == m_size) {
         stringifier.unindent();
@@ -535,6 +698,14 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         return false;
     }
 
+    // Once the first element of the outermost array has been appended, assume the rest
+    // will be about the same size, and reserve space for them all up front.
+    if (m_isArray && m_index == 1 && m_size > 2 && stringifier.m_holderStack.size() == 1) {
+        uint64_t estimatedLength = static_cast<uint64_t>(builder.length()) * m_size;
+        if (estimatedLength < maxEstimatedLength)
+            builder.reserveCapacity(static_cast<unsigned>(estimatedLength));
+    }
+
     // Handle a single element of the array or object.
     unsigned index = m_index++;
     unsigned rollBackPoint = 0;
@@ -562,13 +733,18 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         stringifyResult = stringifier.appendStringifiedValue(builder, value, m_object.get(), index);
     } else {
         // Get the value.
-        PropertySlot slot(m_object.get());
-        Identifier& propertyName = m_propertyNames->propertyNameVector()[index];
-        if (!m_object->getOwnPropertySlot(exec, propertyName, slot))
-            return true;
-        JSValue value = slot.getValue(exec, propertyName);
-        if (exec->hadException())
-            return false;
+        JSValue value;
+        const Identifier& propertyName = m_structureProperties ? m_structureProperties->names[index] : m_propertyNames->propertyNameVector()[index];
+        if (m_structureProperties && m_object->structure() == m_structure)
+            value = m_object->getDirectOffset(m_structureProperties->offsets[index]);
+        else {
+            PropertySlot slot(m_object.get());
+            if (!m_object->getOwnPropertySlot(exec, propertyName, slot))
+                return true;
+            value = slot.getValue(exec, propertyName);
+            if (exec->hadException())
+                return false;
+        }
 
         rollBackPoint = builder.length();
 
@@ -578,7 +754,10 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         stringifier.startNewLine(builder);
 
         // Append the property name.
-        appendQuotedString(builder, propertyName.ustring());
+        if (m_structureProperties)
+            builder.append(m_structureProperties->quotedNames[index]);
+        else
+            appendQuotedString(builder, propertyName.ustring());
         builder.append(':');
         if (stringifier.willIndent())
             builder.append(' ');
@@ -684,9 +863,7 @@ NEVER_INLINE JSValue Walker::walk(JSValue unfiltered)
     JSValue inValue = unfiltered;
     JSValue outValue = jsNull();
     
-    TimeoutChecker localTimeoutChecker(m_exec->globalData().timeoutChecker);
-    localTimeoutChecker.reset();
-    unsigned tickCount = localTimeoutChecker.ticksUntilNextCheck();
+    TimeoutChecker& timeoutChecker = m_exec->globalData().timeoutChecker;
     while (1) {
         switch (state) {
             arrayStartState:
@@ -703,11 +880,8 @@ NEVER_INLINE JSValue Walker::walk(JSValue unfiltered)
             }
             arrayStartVisitMember:
             case ArrayStartVisitMember: {
-                if (!--tickCount) {
-                    if (localTimeoutChecker.didTimeOut(m_exec))
-                        return throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
-                    tickCount = localTimeoutChecker.ticksUntilNextCheck();
-                }
+                if (UNLIKELY(timeoutChecker.interruptRequested()) && timeoutChecker.didTimeOut(m_exec))
+                    return throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
 
                 JSArray* array = arrayStack.peek();
                 uint32_t index = indexStack.last();
@@ -766,11 +940,8 @@ NEVER_INLINE JSValue Walker::walk(JSValue unfiltered)
             }
             objectStartVisitMember:
             case ObjectStartVisitMember: {
-                if (!--tickCount) {
-                    if (localTimeoutChecker.didTimeOut(m_exec))
-                        return throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
-                    tickCount = localTimeoutChecker.ticksUntilNextCheck();
-                }
+                if (UNLIKELY(timeoutChecker.interruptRequested()) && timeoutChecker.didTimeOut(m_exec))
+                    return throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
 
                 JSObject* object = objectStack.peek();
                 uint32_t index = indexStack.last();
@@ -830,11 +1001,8 @@ NEVER_INLINE JSValue Walker::walk(JSValue unfiltered)
         state = stateStack.last();
         stateStack.removeLast();
 
-        if (!--tickCount) {
-            if (localTimeoutChecker.didTimeOut(m_exec))
-                return throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
-            tickCount = localTimeoutChecker.ticksUntilNextCheck();
-        }
+        if (UNLIKELY(timeoutChecker.interruptRequested()) && timeoutChecker.didTimeOut(m_exec))
+            return throwError(m_exec, createInterruptedExecutionException(&m_exec->globalData()));
     }
     JSObject* finalHolder = constructEmptyObject(m_exec);
     PutPropertySlot slot;
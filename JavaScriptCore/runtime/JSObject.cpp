@@ -581,6 +581,20 @@ Structure* JSObject::createInheritorID(JSGlobalData& globalData)
 {
     m_inheritorID.set(globalData, this, createEmptyObjectStructure(globalData, this));
     ASSERT(m_inheritorID->isEmpty());
+    m_inheritorID->startSamplingStorageSize();
+    return m_inheritorID.get();
+}
+
+Structure* JSObject::sizeInheritorInlineStorage(JSGlobalData& globalData)
+{
+    // The first instances have been given their properties by now. Size the inline storage of
+    // later ones to match, unless they need out-of-line storage anyway. Existing instances keep
+    // their structures.
+    unsigned capacity = m_inheritorID->largestSampledStorageSize();
+    if (capacity > JSFinalObject::maxInlineStorageCapacity || capacity == m_inheritorID->propertyStorageCapacity())
+        return m_inheritorID.get();
+
+    m_inheritorID.set(globalData, this, Structure::createWithInlineStorageCapacity(globalData, m_inheritorID.get(), capacity));
     return m_inheritorID.get();
 }
 
@@ -301,6 +301,7 @@ namespace JSC {
 
         const HashEntry* findPropertyHashEntry(ExecState*, const Identifier& propertyName) const;
         Structure* createInheritorID(JSGlobalData&);
+        Structure* sizeInheritorInlineStorage(JSGlobalData&);
 
         PropertyStorage m_propertyStorage;
         WriteBarrier<Structure> m_inheritorID;
@@ -352,9 +353,14 @@ COMPILE_ASSERT((JSFinalObject_inlineStorageCapacity >= JSNonFinalObject_inlineSt
         friend class JSObject;
 
     public:
+        // Inline storage is sized by the structure, so that constructed objects can be given
+        // room for exactly the properties they are expected to get (see JSObject::inheritorID).
+        // Beyond 128 bytes, cell sizes grow in much coarser steps.
+        static const unsigned maxInlineStorageCapacity = (128 - sizeof(JSObject)) / sizeof(WriteBarrierBase<Unknown>);
+
         static JSFinalObject* create(ExecState* exec, Structure* structure)
         {
-            return new (exec) JSFinalObject(exec->globalData(), structure);
+            return new (exec->heap()->allocate(allocationSize(structure->propertyStorageCapacity()))) JSFinalObject(exec->globalData(), structure);
         }
 
         static Structure* createStructure(JSGlobalData& globalData, JSValue prototype)
@@ -367,7 +373,13 @@ COMPILE_ASSERT((JSFinalObject_inlineStorageCapacity >= JSNonFinalObject_inlineSt
             : JSObject(globalData, structure, m_inlineStorage)
         {
             ASSERT(OBJECT_OFFSETOF(JSFinalObject, m_inlineStorage) % sizeof(double) == 0);
-            ASSERT(this->structure()->propertyStorageCapacity() == JSFinalObject_inlineStorageCapacity);
+            ASSERT(this->structure()->propertyStorageCapacity() <= maxInlineStorageCapacity);
+        }
+
+        static size_t allocationSize(unsigned inlineStorageCapacity)
+        {
+            ASSERT(inlineStorageCapacity <= maxInlineStorageCapacity);
+            return OBJECT_OFFSETOF(JSFinalObject, m_inlineStorage) + inlineStorageCapacity * sizeof(WriteBarrierBase<Unknown>);
         }
 
         static const unsigned StructureFlags = JSObject::StructureFlags | IsJSFinalObject;
@@ -375,6 +387,9 @@ COMPILE_ASSERT((JSFinalObject_inlineStorageCapacity >= JSNonFinalObject_inlineSt
         WriteBarrierBase<Unknown> m_inlineStorage[JSFinalObject_inlineStorageCapacity];
     };
 
+COMPILE_ASSERT(JSFinalObject::maxInlineStorageCapacity >= JSFinalObject_inlineStorageCapacity, default_final_storage_fits_sized_storage);
+COMPILE_ASSERT(JSFinalObject::maxInlineStorageCapacity < JSObject::baseExternalStorageCapacity, sized_storage_is_inline);
+
 inline size_t JSObject::offsetOfInlineStorage()
 {
     ASSERT(OBJECT_OFFSETOF(JSFinalObject, m_inlineStorage) == OBJECT_OFFSETOF(JSNonFinalObject, m_inlineStorage));
@@ -453,6 +468,8 @@ inline Structure* JSObject::inheritorID(JSGlobalData& globalData)
 {
     if (m_inheritorID) {
         ASSERT(m_inheritorID->isEmpty());
+        if (UNLIKELY(m_inheritorID->isSamplingStorageSize()) && m_inheritorID->didSampleStorageSize())
+            return sizeInheritorInlineStorage(globalData);
         return m_inheritorID.get();
     }
     return createInheritorID(globalData);
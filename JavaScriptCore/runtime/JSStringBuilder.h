@@ -69,6 +69,16 @@ public:
         m_okay &= buffer.tryAppend(str.characters(), str.length());
     }
 
+    void reserveCapacity(size_t capacity)
+    {
+        m_okay &= buffer.tryReserveCapacity(capacity);
+    }
+
+    bool isEmpty() const { return buffer.isEmpty(); }
+
+    // True once an append or reservation could not allocate; build() then throws.
+    bool hasOverflowed() const { return !m_okay; }
+
     JSValue build(ExecState* exec)
     {
         if (!m_okay)
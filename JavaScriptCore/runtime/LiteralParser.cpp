@@ -28,6 +28,7 @@
 
 #include "JSArray.h"
 #include "JSString.h"
+#include "JSGlobalObject.h"
 #include "Lexer.h"
 #include "UStringBuilder.h"
 #include <wtf/ASCIICType.h>
@@ -141,8 +142,22 @@ template <LiteralParser::ParserMode mode> static inline bool isSafeStringCharact
 template <LiteralParser::ParserMode mode> inline LiteralParser::TokenType LiteralParser::Lexer::lexString(LiteralParserToken& token)
 {
     ++m_ptr;
-    const UChar* runStart;
+    const UChar* runStart = m_ptr;
+    while (m_ptr < m_end && isSafeStringCharacter<mode>(*m_ptr))
+        ++m_ptr;
+    if (m_ptr < m_end && *m_ptr == '"') {
+        // No escapes, so the token can refer to the source directly.
+        token.stringBuffer = UString();
+        token.stringToken = runStart;
+        token.stringLength = m_ptr - runStart;
+        token.type = TokString;
+        token.end = ++m_ptr;
+        return TokString;
+    }
+
     UStringBuilder builder;
+    if (runStart < m_ptr)
+        builder.append(runStart, m_ptr - runStart);
     do {
         runStart = m_ptr;
         while (m_ptr < m_end && isSafeStringCharacter<mode>(*m_ptr))
@@ -207,7 +222,9 @@ template <LiteralParser::ParserMode mode> inline LiteralParser::TokenType Litera
     if (m_ptr >= m_end || *m_ptr != '"')
         return TokError;
 
-    token.stringToken = builder.toUString();
+    token.stringBuffer = builder.toUString();
+    token.stringToken = token.stringBuffer.characters();
+    token.stringLength = token.stringBuffer.length();
     token.type = TokString;
     token.end = ++m_ptr;
     return TokString;
@@ -287,13 +304,77 @@ LiteralParser::TokenType LiteralParser::Lexer::lexNumber(LiteralParserToken& tok
     return TokNumber;
 }
 
+Identifier LiteralParser::makeIdentifier(const UChar* characters, unsigned length)
+{
+    if (!length)
+        return m_exec->globalData().propertyNames->emptyIdentifier;
+
+    Identifier& cached = m_identifierCache[(length * 31 + characters[0] * 7 + characters[length - 1]) % identifierCacheSize];
+    if (!cached.isNull() && static_cast<unsigned>(cached.length()) == length && !memcmp(cached.characters(), characters, length * sizeof(UChar)))
+        return cached;
+    cached = Identifier(m_exec, characters, length);
+    return cached;
+}
+
+JSValue LiteralParser::makeString(const Lexer::LiteralParserToken& token)
+{
+    if (token.stringLength == 1 && token.stringToken[0] <= 0xFF)
+        return jsSingleCharacterString(m_exec, token.stringToken[0]);
+    if (!token.stringBuffer.isNull())
+        return jsString(m_exec, token.stringBuffer);
+    return jsString(m_exec, UString(token.stringToken, token.stringLength));
+}
+
+JSObject* LiteralParser::makeObject(const Identifier* keys, const Register* values, unsigned propertyCount)
+{
+    JSGlobalData& globalData = m_exec->globalData();
+    JSObject* object = constructEmptyObject(m_exec);
+    if (!propertyCount)
+        return object;
+
+    ObjectShape& shape = m_objectShapeCache[(reinterpret_cast<uintptr_t>(keys[0].impl()) / sizeof(void*) + propertyCount) % objectShapeCacheSize];
+    if (shape.structure && shape.keys.size() == propertyCount && shape.structure->storedPrototype() == object->prototype()) {
+        unsigned i = 0;
+        while (i < propertyCount && shape.keys[i].impl() == keys[i].impl())
+            ++i;
+        if (i == propertyCount) {
+            object->transitionTo(globalData, shape.structure.get());
+            for (i = 0; i < propertyCount; ++i)
+                object->putDirectOffset(globalData, shape.offsets[i], values[i].jsValue());
+            return object;
+        }
+    }
+
+    for (unsigned i = 0; i < propertyCount; ++i)
+        object->putDirect(globalData, keys[i], values[i].jsValue());
+
+    Structure* structure = object->structure();
+    if (structure->isDictionary()) {
+        shape.structure.clear();
+        return object;
+    }
+    shape.keys.clear();
+    shape.offsets.clear();
+    for (unsigned i = 0; i < propertyCount; ++i) {
+        shape.keys.append(keys[i]);
+        shape.offsets.append(structure->get(globalData, keys[i]));
+    }
+    shape.structure.set(globalData, structure);
+    return object;
+}
+
 JSValue LiteralParser::parse(ParserState initialState)
 {
     ParserState state = initialState;
     MarkedArgumentBuffer objectStack;
     JSValue lastValue;
     Vector<ParserState, 16> stateStack;
+    // Objects are only created once all of their properties have been read, so that
+    // makeObject can see the whole key sequence.  Until then their keys and values
+    // are kept here, with objectStartStack recording where each object's values begin.
     Vector<Identifier, 16> identifierStack;
+    MarkedArgumentBuffer propertyStack;
+    Vector<unsigned, 16> objectStartStack;
     while (1) {
         switch(state) {
             startParseArray:
@@ -333,9 +414,6 @@ JSValue LiteralParser::parse(ParserState initialState)
             }
             startParseObject:
             case StartParseObject: {
-                JSObject* object = constructEmptyObject(m_exec);
-                objectStack.append(object);
-
                 TokenType type = m_lexer.next();
                 if (type == TokString) {
                     Lexer::LiteralParserToken identifierToken = m_lexer.currentToken();
@@ -345,14 +423,14 @@ JSValue LiteralParser::parse(ParserState initialState)
                         return JSValue();
                     
                     m_lexer.next();
-                    identifierStack.append(Identifier(m_exec, identifierToken.stringToken));
+                    objectStartStack.append(propertyStack.size());
+                    identifierStack.append(makeIdentifier(identifierToken.stringToken, identifierToken.stringLength));
                     stateStack.append(DoParseObjectEndExpression);
                     goto startParseExpression;
                 } else if (type != TokRBrace) 
                     return JSValue();
                 m_lexer.next();
-                lastValue = objectStack.last();
-                objectStack.removeLast();
+                lastValue = constructEmptyObject(m_exec);
                 break;
             }
             doParseObjectStartExpression:
@@ -367,21 +445,28 @@ JSValue LiteralParser::parse(ParserState initialState)
                     return JSValue();
 
                 m_lexer.next();
-                identifierStack.append(Identifier(m_exec, identifierToken.stringToken));
+                identifierStack.append(makeIdentifier(identifierToken.stringToken, identifierToken.stringLength));
                 stateStack.append(DoParseObjectEndExpression);
                 goto startParseExpression;
             }
             case DoParseObjectEndExpression:
             {
-                asObject(objectStack.last())->putDirect(m_exec->globalData(), identifierStack.last(), lastValue);
-                identifierStack.removeLast();
+                propertyStack.append(lastValue);
                 if (m_lexer.currentToken().type == TokComma)
                     goto doParseObjectStartExpression;
                 if (m_lexer.currentToken().type != TokRBrace)
                     return JSValue();
                 m_lexer.next();
-                lastValue = objectStack.last();
-                objectStack.removeLast();
+                unsigned objectStart = objectStartStack.last();
+                objectStartStack.removeLast();
+                unsigned propertyCount = propertyStack.size() - objectStart;
+                // Every enclosing object still has its current key on identifierStack, so
+                // this object's keys are the last propertyCount entries there.
+                unsigned keyStart = identifierStack.size() - propertyCount;
+                lastValue = makeObject(identifierStack.data() + keyStart, propertyStack.begin() + objectStart, propertyCount);
+                identifierStack.shrink(keyStart);
+                while (propertyStack.size() > objectStart)
+                    propertyStack.removeLast();
                 break;
             }
             startParseExpression:
@@ -394,7 +479,7 @@ JSValue LiteralParser::parse(ParserState initialState)
                     case TokString: {
                         Lexer::LiteralParserToken stringToken = m_lexer.currentToken();
                         m_lexer.next();
-                        lastValue = jsString(m_exec, stringToken.stringToken);
+                        lastValue = makeString(stringToken);
                         break;
                     }
                     case TokNumber: {
@@ -26,8 +26,10 @@
 #ifndef LiteralParser_h
 #define LiteralParser_h
 
+#include "Identifier.h"
 #include "JSGlobalObjectFunctions.h"
 #include "JSValue.h"
+#include "Strong.h"
 #include "UString.h"
 
 namespace JSC {
@@ -66,7 +68,11 @@ namespace JSC {
                 TokenType type;
                 const UChar* start;
                 const UChar* end;
-                UString stringToken;
+                // Points into the source unless the string had escapes, in which case
+                // the unescaped characters are held by stringBuffer.
+                const UChar* stringToken;
+                unsigned stringLength;
+                UString stringBuffer;
                 double numberToken;
             };
             Lexer(const UString& s, ParserMode mode)
@@ -101,9 +107,26 @@ namespace JSC {
         class StackGuard;
         JSValue parse(ParserState);
 
+        Identifier makeIdentifier(const UChar* characters, unsigned length);
+        JSValue makeString(const Lexer::LiteralParserToken&);
+        JSObject* makeObject(const Identifier* keys, const Register* values, unsigned propertyCount);
+
+        // Records in JSON data tend to share their keys, so the parser remembers the
+        // structure that the last object with a given key sequence ended up with, and
+        // gives later objects with the same keys that structure directly.
+        struct ObjectShape {
+            Vector<Identifier, 8> keys;
+            Vector<size_t, 8> offsets;
+            Strong<Structure> structure;
+        };
+        static const unsigned objectShapeCacheSize = 16;
+        static const unsigned identifierCacheSize = 64;
+
         ExecState* m_exec;
         LiteralParser::Lexer m_lexer;
         ParserMode m_mode;
+        ObjectShape m_objectShapeCache[objectShapeCacheSize];
+        Identifier m_identifierCache[identifierCacheSize];
     };
 }
 
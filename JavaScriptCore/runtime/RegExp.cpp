@@ -78,6 +78,8 @@ inline RegExp::RegExp(JSGlobalData* globalData, const UString& patternString, Re
     , m_flags(flags)
     , m_constructionError(0)
     , m_numSubpatterns(0)
+    , m_lastStartOffset(0)
+    , m_lastResult(-1)
 #if ENABLE(REGEXP_TRACING)
     , m_rtMatchCallCount(0)
     , m_rtMatchFoundCount(0)
@@ -155,6 +157,19 @@ int RegExp::match(const UString& s, int startOffset, Vector<int, 32>* ovector)
         }
 
         ASSERT(offsetVector);
+
+        // Strings are immutable, so matching the same StringImpl from the same
+        // offset again must produce the same result. Callers still apply their
+        // own side effects (lastIndex, RegExp.lastMatch) to the returned offsets.
+        if (s.impl() == m_lastSubject.get() && startOffset == m_lastStartOffset) {
+            memcpy(offsetVector, m_lastOvector.data(), offsetVectorSize * sizeof(int));
+#if ENABLE(REGEXP_TRACING)
+            if (m_lastResult != -1)
+                m_rtMatchFoundCount++;
+#endif
+            return m_lastResult;
+        }
+
         // Initialize offsetVector with the return value (index 0) and the 
         // first subpattern start indicies (even index values) set to -1.
         // No need to init the subpattern end indicies.
@@ -173,6 +188,16 @@ int RegExp::match(const UString& s, int startOffset, Vector<int, 32>* ovector)
             result = Yarr::interpret(m_representation->m_regExpBytecode.get(), s.characters(), startOffset, s.length(), offsetVector);
         ASSERT(result >= -1);
 
+        // Only short subjects are remembered, since the cache keeps the last one alive. A substring
+        // would also keep alive the whole string it was taken from.
+        if (s.length() <= maxCachedSubjectLength && !s.impl()->sharesBuffer()) {
+            m_lastSubject = s.impl();
+            m_lastStartOffset = startOffset;
+            m_lastResult = result;
+            m_lastOvector.resize(offsetVectorSize);
+            memcpy(m_lastOvector.data(), offsetVector, offsetVectorSize * sizeof(int));
+        }
+
 #if ENABLE(REGEXP_TRACING)
         if (result != -1)
             m_rtMatchFoundCount++;
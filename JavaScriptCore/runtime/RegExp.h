@@ -27,6 +27,7 @@
 #include "RegExpKey.h"
 #include <wtf/Forward.h>
 #include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
@@ -71,10 +72,18 @@ namespace JSC {
         void matchCompareWithInterpreter(const UString&, int startOffset, int* offsetVector, int jitResult);
 #endif
 
+        static const unsigned maxCachedSubjectLength = 1024;
+
         UString m_patternString;
         RegExpFlags m_flags;
         const char* m_constructionError;
         unsigned m_numSubpatterns;
+
+        // The subject, start offset and outcome of the last match.
+        RefPtr<StringImpl> m_lastSubject;
+        int m_lastStartOffset;
+        int m_lastResult;
+        Vector<int> m_lastOvector;
 #if ENABLE(REGEXP_TRACING)
         unsigned m_rtMatchCallCount;
         unsigned m_rtMatchFoundCount;
@@ -83,6 +92,50 @@ namespace JSC {
         OwnPtr<RegExpRepresentation> m_representation;
     };
 
+    // Walks the successive matches of a RegExp over one input string. Searches
+    // alternate between two offset vectors, so the last successful match stays
+    // available after the search that ends the iteration fails. An empty match
+    // advances the search position by one character.
+    class RegExpMatchIterator {
+    public:
+        RegExpMatchIterator(RegExp* regExp, const UString& input, unsigned startOffset = 0)
+            : m_regExp(regExp)
+            , m_input(input)
+            , m_position(startOffset)
+            , m_current(0)
+        {
+        }
+
+        bool next()
+        {
+            if (m_position > m_input.length())
+                return false;
+            Vector<int, 32>& ovector = m_ovector[m_current ^ 1];
+            if (m_regExp->match(m_input, m_position, &ovector) < 0) {
+                m_position = m_input.length() + 1;
+                return false;
+            }
+            m_current ^= 1;
+            m_position = ovector[1] == ovector[0] ? ovector[1] + 1 : ovector[1];
+            return true;
+        }
+
+        // The search position for the next call to next().
+        unsigned position() const { return m_position; }
+
+        // Offsets of the last successful match; only valid once next() has returned true.
+        const int* ovector() const { ASSERT(!m_ovector[m_current].isEmpty()); return m_ovector[m_current].data(); }
+        int start() const { return ovector()[0]; }
+        int end() const { return ovector()[1]; }
+
+    private:
+        RegExp* m_regExp;
+        const UString& m_input;
+        unsigned m_position;
+        unsigned m_current;
+        Vector<int, 32> m_ovector[2];
+    };
+
 } // namespace JSC
 
 #endif // RegExp_h
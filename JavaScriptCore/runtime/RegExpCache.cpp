@@ -34,10 +34,11 @@ namespace JSC {
 PassRefPtr<RegExp> RegExpCache::lookupOrCreate(const UString& patternString, RegExpFlags flags)
 {
     if (patternString.length() < maxCacheablePatternLength) {
-        pair<RegExpCacheMap::iterator, bool> result = m_cacheMap.add(RegExpKey(flags, patternString), 0);
-        if (!result.second)
-            return result.first->second;
-        else
+        pair<RegExpCacheMap::iterator, bool> result = m_cacheMap.add(RegExpKey(flags, patternString), Entry());
+        if (!result.second) {
+            result.first->second.lastUse = ++m_useCounter;
+            return result.first->second.regExp;
+        } else
             return create(patternString, flags, result.first);
     }
     return create(patternString, flags, m_cacheMap.end());
@@ -50,27 +51,31 @@ PassRefPtr<RegExp> RegExpCache::create(const UString& patternString, RegExpFlags
     if (patternString.length() >= maxCacheablePatternLength)
         return regExp;
 
-    RegExpKey key = RegExpKey(flags, patternString);
-    iterator->first = key;
-    iterator->second = regExp;
+    iterator->second.regExp = regExp;
+    iterator->second.lastUse = ++m_useCounter;
 
-    ++m_nextKeyToEvict;
-    if (m_nextKeyToEvict == maxCacheableEntries) {
-        m_nextKeyToEvict = 0;
-        m_isFull = true;
-    }
-    if (m_isFull)
-        m_cacheMap.remove(RegExpKey(patternKeyArray[m_nextKeyToEvict].flagsValue, patternKeyArray[m_nextKeyToEvict].pattern));
+    if (m_cacheMap.size() > maxCacheableEntries)
+        evictLeastRecentlyUsed();
 
-    patternKeyArray[m_nextKeyToEvict].flagsValue = key.flagsValue;
-    patternKeyArray[m_nextKeyToEvict].pattern = patternString.impl();
     return regExp;
 }
 
+// Eviction only happens when a new pattern has just been compiled, which
+// dwarfs the cost of scanning the cache for its oldest entry.
+void RegExpCache::evictLeastRecentlyUsed()
+{
+    RegExpCacheMap::iterator end = m_cacheMap.end();
+    RegExpCacheMap::iterator oldest = m_cacheMap.begin();
+    for (RegExpCacheMap::iterator it = oldest; it != end; ++it) {
+        if (it->second.lastUse < oldest->second.lastUse)
+            oldest = it;
+    }
+    m_cacheMap.remove(oldest);
+}
+
 RegExpCache::RegExpCache(JSGlobalData* globalData)
     : m_globalData(globalData)
-    , m_nextKeyToEvict(-1)
-    , m_isFull(false)
+    , m_useCounter(0)
 {
 }
 
@@ -28,7 +28,6 @@
 #include "RegExp.h"
 #include "RegExpKey.h"
 #include "UString.h"
-#include <wtf/FixedArray.h>
 #include <wtf/HashMap.h>
 
 #ifndef RegExpCache_h
@@ -38,7 +37,17 @@ namespace JSC {
 
 class RegExpCache {
 
-typedef HashMap<RegExpKey, RefPtr<RegExp> > RegExpCacheMap;
+struct Entry {
+    Entry()
+        : lastUse(0)
+    {
+    }
+
+    RefPtr<RegExp> regExp;
+    uint64_t lastUse;
+};
+
+typedef HashMap<RegExpKey, Entry> RegExpCacheMap;
 
 public:
     PassRefPtr<RegExp> lookupOrCreate(const UString& patternString, RegExpFlags);
@@ -46,21 +55,21 @@ public:
     RegExpCache(JSGlobalData* globalData);
 
 private:
+    void evictLeastRecentlyUsed();
+
     static const unsigned maxCacheablePatternLength = 256;
 
 #if PLATFORM(IOS)
     // The RegExpCache can currently hold onto multiple Mb of memory;
     // as a short-term fix some embedded platforms may wish to reduce the cache size.
-    static const int maxCacheableEntries = 32;
+    static const unsigned maxCacheableEntries = 32;
 #else
-    static const int maxCacheableEntries = 256;
+    static const unsigned maxCacheableEntries = 256;
 #endif
 
-    FixedArray<RegExpKey, maxCacheableEntries> patternKeyArray;
     RegExpCacheMap m_cacheMap;
     JSGlobalData* m_globalData;
-    int m_nextKeyToEvict;
-    bool m_isFull;
+    uint64_t m_useCounter;
 };
 
 } // namespace JSC
@@ -71,6 +71,7 @@ namespace JSC {
         static const ClassInfo s_info;
 
         void performMatch(RegExp*, const UString&, int startOffset, int& position, int& length, int** ovector = 0);
+        void recordMatch(RegExp*, const UString&, const int* ovector);
         JSObject* arrayOfMatches(ExecState*) const;
 
         void setInput(const UString&);
@@ -128,6 +129,20 @@ namespace JSC {
         }
     }
 
+    // Callers that run several matches without executing script in between
+    // (e.g. replace() with a string replacement) only need to publish the
+    // final one.
+    inline void RegExpConstructor::recordMatch(RegExp* r, const UString& s, const int* ovector)
+    {
+        unsigned offsetVectorSize = (r->numSubpatterns() + 1) * 2;
+        d->lastOvector().resize(offsetVectorSize);
+        memcpy(d->lastOvector().data(), ovector, offsetVectorSize * sizeof(int));
+
+        d->input = s;
+        d->lastInput = s;
+        d->lastNumSubPatterns = r->numSubpatterns();
+    }
+
 } // namespace JSC
 
 #endif // RegExpConstructor_h
@@ -36,6 +36,7 @@
 #include "RegExpCache.h"
 #include "RegExpConstructor.h"
 #include "RegExpObject.h"
+#include "UStringBuilder.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/MathExtras.h>
 #include <wtf/unicode/Collator.h>
@@ -153,10 +154,61 @@ bool StringPrototype::getOwnPropertyDescriptor(ExecState* exec, const Identifier
 
 // ------------------------------ Functions --------------------------
 
-static NEVER_INLINE UString substituteBackreferencesSlow(const UString& replacement, const UString& source, const int* ovector, RegExp* reg, size_t i)
+// A replacement string with its '$' patterns resolved up front, so that a
+// global replace scans it once per call rather than once per match.
+class ReplacementTemplate {
+public:
+    ReplacementTemplate(const UString& replacement, unsigned numSubpatterns);
+
+    bool isEmpty() const { return m_parts.isEmpty(); }
+
+    // The number of characters each substitution contributes besides captured text.
+    unsigned literalLength() const { return m_literalLength; }
+
+    template<typename Builder> void append(Builder&, const UString& source, const int* ovector) const;
+    // The substitution as a string of its own, sharing the replacement when it has no '$' patterns.
+    UString substitute(const UString& source, const int* ovector) const;
+
+private:
+    enum PartType { Literal, Capture, LeftContext, RightContext };
+
+    struct Part {
+        Part(PartType type, int index = 0, int length = 0)
+            : type(type)
+            , index(index)
+            , length(length)
+        {
+        }
+
+        PartType type;
+        int index; // Offset into the replacement for literals, subpattern number for captures.
+        int length;
+    };
+
+    void appendLiteral(size_t offset, size_t length)
+    {
+        if (!length)
+            return;
+        m_parts.append(Part(Literal, offset, length));
+        m_literalLength += length;
+    }
+
+    UString m_replacement;
+    Vector<Part, 8> m_parts;
+    unsigned m_literalLength;
+};
+
+ReplacementTemplate::ReplacementTemplate(const UString& replacement, unsigned numSubpatterns)
+    : m_replacement(replacement)
+    , m_literalLength(0)
 {
-    Vector<UChar> substitutedReplacement;
-    int offset = 0;
+    size_t i = replacement.find('$', 0);
+    if (LIKELY(i == notFound)) {
+        appendLiteral(0, replacement.length());
+        return;
+    }
+
+    size_t offset = 0;
     do {
         if (i + 1 == replacement.length())
             break;
@@ -165,33 +217,30 @@ static NEVER_INLINE UString substituteBackreferencesSlow(const UString& replacem
         if (ref == '$') {
             // "$$" -> "$"
             ++i;
-            substitutedReplacement.append(replacement.characters() + offset, i - offset);
+            appendLiteral(offset, i - offset);
             offset = i + 1;
             continue;
         }
 
-        int backrefStart;
-        int backrefLength;
+        PartType type;
+        unsigned backrefIndex = 0;
         int advance = 0;
-        if (ref == '&') {
-            backrefStart = ovector[0];
-            backrefLength = ovector[1] - backrefStart;
-        } else if (ref == '`') {
-            backrefStart = 0;
-            backrefLength = ovector[0];
-        } else if (ref == '\'') {
-            backrefStart = ovector[1];
-            backrefLength = source.length() - backrefStart;
-        } else if (reg && ref >= '0' && ref <= '9') {
+        if (ref == '&')
+            type = Capture;
+        else if (ref == '`')
+            type = LeftContext;
+        else if (ref == '\'')
+            type = RightContext;
+        else if (ref >= '0' && ref <= '9') {
             // 1- and 2-digit back references are allowed
-            unsigned backrefIndex = ref - '0';
-            if (backrefIndex > reg->numSubpatterns())
+            backrefIndex = ref - '0';
+            if (backrefIndex > numSubpatterns)
                 continue;
             if (replacement.length() > i + 2) {
                 ref = replacement[i + 2];
                 if (ref >= '0' && ref <= '9') {
                     backrefIndex = 10 * backrefIndex + ref - '0';
-                    if (backrefIndex > reg->numSubpatterns())
+                    if (backrefIndex > numSubpatterns)
                         backrefIndex = backrefIndex / 10;   // Fall back to the 1-digit reference
                     else
                         advance = 1;
@@ -199,99 +248,56 @@ static NEVER_INLINE UString substituteBackreferencesSlow(const UString& replacem
             }
             if (!backrefIndex)
                 continue;
-            backrefStart = ovector[2 * backrefIndex];
-            backrefLength = ovector[2 * backrefIndex + 1] - backrefStart;
+            type = Capture;
         } else
             continue;
 
-        if (i - offset)
-            substitutedReplacement.append(replacement.characters() + offset, i - offset);
+        appendLiteral(offset, i - offset);
         i += 1 + advance;
         offset = i + 1;
-        if (backrefStart >= 0)
-            substitutedReplacement.append(source.characters() + backrefStart, backrefLength);
+        m_parts.append(Part(type, backrefIndex));
     } while ((i = replacement.find('$', i + 1)) != notFound);
 
-    if (replacement.length() - offset)
-        substitutedReplacement.append(replacement.characters() + offset, replacement.length() - offset);
-
-    substitutedReplacement.shrinkToFit();
-    return UString::adopt(substitutedReplacement);
+    appendLiteral(offset, replacement.length() - offset);
 }
 
-static inline UString substituteBackreferences(const UString& replacement, const UString& source, const int* ovector, RegExp* reg)
+template<typename Builder> void ReplacementTemplate::append(Builder& builder, const UString& source, const int* ovector) const
 {
-    size_t i = replacement.find('$', 0);
-    if (UNLIKELY(i != notFound))
-        return substituteBackreferencesSlow(replacement, source, ovector, reg, i);
-    return replacement;
+    for (size_t i = 0; i < m_parts.size(); ++i) {
+        const Part& part = m_parts[i];
+        switch (part.type) {
+        case Literal:
+            builder.append(m_replacement.characters() + part.index, part.length);
+            break;
+        case Capture: {
+            int start = ovector[2 * part.index];
+            if (start >= 0)
+                builder.append(source.characters() + start, ovector[2 * part.index + 1] - start);
+            break;
+        }
+        case LeftContext:
+            builder.append(source.characters(), ovector[0]);
+            break;
+        case RightContext:
+            builder.append(source.characters() + ovector[1], source.length() - ovector[1]);
+            break;
+        }
+    }
 }
 
-static inline int localeCompare(const UString& a, const UString& b)
+UString ReplacementTemplate::substitute(const UString& source, const int* ovector) const
 {
-    return Collator::userDefault()->collate(reinterpret_cast<const ::UChar*>(a.characters()), a.length(), reinterpret_cast<const ::UChar*>(b.characters()), b.length());
-}
-
-struct StringRange {
-public:
-    StringRange(int pos, int len)
-        : position(pos)
-        , length(len)
-    {
-    }
-
-    StringRange()
-    {
-    }
+    if (m_parts.size() == 1 && m_parts[0].type == Literal && m_literalLength == m_replacement.length())
+        return m_replacement;
 
-    int position;
-    int length;
-};
+    UStringBuilder builder;
+    append(builder, source, ovector);
+    return builder.toUString();
+}
 
-static ALWAYS_INLINE JSValue jsSpliceSubstringsWithSeparators(ExecState* exec, JSString* sourceVal, const UString& source, const StringRange* substringRanges, int rangeCount, const UString* separators, int separatorCount)
+static inline int localeCompare(const UString& a, const UString& b)
 {
-    if (rangeCount == 1 && separatorCount == 0) {
-        int sourceSize = source.length();
-        int position = substringRanges[0].position;
-        int length = substringRanges[0].length;
-        if (position <= 0 && length >= sourceSize)
-            return sourceVal;
-        // We could call UString::substr, but this would result in redundant checks
-        return jsString(exec, StringImpl::create(source.impl(), max(0, position), min(sourceSize, length)));
-    }
-
-    int totalLength = 0;
-    for (int i = 0; i < rangeCount; i++)
-        totalLength += substringRanges[i].length;
-    for (int i = 0; i < separatorCount; i++)
-        totalLength += separators[i].length();
-
-    if (totalLength == 0)
-        return jsString(exec, "");
-
-    UChar* buffer;
-    PassRefPtr<StringImpl> impl = StringImpl::tryCreateUninitialized(totalLength, buffer);
-    if (!impl)
-        return throwOutOfMemoryError(exec);
-
-    int maxCount = max(rangeCount, separatorCount);
-    int bufferPos = 0;
-    for (int i = 0; i < maxCount; i++) {
-        if (i < rangeCount) {
-            if (int srcLen = substringRanges[i].length) {
-                StringImpl::copyChars(buffer + bufferPos, source.characters() + substringRanges[i].position, srcLen);
-                bufferPos += srcLen;
-            }
-        }
-        if (i < separatorCount) {
-            if (int sepLen = separators[i].length()) {
-                StringImpl::copyChars(buffer + bufferPos, separators[i].characters(), sepLen);
-                bufferPos += sepLen;
-            }
-        }
-    }
-
-    return jsString(exec, impl);
+    return Collator::userDefault()->collate(reinterpret_cast<const ::UChar*>(a.characters()), a.length(), reinterpret_cast<const ::UChar*>(b.characters()), b.length());
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
@@ -319,9 +325,11 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
 
         int lastIndex = 0;
         unsigned startPosition = 0;
+        bool matched = false;
 
-        Vector<StringRange, 16> sourceRanges;
-        Vector<UString, 16> replacements;
+        // Unmatched text and replacements are appended to the result as each
+        // match is found.
+        JSStringBuilder builder;
 
         // This is either a loop (if global is set) or a one-way (if not).
         if (global && callType == CallTypeJS) {
@@ -339,7 +347,11 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
                 if (matchIndex < 0)
                     break;
 
-                sourceRanges.append(StringRange(lastIndex, matchIndex - lastIndex));
+                if (!matched) {
+                    builder.reserveCapacity(sourceLen);
+                    matched = true;
+                }
+                builder.append(source.characters() + lastIndex, matchIndex - lastIndex);
 
                 int completeMatchStart = ovector[0];
                 unsigned i = 0;
@@ -359,9 +371,9 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
                 cachedCall.setThis(exec->globalThisValue());
                 JSValue result = cachedCall.call();
                 if (LIKELY(result.isString()))
-                    replacements.append(asString(result)->value(exec));
+                    builder.append(asString(result)->value(exec));
                 else
-                    replacements.append(result.toString(cachedCall.newCallFrame(exec)));
+                    builder.append(result.toString(cachedCall.newCallFrame(exec)));
                 if (exec->hadException())
                     break;
 
@@ -375,7 +387,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
                         break;
                 }
             }
-        } else {
+        } else if (callType != CallTypeNone) {
             do {
                 int matchIndex;
                 int matchLen = 0;
@@ -384,40 +396,32 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
                 if (matchIndex < 0)
                     break;
 
-                if (callType != CallTypeNone) {
-                    sourceRanges.append(StringRange(lastIndex, matchIndex - lastIndex));
-
-                    int completeMatchStart = ovector[0];
-                    MarkedArgumentBuffer args;
+                if (!matched) {
+                    builder.reserveCapacity(sourceLen);
+                    matched = true;
+                }
+                builder.append(source.characters() + lastIndex, matchIndex - lastIndex);
 
-                    for (unsigned i = 0; i < reg->numSubpatterns() + 1; ++i) {
-                        int matchStart = ovector[i * 2];
-                        int matchLen = ovector[i * 2 + 1] - matchStart;
- 
-                        if (matchStart < 0)
-                            args.append(jsUndefined());
-                        else
-                            args.append(jsSubstring(exec, source, matchStart, matchLen));
-                    }
+                int completeMatchStart = ovector[0];
+                MarkedArgumentBuffer args;
 
-                    args.append(jsNumber(completeMatchStart));
-                    args.append(sourceVal);
+                for (unsigned i = 0; i < reg->numSubpatterns() + 1; ++i) {
+                    int matchStart = ovector[i * 2];
+                    int matchLen = ovector[i * 2 + 1] - matchStart;
 
-                    replacements.append(call(exec, replacement, callType, callData, exec->globalThisValue(), args).toString(exec));
-                    if (exec->hadException())
-                        break;
-                } else {
-                    int replLen = replacementString.length();
-                    if (lastIndex < matchIndex || replLen) {
-                        sourceRanges.append(StringRange(lastIndex, matchIndex - lastIndex));
- 
-                        if (replLen)
-                            replacements.append(substituteBackreferences(replacementString, source, ovector, reg));
-                        else
-                            replacements.append(UString());
-                    }
+                    if (matchStart < 0)
+                        args.append(jsUndefined());
+                    else
+                        args.append(jsSubstring(exec, source, matchStart, matchLen));
                 }
 
+                args.append(jsNumber(completeMatchStart));
+                args.append(sourceVal);
+
+                builder.append(call(exec, replacement, callType, callData, exec->globalThisValue(), args).toString(exec));
+                if (exec->hadException())
+                    break;
+
                 lastIndex = matchIndex + matchLen;
                 startPosition = lastIndex;
 
@@ -428,15 +432,38 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
                         break;
                 }
             } while (global);
+        } else {
+            // No script runs between matches, so only the final match needs
+            // to be published to RegExp.lastMatch and friends.
+            ReplacementTemplate replacementTemplate(replacementString, reg->numSubpatterns());
+            RegExpMatchIterator matches(reg, source);
+            while (matches.next()) {
+                matched = true;
+                // Leave the builder empty while nothing but a leading match has been
+                // removed, so that the result can share the source's buffer.
+                if (!builder.isEmpty() || matches.start() > lastIndex || !replacementTemplate.isEmpty()) {
+                    if (builder.isEmpty())
+                        builder.reserveCapacity(sourceLen + replacementTemplate.literalLength());
+                    builder.append(source.characters() + lastIndex, matches.start() - lastIndex);
+                    replacementTemplate.append(builder, source, matches.ovector());
+                }
+                lastIndex = matches.end();
+                if (!global)
+                    break;
+            }
+            if (matched)
+                regExpConstructor->recordMatch(reg, source, matches.ovector());
         }
 
-        if (!lastIndex && replacements.isEmpty())
+        if (!matched)
             return JSValue::encode(sourceVal);
 
-        if (static_cast<unsigned>(lastIndex) < sourceLen)
-            sourceRanges.append(StringRange(lastIndex, sourceLen - lastIndex));
+        // A builder that failed to allocate may be empty too; build() reports the failure.
+        if (builder.isEmpty() && !builder.hasOverflowed())
+            return JSValue::encode(jsSubstring(exec, source, lastIndex, sourceLen - lastIndex));
 
-        return JSValue::encode(jsSpliceSubstringsWithSeparators(exec, sourceVal, source, sourceRanges.data(), sourceRanges.size(), replacements.data(), replacements.size()));
+        builder.append(source.characters() + lastIndex, sourceLen - lastIndex);
+        return JSValue::encode(builder.build(exec));
     }
 
     // Not a regular expression, so treat the pattern as a string.
@@ -464,7 +491,9 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
     
     size_t matchEnd = matchPos + matchLen;
     int ovector[2] = { matchPos, matchEnd };
-    return JSValue::encode(jsString(exec, source.substringSharingImpl(0, matchPos), substituteBackreferences(replacementString, source, ovector, 0), source.substringSharingImpl(matchEnd)));
+    // Only one match is replaced, so a rope over the source is cheaper than copying it.
+    UString substitution = ReplacementTemplate(replacementString, 0).substitute(source, ovector);
+    return JSValue::encode(jsString(exec, source.substringSharingImpl(0, matchPos), substitution, source.substringSharingImpl(matchEnd)));
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncToString(ExecState* exec)
@@ -717,14 +746,11 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSplit(ExecState* exec)
             // empty string matched by regexp -> empty array
             return JSValue::encode(result);
         }
-        unsigned pos = 0;
-        while (i != limit && pos < s.length()) {
-            Vector<int, 32> ovector;
-            int mpos = reg->match(s, pos, &ovector);
-            if (mpos < 0)
-                break;
-            int mlen = ovector[1] - ovector[0];
-            pos = mpos + (mlen == 0 ? 1 : mlen);
+        RegExpMatchIterator matches(reg, s);
+        while (i != limit && matches.position() < s.length() && matches.next()) {
+            const int* ovector = matches.ovector();
+            int mpos = ovector[0];
+            int mlen = ovector[1] - mpos;
             if (static_cast<unsigned>(mpos) != p0 || mlen) {
                 result->put(exec, i++, jsSubstring(exec, s, p0, mpos - p0));
                 p0 = mpos + mlen;
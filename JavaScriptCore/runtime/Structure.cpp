@@ -198,6 +198,10 @@ Structure::Structure(JSGlobalData& globalData, JSValue prototype, const TypeInfo
     , m_anonymousSlotCount(anonymousSlotCount)
     , m_preventExtensions(false)
     , m_didTransition(false)
+    , m_isSamplingStorageSize(false)
+    , m_storageSizeSamplesLeft(0)
+    , m_storageSizeReportsLeft(0)
+    , m_largestSampledStorageSize(0)
 {
     ASSERT(m_prototype);
     ASSERT(m_prototype.isObject() || m_prototype.isNull());
@@ -221,6 +225,10 @@ Structure::Structure(JSGlobalData& globalData)
     , m_anonymousSlotCount(0)
     , m_preventExtensions(false)
     , m_didTransition(false)
+    , m_isSamplingStorageSize(false)
+    , m_storageSizeSamplesLeft(0)
+    , m_storageSizeReportsLeft(0)
+    , m_largestSampledStorageSize(0)
 {
     ASSERT(m_prototype);
     ASSERT(m_prototype.isNull());
@@ -243,6 +251,10 @@ Structure::Structure(JSGlobalData& globalData, const Structure* previous)
     , m_anonymousSlotCount(previous->anonymousSlotCount())
     , m_preventExtensions(previous->m_preventExtensions)
     , m_didTransition(true)
+    , m_isSamplingStorageSize(previous->m_isSamplingStorageSize)
+    , m_storageSizeSamplesLeft(0)
+    , m_storageSizeReportsLeft(0)
+    , m_largestSampledStorageSize(0)
 {
     ASSERT(m_prototype);
     ASSERT(m_prototype.isObject() || m_prototype.isNull());
@@ -268,7 +280,7 @@ void Structure::materializePropertyMap(JSGlobalData& globalData)
             ASSERT(structure->m_propertyTable);
             ASSERT(!structure->m_previous);
 
-            m_propertyTable = structure->m_propertyTable->copy(globalData, 0, m_offset + 1);
+            m_propertyTable = structure->m_propertyTable->copy(globalData, this, m_offset + 1);
             break;
         }
 
@@ -285,6 +297,39 @@ void Structure::materializePropertyMap(JSGlobalData& globalData)
     }
 }
 
+Structure* Structure::createWithInlineStorageCapacity(JSGlobalData& globalData, Structure* emptyStructure, unsigned capacity)
+{
+    ASSERT(emptyStructure->isEmpty());
+    ASSERT(capacity < JSObject::baseExternalStorageCapacity);
+    Structure* structure = create(globalData, emptyStructure->storedPrototype(), emptyStructure->typeInfo(), emptyStructure->anonymousSlotCount(), emptyStructure->classInfo());
+    structure->m_propertyStorageCapacity = capacity;
+    return structure;
+}
+
+void Structure::reportStorageSizeSample()
+{
+    ASSERT(m_isSamplingStorageSize);
+
+    Structure* root = this;
+    while (Structure* previous = root->previousID())
+        root = previous;
+
+    // Once the root has made up its mind, or heard enough, there is no need for new transitions
+    // to keep reporting.
+    if (!root->isSamplingStorageSize() || !root->m_storageSizeReportsLeft) {
+        m_isSamplingStorageSize = false;
+        return;
+    }
+    unsigned size = propertyStorageSize();
+    if (size > root->m_largestSampledStorageSize)
+        root->m_largestSampledStorageSize = size < 255 ? size : 255;
+
+    // Instances of a prototype that is seldom constructed from may keep taking on new shapes.
+    // Rather than walk back to the root for each of them, let the next construction settle the size.
+    if (!--root->m_storageSizeReportsLeft)
+        root->m_storageSizeSamplesLeft = 1;
+}
+
 void Structure::growPropertyStorageCapacity()
 {
     if (isUsingInlineStorage())
@@ -366,7 +411,7 @@ Structure* Structure::addPropertyTransition(JSGlobalData& globalData, Structure*
 
     if (structure->m_propertyTable) {
         if (structure->m_isPinnedPropertyTable)
-            transition->m_propertyTable = structure->m_propertyTable->copy(globalData, 0, structure->m_propertyTable->size() + 1);
+            transition->m_propertyTable = structure->m_propertyTable->copy(globalData, transition, structure->m_propertyTable->size() + 1);
         else
             transition->m_propertyTable = structure->m_propertyTable.release();
     } else {
@@ -385,6 +430,8 @@ Structure* Structure::addPropertyTransition(JSGlobalData& globalData, Structure*
     transition->m_offset = offset - structure->m_anonymousSlotCount;
     ASSERT(structure->anonymousSlotCount() == transition->anonymousSlotCount());
     structure->m_transitionTable.add(globalData, transition);
+    if (transition->m_isSamplingStorageSize)
+        transition->reportStorageSizeSample();
     return transition;
 }
 
@@ -109,6 +109,31 @@ namespace JSC {
 
         void growPropertyStorageCapacity();
         unsigned propertyStorageCapacity() const { ASSERT(structure()->classInfo() == &s_info); return m_propertyStorageCapacity; }
+
+        // Objects created from an inheritor structure get inline storage sized to fit the
+        // properties that the first instances ended up with (see JSObject::inheritorID).
+        // The inheritor counts the instances allocated from it, while the structures that
+        // adding properties to them leads to report their storage size back to it.
+        static Structure* createWithInlineStorageCapacity(JSGlobalData&, Structure* emptyStructure, unsigned capacity);
+        void startSamplingStorageSize()
+        {
+            ASSERT(isEmpty() && !m_previous);
+            m_storageSizeSamplesLeft = storageSizeSampleCount;
+            m_storageSizeReportsLeft = maxStorageSizeReports;
+            m_isSamplingStorageSize = true;
+        }
+        // Objects allocated from an inheritor that is also cached elsewhere, such as the structure
+        // of object literals, do not come back through JSObject::inheritorID, so sampling would
+        // never finish.
+        void stopSamplingStorageSize()
+        {
+            ASSERT(isEmpty() && !m_previous);
+            m_storageSizeSamplesLeft = 0;
+            m_isSamplingStorageSize = false;
+        }
+        bool isSamplingStorageSize() const { return m_storageSizeSamplesLeft; }
+        bool didSampleStorageSize() { ASSERT(isSamplingStorageSize()); return !--m_storageSizeSamplesLeft; }
+        unsigned largestSampledStorageSize() const { return m_largestSampledStorageSize; }
         unsigned propertyStorageSize() const { ASSERT(structure()->classInfo() == &s_info); return m_anonymousSlotCount + (m_propertyTable ? m_propertyTable->propertyStorageSize() : static_cast<unsigned>(m_offset + 1)); }
         bool isUsingInlineStorage() const;
 
@@ -207,12 +232,17 @@ namespace JSC {
 
         bool isValid(ExecState*, StructureChain* cachedPrototypeChain) const;
 
+        void reportStorageSizeSample();
+
         static const signed char s_maxTransitionLength = 64;
 
         static const signed char noOffset = -1;
 
         static const unsigned maxSpecificFunctionThrashCount = 3;
 
+        static const unsigned char storageSizeSampleCount = 8;
+        static const unsigned char maxStorageSizeReports = 32;
+
         TypeInfo m_typeInfo;
 
         WriteBarrier<Unknown> m_prototype;
@@ -251,7 +281,12 @@ namespace JSC {
         unsigned m_anonymousSlotCount : 5;
         unsigned m_preventExtensions : 1;
         unsigned m_didTransition : 1;
-        // 3 free bits
+        unsigned m_isSamplingStorageSize : 1;
+        // 2 free bits
+
+        unsigned char m_storageSizeSamplesLeft;
+        unsigned char m_storageSizeReportsLeft;
+        unsigned char m_largestSampledStorageSize;
     };
 
     inline size_t Structure::get(JSGlobalData& globalData, const Identifier& propertyName)
@@ -281,11 +316,6 @@ namespace JSC {
         return m_structure->classInfo();
     }
 
-    inline Structure* JSCell::createDummyStructure(JSGlobalData& globalData)
-    {
-        return Structure::create(globalData, jsNull(), TypeInfo(UnspecifiedType), AnonymousSlotCount, &s_dummyCellInfo);
-    }
-
     inline bool JSValue::needsThisConversion() const
     {
         if (UNLIKELY(!isCell()))
@@ -29,17 +29,29 @@
 #ifndef Terminator_h
 #define Terminator_h
 
+#include "TimeoutChecker.h"
+
 namespace JSC {
 
 class Terminator {
 public:
-    Terminator() : m_shouldTerminate(false) { }
+    Terminator(TimeoutChecker& timeoutChecker)
+        : m_timeoutChecker(timeoutChecker)
+        , m_shouldTerminate(false)
+    {
+    }
 
-    void terminateSoon() { m_shouldTerminate = true; }
+    // May be called from any thread.
+    void terminateSoon()
+    {
+        m_shouldTerminate = true;
+        m_timeoutChecker.requestInterrupt();
+    }
     bool shouldTerminate() const { return m_shouldTerminate; }
 
 private:
-    bool m_shouldTerminate;
+    TimeoutChecker& m_timeoutChecker;
+    volatile bool m_shouldTerminate;
 };
 
 } // namespace JSC
@@ -32,13 +32,16 @@
 
 #include "CallFrame.h"
 #include "JSGlobalObject.h"
+#include <limits>
+#include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
 
 #if OS(DARWIN)
 #include <mach/mach.h>
 #elif OS(WINDOWS)
 #include <windows.h>
-#else
-#include "CurrentTime.h"
 #endif
 
 #if PLATFORM(BREWMP)
@@ -49,12 +52,6 @@ using namespace std;
 
 namespace JSC {
 
-// Number of ticks before the first timeout check is done.
-static const int ticksUntilFirstCheck = 1024;
-
-// Number of milliseconds between each timeout check.
-static const int intervalBetweenChecks = 1000;
-
 // Returns the time the current thread has spent executing, in milliseconds.
 static inline unsigned getCPUTime()
 {
@@ -105,53 +102,191 @@ static inline unsigned getCPUTime()
 #endif
 }
 
+// One thread serves every TimeoutChecker in the process. It sleeps until the
+// earliest deadline among the armed checkers, and when a deadline passes it
+// raises that checker's interrupt flag.
+//
+// Checkers arm and disarm on every entry into JavaScript, so they do that
+// without the lock: they publish the deadline through their generation, and
+// only wake the thread when the new deadline is earlier than the one it sleeps
+// until. The lock is only for registering checkers and for sleeping.
+class Watchdog {
+    WTF_MAKE_NONCOPYABLE(Watchdog); WTF_MAKE_FAST_ALLOCATED;
+public:
+    Watchdog()
+        : m_thread(0)
+        , m_wakeUpTime(numeric_limits<double>::infinity())
+        , m_scanCount(0)
+    {
+    }
+
+    void add(TimeoutChecker* checker)
+    {
+        MutexLocker locker(m_lock);
+        m_checkers.append(checker);
+
+        if (!m_thread) {
+            m_thread = createThread(threadEntryPoint, this, "JSC::Watchdog");
+            detachThread(m_thread);
+        }
+    }
+
+    void remove(TimeoutChecker* checker)
+    {
+        MutexLocker locker(m_lock);
+        size_t index = m_checkers.find(checker);
+        if (index != notFound)
+            m_checkers.remove(index);
+    }
+
+    void arm(TimeoutChecker* checker, double deadline)
+    {
+        ASSERT(!checker->isArmed());
+        checker->m_deadline = deadline;
+#if USE(LOCKFREE_THREADSAFEREFCOUNTED)
+        // The increment is a full barrier: the deadline is visible before the
+        // generation, and either the next scan sees the generation or we see
+        // the infinite wake-up time that run() sets before scanning.
+        atomicIncrement(&checker->m_generation);
+        if (deadline < m_wakeUpTime) {
+            MutexLocker locker(m_lock);
+            m_condition.signal();
+        }
+#else
+        MutexLocker locker(m_lock);
+        ++checker->m_generation;
+        if (deadline < m_wakeUpTime)
+            m_condition.signal();
+#endif
+    }
+
+    void disarm(TimeoutChecker* checker)
+    {
+        ASSERT(checker->isArmed());
+        // If the watchdog still sees the old generation, it may fire for it,
+        // which didTimeOut() then ignores.
+        checker->m_generation = checker->m_generation + 1;
+    }
+
+private:
+    static void* threadEntryPoint(void* watchdog)
+    {
+        static_cast<Watchdog*>(watchdog)->run();
+        return 0;
+    }
+
+    void run()
+    {
+        MutexLocker locker(m_lock);
+        while (true) {
+            m_wakeUpTime = numeric_limits<double>::infinity();
+#if USE(LOCKFREE_THREADSAFEREFCOUNTED)
+            atomicIncrement(&m_scanCount); // Pairs with the barrier in arm().
+#endif
+
+            double now = currentTime();
+            double nextDeadline = numeric_limits<double>::infinity();
+            for (size_t i = 0; i < m_checkers.size(); ++i) {
+                TimeoutChecker* checker = m_checkers[i];
+                int generation = checker->m_generation;
+                if (!(generation & 1) || checker->m_firedGeneration == generation)
+                    continue;
+                double deadline = checker->m_deadline;
+                if (deadline > now) {
+                    nextDeadline = min(nextDeadline, deadline);
+                    continue;
+                }
+                checker->m_firedGeneration = generation;
+                checker->requestInterrupt();
+            }
+
+            m_wakeUpTime = nextDeadline;
+            if (nextDeadline == numeric_limits<double>::infinity())
+                m_condition.wait(m_lock);
+            else
+                m_condition.timedWait(m_lock, nextDeadline);
+        }
+    }
+
+    ThreadIdentifier m_thread;
+    Mutex m_lock;
+    ThreadCondition m_condition;
+    Vector<TimeoutChecker*> m_checkers;
+
+    // Infinity while scanning, so that arm() wakes us for any deadline the
+    // scan might have missed.
+    volatile double m_wakeUpTime;
+    int m_scanCount;
+};
+
+static Watchdog& watchdog()
+{
+    AtomicallyInitializedStatic(Watchdog&, watchdog = *new Watchdog);
+    return watchdog;
+}
+
 TimeoutChecker::TimeoutChecker()
-    : m_timeoutInterval(0)
+    : m_interruptRequested(false)
+    , m_timeoutInterval(0)
     , m_startCount(0)
+    , m_cpuTimeAtStart(0)
+    , m_isRegistered(false)
+    , m_deadline(0)
+    , m_generation(0)
+    , m_firedGeneration(0)
 {
-    reset();
 }
 
-void TimeoutChecker::reset()
+TimeoutChecker::~TimeoutChecker()
 {
-    m_ticksUntilNextCheck = ticksUntilFirstCheck;
-    m_timeAtLastCheck = 0;
-    m_timeExecuting = 0;
+    disarm();
+    if (m_isRegistered)
+        watchdog().remove(this);
+}
+
+void TimeoutChecker::arm()
+{
+    if (!m_timeoutInterval)
+        return;
+    m_cpuTimeAtStart = getCPUTime();
+    scheduleWatchdog(m_timeoutInterval);
+}
+
+void TimeoutChecker::disarm()
+{
+    if (isArmed())
+        watchdog().disarm(this);
+}
+
+void TimeoutChecker::scheduleWatchdog(unsigned milliseconds)
+{
+    if (!m_isRegistered) {
+        watchdog().add(this);
+        m_isRegistered = true;
+    }
+    disarm();
+    watchdog().arm(this, currentTime() + milliseconds / 1000.0);
 }
 
 bool TimeoutChecker::didTimeOut(ExecState* exec)
 {
-    unsigned currentTime = getCPUTime();
-    
-    if (!m_timeAtLastCheck) {
-        // Suspicious amount of looping in a script -- start timing it
-        m_timeAtLastCheck = currentTime;
+    if (!isArmed() || m_firedGeneration != m_generation)
+        return false;
+    disarm();
+
+    // The deadline is in wall clock time, but the limit is on the time spent
+    // running; if the thread was blocked for part of the interval, wait out the rest.
+    unsigned timeExecuting = getCPUTime() - m_cpuTimeAtStart;
+    if (timeExecuting < m_timeoutInterval) {
+        scheduleWatchdog(m_timeoutInterval - timeExecuting);
         return false;
     }
-    
-    unsigned timeDiff = currentTime - m_timeAtLastCheck;
-    
-    if (timeDiff == 0)
-        timeDiff = 1;
-    
-    m_timeExecuting += timeDiff;
-    m_timeAtLastCheck = currentTime;
-    
-    // Adjust the tick threshold so we get the next checkTimeout call in the
-    // interval specified in intervalBetweenChecks.
-    m_ticksUntilNextCheck = static_cast<unsigned>((static_cast<float>(intervalBetweenChecks) / timeDiff) * m_ticksUntilNextCheck);
-    // If the new threshold is 0 reset it to the default threshold. This can happen if the timeDiff is higher than the
-    // preferred script check time interval.
-    if (m_ticksUntilNextCheck == 0)
-        m_ticksUntilNextCheck = ticksUntilFirstCheck;
-    
-    if (m_timeoutInterval && m_timeExecuting > m_timeoutInterval) {
-        if (exec->dynamicGlobalObject()->shouldInterruptScript())
-            return true;
-        
-        reset();
-    }
-    
+
+    if (exec->dynamicGlobalObject()->shouldInterruptScript())
+        return true;
+
+    // The script was allowed to go on; give it another full interval.
+    arm();
     return false;
 }
 
@@ -30,43 +30,76 @@
 #define TimeoutChecker_h
 
 #include <wtf/Assertions.h>
+#include <wtf/Noncopyable.h>
 
 namespace JSC {
 
     class ExecState;
 
+    // Running code polls a single flag at loop back-edges; it is raised from
+    // other threads whenever the script should stop at its next safe point:
+    // a per-process watchdog thread raises it when the time limit of a
+    // started checker runs out, and the Terminator and the SamplingProfiler
+    // raise it for their own reasons. Whoever sees the flag clears it with
+    // clearInterruptRequest() before looking at the reasons, so that a
+    // request arriving meanwhile is never lost.
     class TimeoutChecker {
+        WTF_MAKE_NONCOPYABLE(TimeoutChecker);
     public:
         TimeoutChecker();
+        ~TimeoutChecker();
 
+        // In milliseconds of CPU time; 0 means no limit. Takes effect the next
+        // time the outermost start() is called.
         void setTimeoutInterval(unsigned timeoutInterval) { m_timeoutInterval = timeoutInterval; }
         unsigned timeoutInterval() const { return m_timeoutInterval; }
-        
-        unsigned ticksUntilNextCheck() { return m_ticksUntilNextCheck; }
-        
+
         void start()
         {
             if (!m_startCount)
-                reset();
+                arm();
             ++m_startCount;
         }
 
         void stop()
         {
             ASSERT(m_startCount);
-            --m_startCount;
+            if (!--m_startCount)
+                disarm();
         }
 
-        void reset();
+        bool interruptRequested() const { return m_interruptRequested; }
+        void* addressOfInterruptRequested() { return const_cast<bool*>(&m_interruptRequested); }
+        void requestInterrupt() { m_interruptRequested = true; }
+        void clearInterruptRequest() { m_interruptRequested = false; }
 
+        // Returns true if the time limit has run out and the script should be
+        // interrupted. Does not clear the interrupt request.
         bool didTimeOut(ExecState*);
 
     private:
+        friend class Watchdog;
+
+        void arm();
+        void disarm();
+        void scheduleWatchdog(unsigned milliseconds);
+        bool isArmed() const { return m_generation & 1; }
+
+        volatile bool m_interruptRequested;
+
         unsigned m_timeoutInterval;
-        unsigned m_timeAtLastCheck;
-        unsigned m_timeExecuting;
         unsigned m_startCount;
-        unsigned m_ticksUntilNextCheck;
+        unsigned m_cpuTimeAtStart;
+        bool m_isRegistered;
+
+        // Only this checker's thread writes the deadline and the generation, and
+        // the watchdog polls them without a lock. The generation is odd while the
+        // checker is armed and moves on with every arm and disarm; the watchdog
+        // stores the generation it fired for, so a late firing for a deadline
+        // that has since been replaced is ignored.
+        double m_deadline;
+        volatile int m_generation;
+        volatile int m_firedGeneration;
     };
 
 } // namespace JSC
@@ -221,6 +221,9 @@ bool operator==(const UString& s1, const char *s2)
     if (s2 == 0)
         return s1.isEmpty();
 
+    if (s1.impl() && s1.impl()->is8Bit())
+        return WTF::equal(s1.impl(), s2);
+
     const UChar* u = s1.characters();
     const UChar* uend = u + s1.length();
     while (u != uend && *s2) {
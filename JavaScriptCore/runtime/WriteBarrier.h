@@ -27,11 +27,32 @@
 #define WriteBarrier_h
 
 #include "JSValue.h"
+#if ENABLE(REMEMBERED_SET)
+#include "MarkedBlock.h"
+#endif
 
 namespace JSC {
 class JSCell;
 class JSGlobalData;
 
+#if ENABLE(REMEMBERED_SET)
+// The owner's block joins the remembered set, so the next young collection, or
+// the end of the current incremental one, looks inside it for pointers to
+// cells that have not been marked.
+inline void writeBarrier(JSGlobalData&, const JSCell* owner, JSValue value)
+{
+    ASSERT(owner);
+    if (value.isCell())
+        MarkedBlock::blockFor(owner)->remember();
+}
+
+inline void writeBarrier(JSGlobalData&, const JSCell* owner, JSCell* value)
+{
+    ASSERT(owner);
+    if (value)
+        MarkedBlock::blockFor(owner)->remember();
+}
+#else
 inline void writeBarrier(JSGlobalData&, const JSCell*, JSValue)
 {
 }
@@ -39,6 +60,7 @@ inline void writeBarrier(JSGlobalData&, const JSCell*, JSValue)
 inline void writeBarrier(JSGlobalData&, const JSCell*, JSCell*)
 {
 }
+#endif
 
 typedef enum { } Unknown;
 typedef JSValue* HandleSlot;
@@ -35,6 +35,7 @@ public:
     bool isEmpty();
 
     Node* head();
+    Node* tail();
 
     void append(Node*);
     void remove(Node*);
@@ -60,6 +61,11 @@ template <typename Node> inline Node* DoublyLinkedList<Node>::head()
     return m_head;
 }
 
+template <typename Node> inline Node* DoublyLinkedList<Node>::tail()
+{
+    return m_tail;
+}
+
 template <typename Node> inline void DoublyLinkedList<Node>::append(Node* node)
 {
     if (!m_tail) {
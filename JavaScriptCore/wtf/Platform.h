@@ -1185,6 +1185,27 @@
 
 #define ENABLE_JSC_ZOMBIES 0
 
+/* Generational collection: most collections keep the marks of cells that survived an earlier one
+   and trace only from the roots and from blocks written through a WriteBarrier since then. Every
+   store of a cell pointer into the heap, including those from JIT code, must go through a barrier.
+   Not every such store has been audited yet, so ports opt in by defining ENABLE_GGC. */
+#if !defined(ENABLE_GGC)
+#define ENABLE_GGC 0
+#endif
+
+/* Incremental marking: when Heap::setMarkingPauseBudget() is given a budget, a collection
+   triggered by allocation traces the heap in slices of at most that long, interleaved with
+   the program, and relies on the same write barriers to revisit cells written in between.
+   It needs the same barrier audit as ENABLE_GGC, so it is opt-in too, and the budget stays
+   zero until the embedder sets one. */
+#if !defined(ENABLE_INCREMENTAL_MARKING)
+#define ENABLE_INCREMENTAL_MARKING 0
+#endif
+
+#if ENABLE(GGC) || ENABLE(INCREMENTAL_MARKING)
+#define ENABLE_REMEMBERED_SET 1
+#endif
+
 /* FIXME: Eventually we should enable this for all platforms and get rid of the define. */
 #if PLATFORM(MAC) || PLATFORM(WIN) || PLATFORM(QT)
 #define WTF_USE_PLATFORM_STRATEGIES 1
@@ -1213,6 +1234,15 @@
 #define ENABLE_PARALLEL_JOBS 1
 #endif
 
+#if !defined(ENABLE_COMPARE_AND_SWAP) && (OS(WINDOWS) || (COMPILER(GCC) && GCC_VERSION_AT_LEAST(4, 1, 0) && !OS(SYMBIAN)))
+#define ENABLE_COMPARE_AND_SWAP 1
+#endif
+
+/* Parallel marking needs threads for the helpers and an atomic compare-and-swap for the mark bits. */
+#if !defined(ENABLE_PARALLEL_GC) && (PLATFORM(MAC) || PLATFORM(QT)) && ENABLE(JSC_MULTIPLE_THREADS) && ENABLE(COMPARE_AND_SWAP)
+#define ENABLE_PARALLEL_GC 1
+#endif
+
 #if ENABLE(GLIB_SUPPORT)
 #include "GTypedefs.h"
 #endif
@@ -158,6 +158,11 @@ private:
         return static_cast<unsigned char>(ch);
     }
 
+    static inline UChar defaultCoverter(LChar ch)
+    {
+        return ch;
+    }
+
     inline void addCharactersToHash(UChar a, UChar b)
     {
         m_hash += a;
@@ -92,6 +92,9 @@ struct CStringTranslator {
 
     static bool equal(StringImpl* r, const char* s)
     {
+        if (r->is8Bit())
+            return WTF::equal(r, s);
+
         int length = r->length();
         const UChar* d = r->characters();
         for (int i = 0; i != length; ++i) {
@@ -104,7 +107,7 @@ struct CStringTranslator {
 
     static void translate(StringImpl*& location, const char* const& c, unsigned hash)
     {
-        location = StringImpl::create(c).leakRef();
+        location = StringImpl::create(reinterpret_cast<const LChar*>(c), strlen(c)).leakRef();
         location->setHash(hash);
         location->setIsAtomic(true);
     }
@@ -140,6 +143,15 @@ static inline bool equal(StringImpl* string, const UChar* characters, unsigned l
     if (string->length() != length)
         return false;
 
+    if (string->is8Bit()) {
+        const LChar* stringCharacters = string->characters8();
+        for (unsigned i = 0; i != length; ++i) {
+            if (stringCharacters[i] != characters[i])
+                return false;
+        }
+        return true;
+    }
+
     // FIXME: perhaps we should have a more abstract macro that indicates when
     // going 4 bytes at a time is unsafe
 #if CPU(ARM) || CPU(SH4) || CPU(MIPS) || CPU(SPARC)
@@ -186,7 +198,7 @@ struct UCharBufferTranslator {
 
     static void translate(StringImpl*& location, const UCharBuffer& buf, unsigned hash)
     {
-        location = StringImpl::create(buf.s, buf.length).leakRef();
+        location = StringImpl::create8BitIfPossible(buf.s, buf.length).leakRef();
         location->setHash(hash);
         location->setIsAtomic(true);
     }
@@ -212,7 +224,7 @@ struct HashAndCharactersTranslator {
 
     static void translate(StringImpl*& location, const HashAndCharacters& buffer, unsigned hash)
     {
-        location = StringImpl::create(buffer.characters, buffer.length).leakRef();
+        location = StringImpl::create8BitIfPossible(buffer.characters, buffer.length).leakRef();
         location->setHash(hash);
         location->setIsAtomic(true);
     }
@@ -236,6 +248,9 @@ struct HashAndUTF8CharactersTranslator {
         if (buffer.utf16Length != string->length())
             return false;
 
+        if (string->is8Bit() && buffer.utf16Length == buffer.length)
+            return !memcmp(string->characters8(), buffer.characters, buffer.length);
+
         const UChar* stringCharacters = string->characters();
 
         // If buffer contains only ASCII characters UTF-8 and UTF16 length are the same.
@@ -253,6 +268,15 @@ struct HashAndUTF8CharactersTranslator {
 
     static void translate(StringImpl*& location, const HashAndUTF8Characters& buffer, unsigned hash)
     {
+        if (buffer.utf16Length == buffer.length) {
+            LChar* data;
+            location = StringImpl::createUninitialized(buffer.length, data).leakRef();
+            memcpy(data, buffer.characters, buffer.length);
+            location->setHash(hash);
+            location->setIsAtomic(true);
+            return;
+        }
+
         UChar* target;
         location = StringImpl::createUninitialized(buffer.utf16Length, target).releaseRef();
 
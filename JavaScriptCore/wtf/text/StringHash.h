@@ -23,6 +23,7 @@
 #define StringHash_h
 
 #include "AtomicString.h"
+#include "StringKernels.h"
 #include "WTFString.h"
 #include <wtf/Forward.h>
 #include <wtf/HashTraits.h>
@@ -53,6 +54,12 @@ namespace WTF {
             if (aLength != bLength)
                 return false;
 
+            if (a->is8Bit() || b->is8Bit())
+                return equalWith8BitCharacters(a, b);
+
+            if (aLength >= minimumLengthForStringKernels)
+                return equalCharacters(a->characters(), b->characters(), aLength);
+
             // FIXME: perhaps we should have a more abstract macro that indicates when
             // going 4 bytes at a time is unsafe
 #if CPU(ARM) || CPU(SH4) || CPU(MIPS) || CPU(SPARC)
@@ -126,7 +133,7 @@ namespace WTF {
             unsigned length = a->length();
             if (length != b->length())
                 return false;
-            return WTF::Unicode::umemcasecmp(a->characters(), b->characters(), length) == 0;
+            return equalCharactersIgnoringCase(a->characters(), b->characters(), length);
         }
 
         static unsigned hash(const RefPtr<StringImpl>& key) 
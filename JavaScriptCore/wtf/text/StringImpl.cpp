@@ -28,6 +28,7 @@
 #include "AtomicString.h"
 #include "StringBuffer.h"
 #include "StringHash.h"
+#include "StringKernels.h"
 #include <wtf/StdLibExtras.h>
 #include <wtf/WTFThreadData.h>
 
@@ -54,6 +55,13 @@ StringImpl::~StringImpl()
     }
 #endif
 
+    if (is8Bit()) {
+        ASSERT(bufferOwnership() == BufferInternal);
+        if (m_data)
+            fastFree(const_cast<UChar*>(m_data));
+        return;
+    }
+
     BufferOwnership ownership = bufferOwnership();
     if (ownership != BufferInternal) {
         if (ownership == BufferOwned) {
@@ -90,6 +98,66 @@ PassRefPtr<StringImpl> StringImpl::createUninitialized(unsigned length, UChar*&
     return adoptRef(new (string) StringImpl(length));
 }
 
+PassRefPtr<StringImpl> StringImpl::createUninitialized(unsigned length, LChar*& data)
+{
+    if (!length) {
+        data = 0;
+        return empty();
+    }
+
+    if (length > ((std::numeric_limits<unsigned>::max() - sizeof(StringImpl)) / sizeof(LChar)))
+        CRASH();
+    size_t size = sizeof(StringImpl) + length * sizeof(LChar);
+    StringImpl* string = static_cast<StringImpl*>(fastMalloc(size));
+
+    data = reinterpret_cast<LChar*>(string + 1);
+    return adoptRef(new (string) StringImpl(length, Force8BitConstructor));
+}
+
+PassRefPtr<StringImpl> StringImpl::create(const LChar* characters, unsigned length)
+{
+    if (!characters || !length)
+        return empty();
+
+    LChar* data;
+    RefPtr<StringImpl> string = createUninitialized(length, data);
+    memcpy(data, characters, length * sizeof(LChar));
+    return string.release();
+}
+
+PassRefPtr<StringImpl> StringImpl::create8BitIfPossible(const UChar* characters, unsigned length)
+{
+    if (!characters || !length)
+        return empty();
+
+    UChar ored = 0;
+    for (unsigned i = 0; i < length; ++i)
+        ored |= characters[i];
+    if (ored & ~0xFF)
+        return create(characters, length);
+
+    LChar* data;
+    RefPtr<StringImpl> string = createUninitialized(length, data);
+    for (unsigned i = 0; i < length; ++i)
+        data[i] = static_cast<LChar>(characters[i]);
+    return string.release();
+}
+
+const UChar* StringImpl::upconvertCharacters() const
+{
+    ASSERT(is8Bit());
+    ASSERT(!m_data);
+
+    if (m_length > numeric_limits<unsigned>::max() / sizeof(UChar))
+        CRASH();
+    UChar* data = static_cast<UChar*>(fastMalloc(m_length * sizeof(UChar)));
+    const LChar* source = characters8();
+    for (unsigned i = 0; i < m_length; ++i)
+        data[i] = source[i];
+    const_cast<StringImpl*>(this)->m_data = data;
+    return data;
+}
+
 PassRefPtr<StringImpl> StringImpl::create(const UChar* characters, unsigned length)
 {
     if (!characters || !length)
@@ -161,8 +229,18 @@ bool StringImpl::containsOnlyWhitespace()
     // FIXME: The definition of whitespace here includes a number of characters
     // that are not whitespace from the point of view of RenderText; I wonder if
     // that's a problem in practice.
+    if (is8Bit()) {
+        const LChar* characters = characters8();
+        for (unsigned i = 0; i < m_length; i++) {
+            if (!isASCIISpace(characters[i]))
+                return false;
+        }
+        return true;
+    }
+
+    const UChar* characters = this->characters();
     for (unsigned i = 0; i < m_length; i++)
-        if (!isASCIISpace(m_data[i]))
+        if (!isASCIISpace(characters[i]))
             return false;
     return true;
 }
@@ -177,11 +255,15 @@ PassRefPtr<StringImpl> StringImpl::substring(unsigned start, unsigned length)
             return this;
         length = maxLength;
     }
-    return create(m_data + start, length);
+    if (is8Bit())
+        return create(characters8() + start, length);
+    return create(characters() + start, length);
 }
 
 UChar32 StringImpl::characterStartingAt(unsigned i)
 {
+    if (is8Bit())
+        return characters8()[i];
     if (U16_IS_SINGLE(m_data[i]))
         return m_data[i];
     if (i + 1 < m_length && U16_IS_LEAD(m_data[i]) && U16_IS_TRAIL(m_data[i + 1]))
@@ -194,11 +276,34 @@ PassRefPtr<StringImpl> StringImpl::lower()
     // Note: This is a hot function in the Dromaeo benchmark, specifically the
     // no-op code path up through the first 'return' statement.
     
+    if (is8Bit()) {
+        // Tag and attribute names are usually 8-bit, and usually already lowercase.
+        const LChar* characters = characters8();
+        LChar ored = 0;
+        bool noUpper = true;
+        for (unsigned i = 0; i < m_length; ++i) {
+            if (UNLIKELY(isASCIIUpper(characters[i])))
+                noUpper = false;
+            ored |= characters[i];
+        }
+        if (!(ored & ~0x7F)) {
+            if (noUpper)
+                return this;
+            LChar* data;
+            RefPtr<StringImpl> newImpl = createUninitialized(m_length, data);
+            for (unsigned i = 0; i < m_length; ++i)
+                data[i] = toASCIILower(characters[i]);
+            return newImpl.release();
+        }
+    }
+
+    const UChar* characters = this->characters();
+
     // First scan the string for uppercase and non-ASCII characters:
     UChar ored = 0;
     bool noUpper = true;
-    const UChar *end = m_data + m_length;
-    for (const UChar* chp = m_data; chp != end; chp++) {
+    const UChar *end = characters + m_length;
+    for (const UChar* chp = characters; chp != end; chp++) {
         if (UNLIKELY(isASCIIUpper(*chp)))
             noUpper = false;
         ored |= *chp;
@@ -218,7 +323,7 @@ PassRefPtr<StringImpl> StringImpl::lower()
     if (!(ored & ~0x7F)) {
         // Do a faster loop for the case where all the characters are ASCII.
         for (int i = 0; i < length; i++) {
-            UChar c = m_data[i];
+            UChar c = characters[i];
             data[i] = toASCIILower(c);
         }
         return newImpl;
@@ -226,11 +331,11 @@ PassRefPtr<StringImpl> StringImpl::lower()
     
     // Do a slower implementation for cases that include non-ASCII characters.
     bool error;
-    int32_t realLength = Unicode::toLower(data, length, m_data, m_length, &error);
+    int32_t realLength = Unicode::toLower(data, length, characters, m_length, &error);
     if (!error && realLength == length)
         return newImpl;
     newImpl = createUninitialized(realLength, data);
-    Unicode::toLower(data, realLength, m_data, m_length, &error);
+    Unicode::toLower(data, realLength, characters, m_length, &error);
     if (error)
         return this;
     return newImpl;
@@ -241,6 +346,7 @@ PassRefPtr<StringImpl> StringImpl::upper()
     // This function could be optimized for no-op cases the way lower() is,
     // but in empirical testing, few actual calls to upper() are no-ops, so
     // it wouldn't be worth the extra time for pre-scanning.
+    const UChar* characters = this->characters();
     UChar* data;
     RefPtr<StringImpl> newImpl = createUninitialized(m_length, data);
 
@@ -251,7 +357,7 @@ PassRefPtr<StringImpl> StringImpl::upper()
     // Do a faster loop for the case where all the characters are ASCII.
     UChar ored = 0;
     for (int i = 0; i < length; i++) {
-        UChar c = m_data[i];
+        UChar c = characters[i];
         ored |= c;
         data[i] = toASCIIUpper(c);
     }
@@ -260,11 +366,11 @@ PassRefPtr<StringImpl> StringImpl::upper()
 
     // Do a slower implementation for cases that include non-ASCII characters.
     bool error;
-    int32_t realLength = Unicode::toUpper(data, length, m_data, m_length, &error);
+    int32_t realLength = Unicode::toUpper(data, length, characters, m_length, &error);
     if (!error && realLength == length)
         return newImpl;
     newImpl = createUninitialized(realLength, data);
-    Unicode::toUpper(data, realLength, m_data, m_length, &error);
+    Unicode::toUpper(data, realLength, characters, m_length, &error);
     if (error)
         return this;
     return newImpl.release();
@@ -284,6 +390,7 @@ PassRefPtr<StringImpl> StringImpl::fill(UChar character)
 
 PassRefPtr<StringImpl> StringImpl::foldCase()
 {
+    const UChar* characters = this->characters();
     UChar* data;
     RefPtr<StringImpl> newImpl = createUninitialized(m_length, data);
 
@@ -294,7 +401,7 @@ PassRefPtr<StringImpl> StringImpl::foldCase()
     // Do a faster loop for the case where all the characters are ASCII.
     UChar ored = 0;
     for (int32_t i = 0; i < length; i++) {
-        UChar c = m_data[i];
+        UChar c = characters[i];
         ored |= c;
         data[i] = toASCIILower(c);
     }
@@ -303,11 +410,11 @@ PassRefPtr<StringImpl> StringImpl::foldCase()
 
     // Do a slower implementation for cases that include non-ASCII characters.
     bool error;
-    int32_t realLength = Unicode::foldCase(data, length, m_data, m_length, &error);
+    int32_t realLength = Unicode::foldCase(data, length, characters, m_length, &error);
     if (!error && realLength == length)
         return newImpl.release();
     newImpl = createUninitialized(realLength, data);
-    Unicode::foldCase(data, realLength, m_data, m_length, &error);
+    Unicode::foldCase(data, realLength, characters, m_length, &error);
     if (error)
         return this;
     return newImpl.release();
@@ -315,6 +422,7 @@ PassRefPtr<StringImpl> StringImpl::foldCase()
 
 PassRefPtr<StringImpl> StringImpl::stripWhiteSpace()
 {
+    const UChar* characters = this->characters();
     if (!m_length)
         return empty();
 
@@ -322,7 +430,7 @@ PassRefPtr<StringImpl> StringImpl::stripWhiteSpace()
     unsigned end = m_length - 1;
     
     // skip white space from start
-    while (start <= end && isSpaceOrNewline(m_data[start]))
+    while (start <= end && isSpaceOrNewline(characters[start]))
         start++;
     
     // only white space
@@ -330,17 +438,18 @@ PassRefPtr<StringImpl> StringImpl::stripWhiteSpace()
         return empty();
 
     // skip white space from end
-    while (end && isSpaceOrNewline(m_data[end]))
+    while (end && isSpaceOrNewline(characters[end]))
         end--;
 
     if (!start && end == m_length - 1)
         return this;
-    return create(m_data + start, end + 1 - start);
+    return create(characters + start, end + 1 - start);
 }
 
 PassRefPtr<StringImpl> StringImpl::removeCharacters(CharacterMatchFunctionPtr findMatch)
 {
-    const UChar* from = m_data;
+    const UChar* characters = this->characters();
+    const UChar* from = characters;
     const UChar* fromend = from + m_length;
 
     // Assume the common case will not remove any characters
@@ -351,10 +460,10 @@ PassRefPtr<StringImpl> StringImpl::removeCharacters(CharacterMatchFunctionPtr fi
 
     StringBuffer data(m_length);
     UChar* to = data.characters();
-    unsigned outc = from - m_data;
+    unsigned outc = from - characters;
 
     if (outc)
-        memcpy(to, m_data, outc * sizeof(UChar));
+        memcpy(to, characters, outc * sizeof(UChar));
 
     while (true) {
         while (from != fromend && findMatch(*from))
@@ -372,9 +481,10 @@ PassRefPtr<StringImpl> StringImpl::removeCharacters(CharacterMatchFunctionPtr fi
 
 PassRefPtr<StringImpl> StringImpl::simplifyWhiteSpace()
 {
+    const UChar* characters = this->characters();
     StringBuffer data(m_length);
 
-    const UChar* from = m_data;
+    const UChar* from = characters;
     const UChar* fromend = from + m_length;
     int outc = 0;
     bool changedToSpace = false;
@@ -408,62 +518,62 @@ PassRefPtr<StringImpl> StringImpl::simplifyWhiteSpace()
 
 int StringImpl::toIntStrict(bool* ok, int base)
 {
-    return charactersToIntStrict(m_data, m_length, ok, base);
+    return charactersToIntStrict(characters(), m_length, ok, base);
 }
 
 unsigned StringImpl::toUIntStrict(bool* ok, int base)
 {
-    return charactersToUIntStrict(m_data, m_length, ok, base);
+    return charactersToUIntStrict(characters(), m_length, ok, base);
 }
 
 int64_t StringImpl::toInt64Strict(bool* ok, int base)
 {
-    return charactersToInt64Strict(m_data, m_length, ok, base);
+    return charactersToInt64Strict(characters(), m_length, ok, base);
 }
 
 uint64_t StringImpl::toUInt64Strict(bool* ok, int base)
 {
-    return charactersToUInt64Strict(m_data, m_length, ok, base);
+    return charactersToUInt64Strict(characters(), m_length, ok, base);
 }
 
 intptr_t StringImpl::toIntPtrStrict(bool* ok, int base)
 {
-    return charactersToIntPtrStrict(m_data, m_length, ok, base);
+    return charactersToIntPtrStrict(characters(), m_length, ok, base);
 }
 
 int StringImpl::toInt(bool* ok)
 {
-    return charactersToInt(m_data, m_length, ok);
+    return charactersToInt(characters(), m_length, ok);
 }
 
 unsigned StringImpl::toUInt(bool* ok)
 {
-    return charactersToUInt(m_data, m_length, ok);
+    return charactersToUInt(characters(), m_length, ok);
 }
 
 int64_t StringImpl::toInt64(bool* ok)
 {
-    return charactersToInt64(m_data, m_length, ok);
+    return charactersToInt64(characters(), m_length, ok);
 }
 
 uint64_t StringImpl::toUInt64(bool* ok)
 {
-    return charactersToUInt64(m_data, m_length, ok);
+    return charactersToUInt64(characters(), m_length, ok);
 }
 
 intptr_t StringImpl::toIntPtr(bool* ok)
 {
-    return charactersToIntPtr(m_data, m_length, ok);
+    return charactersToIntPtr(characters(), m_length, ok);
 }
 
 double StringImpl::toDouble(bool* ok, bool* didReadNumber)
 {
-    return charactersToDouble(m_data, m_length, ok, didReadNumber);
+    return charactersToDouble(characters(), m_length, ok, didReadNumber);
 }
 
 float StringImpl::toFloat(bool* ok, bool* didReadNumber)
 {
-    return charactersToFloat(m_data, m_length, ok, didReadNumber);
+    return charactersToFloat(characters(), m_length, ok, didReadNumber);
 }
 
 static bool equal(const UChar* a, const char* b, int length)
@@ -490,7 +600,7 @@ bool equalIgnoringCase(const UChar* a, const char* b, unsigned length)
 static inline bool equalIgnoringCase(const UChar* a, const UChar* b, int length)
 {
     ASSERT(length >= 0);
-    return umemcasecmp(a, b, length) == 0;
+    return equalCharactersIgnoringCase(a, b, length);
 }
 
 int codePointCompare(const StringImpl* s1, const StringImpl* s2)
@@ -516,14 +626,58 @@ int codePointCompare(const StringImpl* s1, const StringImpl* s2)
     return (l1 > l2) ? 1 : -1;
 }
 
+static size_t find8Bit(const LChar* characters, unsigned length, const LChar* matchCharacters, unsigned matchLength, unsigned index)
+{
+    ASSERT(matchLength);
+    if (index > length || matchLength > length - index)
+        return notFound;
+
+    const LChar* searchCharacters = characters + index;
+    // The last position a match can start at.
+    unsigned delta = length - index - matchLength;
+    LChar firstCharacter = matchCharacters[0];
+    for (unsigned i = 0; i <= delta; ++i) {
+        const void* match = memchr(searchCharacters + i, firstCharacter, delta - i + 1);
+        if (!match)
+            return notFound;
+        i = static_cast<const LChar*>(match) - searchCharacters;
+        if (!memcmp(searchCharacters + i + 1, matchCharacters + 1, matchLength - 1))
+            return index + i;
+    }
+    return notFound;
+}
+
+static size_t reverseFind8Bit(const LChar* characters, unsigned length, const LChar* matchCharacters, unsigned matchLength, unsigned index)
+{
+    ASSERT(matchLength);
+    if (matchLength > length)
+        return notFound;
+
+    unsigned delta = min(index, length - matchLength);
+    LChar firstCharacter = matchCharacters[0];
+    while (characters[delta] != firstCharacter || memcmp(characters + delta + 1, matchCharacters + 1, matchLength - 1)) {
+        if (!delta)
+            return notFound;
+        --delta;
+    }
+    return delta;
+}
+
 size_t StringImpl::find(UChar c, unsigned start)
 {
-    return WTF::find(m_data, m_length, c, start);
+    if (is8Bit()) {
+        if (c & ~0xFF || start >= m_length)
+            return notFound;
+        const LChar* characters = characters8();
+        const void* match = memchr(characters + start, c, m_length - start);
+        return match ? static_cast<const LChar*>(match) - characters : notFound;
+    }
+    return findCharacter(characters(), m_length, c, start);
 }
 
 size_t StringImpl::find(CharacterMatchFunctionPtr matchFunction, unsigned start)
 {
-    return WTF::find(m_data, m_length, matchFunction, start);
+    return WTF::find(characters(), m_length, matchFunction, start);
 }
 
 size_t StringImpl::find(const char* matchString, unsigned index)
@@ -538,6 +692,9 @@ size_t StringImpl::find(const char* matchString, unsigned index)
     if (!matchLength)
         return min(index, length());
 
+    if (is8Bit())
+        return find8Bit(characters8(), length(), reinterpret_cast<const LChar*>(matchString), matchLength, index);
+
     // Optimization 1: fast case for strings of length 1.
     if (matchLength == 1)
         return WTF::find(characters(), length(), *(const unsigned char*)matchString, index);
@@ -617,41 +774,10 @@ size_t StringImpl::find(StringImpl* matchString, unsigned index)
     if (!matchLength)
         return min(index, length());
 
-    // Optimization 1: fast case for strings of length 1.
-    if (matchLength == 1)
-        return WTF::find(characters(), length(), matchString->characters()[0], index);
+    if (is8Bit() && matchString->is8Bit())
+        return find8Bit(characters8(), length(), matchString->characters8(), matchLength, index);
 
-    // Check index & matchLength are in range.
-    if (index > length())
-        return notFound;
-    unsigned searchLength = length() - index;
-    if (matchLength > searchLength)
-        return notFound;
-    // delta is the number of additional times to test; delta == 0 means test only once.
-    unsigned delta = searchLength - matchLength;
-
-    const UChar* searchCharacters = characters() + index;
-    const UChar* matchCharacters = matchString->characters();
-
-    // Optimization 2: keep a running hash of the strings,
-    // only call memcmp if the hashes match.
-    unsigned searchHash = 0;
-    unsigned matchHash = 0;
-    for (unsigned i = 0; i < matchLength; ++i) {
-        searchHash += searchCharacters[i];
-        matchHash += matchCharacters[i];
-    }
-
-    unsigned i = 0;
-    // keep looping until we match
-    while (searchHash != matchHash || memcmp(searchCharacters + i, matchCharacters, matchLength * sizeof(UChar))) {
-        if (i == delta)
-            return notFound;
-        searchHash += searchCharacters[i + matchLength];
-        searchHash -= searchCharacters[i];
-        ++i;
-    }
-    return index + i;
+    return findCharacters(characters(), length(), matchString->characters(), matchLength, index);
 }
 
 size_t StringImpl::findIgnoringCase(StringImpl* matchString, unsigned index)
@@ -687,7 +813,13 @@ size_t StringImpl::findIgnoringCase(StringImpl* matchString, unsigned index)
 
 size_t StringImpl::reverseFind(UChar c, unsigned index)
 {
-    return WTF::reverseFind(m_data, m_length, c, index);
+    if (is8Bit()) {
+        if (c & ~0xFF || !m_length)
+            return notFound;
+        LChar matchCharacter = c;
+        return reverseFind8Bit(characters8(), m_length, &matchCharacter, 1, index);
+    }
+    return WTF::reverseFind(characters(), m_length, c, index);
 }
 
 size_t StringImpl::reverseFind(StringImpl* matchString, unsigned index)
@@ -699,6 +831,9 @@ size_t StringImpl::reverseFind(StringImpl* matchString, unsigned index)
     if (!matchLength)
         return min(index, length());
 
+    if (is8Bit() && matchString->is8Bit())
+        return reverseFind8Bit(characters8(), length(), matchString->characters8(), matchLength, index);
+
     // Optimization 1: fast case for strings of length 1.
     if (matchLength == 1)
         return WTF::reverseFind(characters(), length(), matchString->characters()[0], index);
@@ -773,9 +908,10 @@ PassRefPtr<StringImpl> StringImpl::replace(UChar oldC, UChar newC)
 {
     if (oldC == newC)
         return this;
+    const UChar* characters = this->characters();
     unsigned i;
     for (i = 0; i != m_length; ++i)
-        if (m_data[i] == oldC)
+        if (characters[i] == oldC)
             break;
     if (i == m_length)
         return this;
@@ -784,7 +920,7 @@ PassRefPtr<StringImpl> StringImpl::replace(UChar oldC, UChar newC)
     RefPtr<StringImpl> newImpl = createUninitialized(m_length, data);
 
     for (i = 0; i != m_length; ++i) {
-        UChar ch = m_data[i];
+        UChar ch = characters[i];
         if (ch == oldC)
             ch = newC;
         data[i] = ch;
@@ -816,6 +952,7 @@ PassRefPtr<StringImpl> StringImpl::replace(unsigned position, unsigned lengthToR
 
 PassRefPtr<StringImpl> StringImpl::replace(UChar pattern, StringImpl* replacement)
 {
+    const UChar* characters = this->characters();
     if (!replacement)
         return this;
         
@@ -854,15 +991,15 @@ PassRefPtr<StringImpl> StringImpl::replace(UChar pattern, StringImpl* replacemen
     
     while ((srcSegmentEnd = find(pattern, srcSegmentStart)) != notFound) {
         srcSegmentLength = srcSegmentEnd - srcSegmentStart;
-        memcpy(data + dstOffset, m_data + srcSegmentStart, srcSegmentLength * sizeof(UChar));
+        memcpy(data + dstOffset, characters + srcSegmentStart, srcSegmentLength * sizeof(UChar));
         dstOffset += srcSegmentLength;
-        memcpy(data + dstOffset, replacement->m_data, repStrLength * sizeof(UChar));
+        memcpy(data + dstOffset, replacement->characters(), repStrLength * sizeof(UChar));
         dstOffset += repStrLength;
         srcSegmentStart = srcSegmentEnd + 1;
     }
 
     srcSegmentLength = m_length - srcSegmentStart;
-    memcpy(data + dstOffset, m_data + srcSegmentStart, srcSegmentLength * sizeof(UChar));
+    memcpy(data + dstOffset, characters + srcSegmentStart, srcSegmentLength * sizeof(UChar));
 
     ASSERT(dstOffset + srcSegmentLength == newImpl->length());
 
@@ -871,6 +1008,7 @@ PassRefPtr<StringImpl> StringImpl::replace(UChar pattern, StringImpl* replacemen
 
 PassRefPtr<StringImpl> StringImpl::replace(StringImpl* pattern, StringImpl* replacement)
 {
+    const UChar* characters = this->characters();
     if (!pattern || !replacement)
         return this;
 
@@ -912,15 +1050,15 @@ PassRefPtr<StringImpl> StringImpl::replace(StringImpl* pattern, StringImpl* repl
     
     while ((srcSegmentEnd = find(pattern, srcSegmentStart)) != notFound) {
         srcSegmentLength = srcSegmentEnd - srcSegmentStart;
-        memcpy(data + dstOffset, m_data + srcSegmentStart, srcSegmentLength * sizeof(UChar));
+        memcpy(data + dstOffset, characters + srcSegmentStart, srcSegmentLength * sizeof(UChar));
         dstOffset += srcSegmentLength;
-        memcpy(data + dstOffset, replacement->m_data, repStrLength * sizeof(UChar));
+        memcpy(data + dstOffset, replacement->characters(), repStrLength * sizeof(UChar));
         dstOffset += repStrLength;
         srcSegmentStart = srcSegmentEnd + patternLength;
     }
 
     srcSegmentLength = m_length - srcSegmentStart;
-    memcpy(data + dstOffset, m_data + srcSegmentStart, srcSegmentLength * sizeof(UChar));
+    memcpy(data + dstOffset, characters + srcSegmentStart, srcSegmentLength * sizeof(UChar));
 
     ASSERT(dstOffset + srcSegmentLength == newImpl->length());
 
@@ -932,6 +1070,26 @@ bool equal(const StringImpl* a, const StringImpl* b)
     return StringHash::equal(a, b);
 }
 
+bool equalWith8BitCharacters(const StringImpl* a, const StringImpl* b)
+{
+    ASSERT(a->length() == b->length());
+    ASSERT(a->is8Bit() || b->is8Bit());
+
+    unsigned length = a->length();
+    if (a->is8Bit() && b->is8Bit())
+        return !memcmp(a->characters8(), b->characters8(), length * sizeof(LChar));
+
+    if (!a->is8Bit())
+        std::swap(a, b);
+    const LChar* aCharacters = a->characters8();
+    const UChar* bCharacters = b->characters();
+    for (unsigned i = 0; i != length; ++i) {
+        if (aCharacters[i] != bCharacters[i])
+            return false;
+    }
+    return true;
+}
+
 bool equal(const StringImpl* a, const char* b)
 {
     if (!a)
@@ -940,6 +1098,18 @@ bool equal(const StringImpl* a, const char* b)
         return !a;
 
     unsigned length = a->length();
+    if (a->is8Bit()) {
+        const LChar* as = a->characters8();
+        for (unsigned i = 0; i != length; ++i) {
+            LChar bc = b[i];
+            if (!bc)
+                return false;
+            if (as[i] != bc)
+                return false;
+        }
+        return !b[length];
+    }
+
     const UChar* as = a->characters();
     for (unsigned i = 0; i != length; ++i) {
         unsigned char bc = b[i];
@@ -1005,8 +1175,9 @@ bool equalIgnoringNullity(StringImpl* a, StringImpl* b)
 
 WTF::Unicode::Direction StringImpl::defaultWritingDirection(bool* hasStrongDirectionality)
 {
+    const UChar* characters = this->characters();
     for (unsigned i = 0; i < m_length; ++i) {
-        WTF::Unicode::Direction charDirection = WTF::Unicode::direction(m_data[i]);
+        WTF::Unicode::Direction charDirection = WTF::Unicode::direction(characters[i]);
         if (charDirection == WTF::Unicode::LeftToRight) {
             if (hasStrongDirectionality)
                 *hasStrongDirectionality = true;
@@ -1054,7 +1225,7 @@ PassRefPtr<StringImpl> StringImpl::createWithTerminatingNullCharacter(const Stri
     if (length >= numeric_limits<unsigned>::max())
         CRASH();
     RefPtr<StringImpl> terminatedString = createUninitialized(length + 1, data);
-    memcpy(data, string.m_data, length * sizeof(UChar));
+    memcpy(data, string.characters(), length * sizeof(UChar));
     data[length] = 0;
     terminatedString->m_length--;
     terminatedString->m_hash = string.m_hash;
@@ -1064,6 +1235,8 @@ PassRefPtr<StringImpl> StringImpl::createWithTerminatingNullCharacter(const Stri
 
 PassRefPtr<StringImpl> StringImpl::threadsafeCopy() const
 {
+    if (is8Bit())
+        return create(characters8(), m_length);
     return create(m_data, m_length);
 }
 
@@ -108,6 +108,19 @@ private:
         ASSERT(m_length);
     }
 
+    // Create an 8-bit string with internal storage (BufferInternal). The Latin-1 characters
+    // follow the object, and m_data stays null until a 16-bit copy is requested.
+    enum Force8Bit { Force8BitConstructor };
+    StringImpl(unsigned length, Force8Bit)
+        : StringImplBase(length, BufferInternal)
+        , m_data(0)
+        , m_buffer(0)
+        , m_hash(0)
+    {
+        ASSERT(m_length);
+        m_refCountAndFlags |= s_refCountFlagIs8Bit;
+    }
+
     // Used to create new strings that are a substring of an existing StringImpl (BufferSubstring)
     StringImpl(const UChar* characters, unsigned length, PassRefPtr<StringImpl> base)
         : StringImplBase(length, BufferSubstring)
@@ -136,7 +149,7 @@ private:
     {
         ASSERT(!isStatic());
         ASSERT(!m_hash);
-        ASSERT(hash == StringHasher::computeHash(m_data, m_length));
+        ASSERT(hash == (is8Bit() ? StringHasher::computeHash(characters8(), m_length) : StringHasher::computeHash(m_data, m_length)));
         m_hash = hash;
     }
 
@@ -144,6 +157,8 @@ public:
     ~StringImpl();
 
     static PassRefPtr<StringImpl> create(const UChar*, unsigned length);
+    static PassRefPtr<StringImpl> create(const LChar*, unsigned length);
+    static PassRefPtr<StringImpl> create8BitIfPossible(const UChar*, unsigned length);
     static PassRefPtr<StringImpl> create(const char*, unsigned length);
     static PassRefPtr<StringImpl> create(const char*);
     static PassRefPtr<StringImpl> create(const UChar*, unsigned length, PassRefPtr<SharedUChar> sharedBuffer);
@@ -155,11 +170,16 @@ public:
         if (!length)
             return empty();
 
+        // 8-bit strings only have internal storage, so substrings of them are copies.
+        if (rep->is8Bit())
+            return create(rep->characters8() + offset, length);
+
         StringImpl* ownerRep = (rep->bufferOwnership() == BufferSubstring) ? rep->m_substringBuffer : rep.get();
         return adoptRef(new StringImpl(rep->m_data + offset, length, ownerRep));
     }
 
     static PassRefPtr<StringImpl> createUninitialized(unsigned length, UChar*& data);
+    static PassRefPtr<StringImpl> createUninitialized(unsigned length, LChar*& data);
     static ALWAYS_INLINE PassRefPtr<StringImpl> tryCreateUninitialized(unsigned length, UChar*& output)
     {
         if (!length) {
@@ -198,7 +218,16 @@ public:
     static PassRefPtr<StringImpl> adopt(StringBuffer&);
 
     SharedUChar* sharedBuffer();
-    const UChar* characters() const { return m_data; }
+    bool is8Bit() const { return m_refCountAndFlags & s_refCountFlagIs8Bit; }
+    const LChar* characters8() const { ASSERT(is8Bit()); return reinterpret_cast<const LChar*>(this + 1); }
+
+    // 8-bit strings build their 16-bit copy on first use; it lives as long as the string.
+    const UChar* characters() const
+    {
+        if (UNLIKELY(!m_data))
+            return upconvertCharacters();
+        return m_data;
+    }
 
     size_t cost()
     {
@@ -213,6 +242,10 @@ public:
         return 0;
     }
 
+    // Substrings and strings made from a SharedUChar keep alive a buffer that may be much
+    // longer than the string itself.
+    bool sharesBuffer() const { return bufferOwnership() == BufferSubstring || bufferOwnership() == BufferShared; }
+
     bool isIdentifier() const { return m_refCountAndFlags & s_refCountFlagIsIdentifier; }
     void setIsIdentifier(bool isIdentifier)
     {
@@ -235,7 +268,7 @@ public:
             m_refCountAndFlags &= ~s_refCountFlagIsAtomic;
     }
 
-    unsigned hash() const { if (!m_hash) m_hash = StringHasher::computeHash(m_data, m_length); return m_hash; }
+    unsigned hash() const { if (!m_hash) m_hash = is8Bit() ? StringHasher::computeHash(characters8(), m_length) : StringHasher::computeHash(m_data, m_length); return m_hash; }
     unsigned existingHash() const { ASSERT(m_hash); return m_hash; }
 
     ALWAYS_INLINE void deref() { m_refCountAndFlags -= s_refCountIncrement; if (!(m_refCountAndFlags & (s_refCountMask | s_refCountFlagStatic))) delete this; }
@@ -261,7 +294,7 @@ public:
 
     PassRefPtr<StringImpl> substring(unsigned pos, unsigned len = UINT_MAX);
 
-    UChar operator[](unsigned i) { ASSERT(i < m_length); return m_data[i]; }
+    UChar operator[](unsigned i) { ASSERT(i < m_length); return is8Bit() ? characters8()[i] : m_data[i]; }
     UChar32 characterStartingAt(unsigned);
 
     bool containsOnlyWhitespace();
@@ -325,6 +358,7 @@ private:
     static const unsigned s_copyCharsInlineCutOff = 20;
 
     static PassRefPtr<StringImpl> createStrippingNullCharactersSlowCase(const UChar*, unsigned length);
+    const UChar* upconvertCharacters() const;
     
     BufferOwnership bufferOwnership() const { return static_cast<BufferOwnership>(m_refCountAndFlags & s_refCountMaskBufferOwnership); }
     bool isStatic() const { return m_refCountAndFlags & s_refCountFlagStatic; }
@@ -338,6 +372,7 @@ private:
 };
 
 bool equal(const StringImpl*, const StringImpl*);
+bool equalWith8BitCharacters(const StringImpl*, const StringImpl*);
 bool equal(const StringImpl*, const char*);
 inline bool equal(const char* a, StringImpl* b) { return equal(b, a); }
 
@@ -356,6 +391,14 @@ bool equalIgnoringNullity(const Vector<UChar, inlineCapacity>& a, StringImpl* b)
         return !a.size();
     if (a.size() != b->length())
         return false;
+    if (b->is8Bit()) {
+        const LChar* bCharacters = b->characters8();
+        for (unsigned i = 0; i < b->length(); ++i) {
+            if (a[i] != bCharacters[i])
+                return false;
+        }
+        return true;
+    }
     return !memcmp(a.data(), b->characters(), b->length());
 }
 
@@ -0,0 +1,477 @@
+/*
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "StringKernels.h"
+
+#include <string.h>
+#include <wtf/ASCIICType.h>
+
+// GCC only provides the SSE2 intrinsics when compiling for SSE2, so 32-bit x86 builds
+// without -msse2 use the scalar loops. MSVC always provides them; on 32-bit x86 the
+// processor is then checked at run time.
+#if CPU(X86_64) || (CPU(X86) && (defined(__SSE2__) || COMPILER(MSVC)))
+#define HAVE_SSE2_STRING_KERNELS 1
+#include <emmintrin.h>
+#if COMPILER(MSVC)
+#include <intrin.h>
+#endif
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+#define HAVE_NEON_STRING_KERNELS 1
+#include <arm_neon.h>
+#endif
+
+namespace WTF {
+
+using namespace Unicode;
+
+struct StringKernels {
+    const char* name;
+    size_t (*findCharacter)(const UChar*, unsigned length, UChar, unsigned start);
+    size_t (*findCharacters)(const UChar*, unsigned length, const UChar*, unsigned matchLength, unsigned start);
+    bool (*equal)(const UChar*, const UChar*, unsigned length);
+    bool (*equalIgnoringCase)(const UChar*, const UChar*, unsigned length);
+};
+
+// The kernels below may assume the arguments have already been range checked
+// by the public entry points: start < length for the single character search,
+// and 2 <= matchLength <= length - start for the substring search.
+
+static size_t findCharacterScalar(const UChar* characters, unsigned length, UChar matchCharacter, unsigned start)
+{
+    for (unsigned i = start; i < length; ++i) {
+        if (characters[i] == matchCharacter)
+            return i;
+    }
+    return notFound;
+}
+
+static size_t findCharactersScalar(const UChar* characters, unsigned length, const UChar* matchCharacters, unsigned matchLength, unsigned start)
+{
+    const UChar* searchCharacters = characters + start;
+    // delta is the number of additional times to test; delta == 0 means test only once.
+    unsigned delta = length - start - matchLength;
+
+    // Keep a running hash of the strings, only call memcmp if the hashes match.
+    unsigned searchHash = 0;
+    unsigned matchHash = 0;
+    for (unsigned i = 0; i < matchLength; ++i) {
+        searchHash += searchCharacters[i];
+        matchHash += matchCharacters[i];
+    }
+
+    unsigned i = 0;
+    // keep looping until we match
+    while (searchHash != matchHash || memcmp(searchCharacters + i, matchCharacters, matchLength * sizeof(UChar))) {
+        if (i == delta)
+            return notFound;
+        searchHash += searchCharacters[i + matchLength];
+        searchHash -= searchCharacters[i];
+        ++i;
+    }
+    return start + i;
+}
+
+static bool equalScalar(const UChar* a, const UChar* b, unsigned length)
+{
+    return !memcmp(a, b, length * sizeof(UChar));
+}
+
+static bool equalIgnoringCaseScalar(const UChar* a, const UChar* b, unsigned length)
+{
+    // Do a faster loop for the leading run of ASCII characters.
+    unsigned i = 0;
+    for (; i < length; ++i) {
+        UChar ac = a[i];
+        UChar bc = b[i];
+        if ((ac | bc) & ~0x7F)
+            break;
+        if (toASCIILower(ac) != toASCIILower(bc))
+            return false;
+    }
+    return !umemcasecmp(a + i, b + i, length - i);
+}
+
+static const StringKernels scalarKernels = {
+    "scalar",
+    findCharacterScalar,
+    findCharactersScalar,
+    equalScalar,
+    equalIgnoringCaseScalar
+};
+
+// Outcome of comparing one vector block of each string ignoring case.
+enum BlockComparison { BlocksEqual, BlocksDiffer, BlocksNotASCII };
+
+#if HAVE(SSE2_STRING_KERNELS)
+
+static const unsigned charactersPerSSE2Block = sizeof(__m128i) / sizeof(UChar);
+// _mm_movemask_epi8 sets two bits for every 16-bit lane that compared equal.
+static const int allSSE2LanesEqual = 0xFFFF;
+
+static inline unsigned lowestSetBit(unsigned mask)
+{
+    ASSERT(mask);
+#if COMPILER(GCC)
+    return __builtin_ctz(mask);
+#else
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#endif
+}
+
+static inline __m128i loadSSE2Block(const UChar* characters)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+}
+
+static inline __m128i toASCIILowerSSE2(__m128i block)
+{
+    // Only used on blocks already known to be ASCII, so signed compares are safe.
+    __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi16(block, _mm_set1_epi16('A' - 1)), _mm_cmplt_epi16(block, _mm_set1_epi16('Z' + 1)));
+    return _mm_or_si128(block, _mm_and_si128(isUpper, _mm_set1_epi16(0x20)));
+}
+
+// Each kernel below walks whole blocks and then finishes with one block that
+// ends exactly at the end of the input, overlapping the previous block
+// instead of falling back to a scalar tail. Lanes read twice were already
+// known not to match, so re-reading them never changes the result.
+
+static inline size_t findCandidateInSSE2Block(const UChar* searchCharacters, unsigned i, __m128i first, __m128i last, const UChar* matchCharacters, unsigned matchLength)
+{
+    __m128i firstMatches = _mm_cmpeq_epi16(loadSSE2Block(searchCharacters + i), first);
+    __m128i lastMatches = _mm_cmpeq_epi16(loadSSE2Block(searchCharacters + i + matchLength - 1), last);
+    unsigned mask = _mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches));
+    while (mask) {
+        unsigned bit = lowestSetBit(mask);
+        unsigned candidate = i + bit / sizeof(UChar);
+        if (!memcmp(searchCharacters + candidate + 1, matchCharacters + 1, (matchLength - 2) * sizeof(UChar)))
+            return candidate;
+        mask &= ~(3u << bit);
+    }
+    return notFound;
+}
+
+static inline BlockComparison compareSSE2BlocksIgnoringCase(const UChar* a, const UChar* b)
+{
+    __m128i aBlock = loadSSE2Block(a);
+    __m128i bBlock = loadSSE2Block(b);
+    __m128i nonASCII = _mm_and_si128(_mm_or_si128(aBlock, bBlock), _mm_set1_epi16(static_cast<short>(0xFF80)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonASCII, _mm_setzero_si128())) != allSSE2LanesEqual)
+        return BlocksNotASCII;
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(toASCIILowerSSE2(aBlock), toASCIILowerSSE2(bBlock))) != allSSE2LanesEqual)
+        return BlocksDiffer;
+    return BlocksEqual;
+}
+
+static size_t findCharacterSSE2(const UChar* characters, unsigned length, UChar matchCharacter, unsigned start)
+{
+    if (length - start < charactersPerSSE2Block)
+        return findCharacterScalar(characters, length, matchCharacter, start);
+
+    const __m128i match = _mm_set1_epi16(matchCharacter);
+    unsigned lastBlock = length - charactersPerSSE2Block;
+    for (unsigned i = start; i < lastBlock; i += charactersPerSSE2Block) {
+        if (int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(loadSSE2Block(characters + i), match)))
+            return i + lowestSetBit(mask) / sizeof(UChar);
+    }
+    if (int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(loadSSE2Block(characters + lastBlock), match)))
+        return lastBlock + lowestSetBit(mask) / sizeof(UChar);
+    return notFound;
+}
+
+static size_t findCharactersSSE2(const UChar* characters, unsigned length, const UChar* matchCharacters, unsigned matchLength, unsigned start)
+{
+    // delta is the number of additional times to test; delta == 0 means test only once.
+    unsigned delta = length - start - matchLength;
+    if (delta < charactersPerSSE2Block - 1)
+        return findCharactersScalar(characters, length, matchCharacters, matchLength, start);
+
+    // Test eight candidate positions at a time against the first and last
+    // characters of the pattern, and only compare the middle of the ones
+    // that pass both.
+    const UChar* searchCharacters = characters + start;
+    const __m128i first = _mm_set1_epi16(matchCharacters[0]);
+    const __m128i last = _mm_set1_epi16(matchCharacters[matchLength - 1]);
+    unsigned lastBlock = delta - (charactersPerSSE2Block - 1);
+    for (unsigned i = 0; i < lastBlock; i += charactersPerSSE2Block) {
+        size_t candidate = findCandidateInSSE2Block(searchCharacters, i, first, last, matchCharacters, matchLength);
+        if (candidate != notFound)
+            return start + candidate;
+    }
+    size_t candidate = findCandidateInSSE2Block(searchCharacters, lastBlock, first, last, matchCharacters, matchLength);
+    return candidate == notFound ? notFound : start + candidate;
+}
+
+static bool equalSSE2(const UChar* a, const UChar* b, unsigned length)
+{
+    if (length < charactersPerSSE2Block)
+        return equalScalar(a, b, length);
+
+    unsigned lastBlock = length - charactersPerSSE2Block;
+    for (unsigned i = 0; i < lastBlock; i += charactersPerSSE2Block) {
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(loadSSE2Block(a + i), loadSSE2Block(b + i))) != allSSE2LanesEqual)
+            return false;
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(loadSSE2Block(a + lastBlock), loadSSE2Block(b + lastBlock))) == allSSE2LanesEqual;
+}
+
+static bool equalIgnoringCaseSSE2(const UChar* a, const UChar* b, unsigned length)
+{
+    if (length < charactersPerSSE2Block)
+        return equalIgnoringCaseScalar(a, b, length);
+
+    unsigned lastBlock = length - charactersPerSSE2Block;
+    for (unsigned i = 0; i < lastBlock; i += charactersPerSSE2Block) {
+        BlockComparison comparison = compareSSE2BlocksIgnoringCase(a + i, b + i);
+        if (comparison == BlocksDiffer)
+            return false;
+        if (comparison == BlocksNotASCII)
+            return equalIgnoringCaseScalar(a + i, b + i, length - i);
+    }
+    BlockComparison comparison = compareSSE2BlocksIgnoringCase(a + lastBlock, b + lastBlock);
+    if (comparison == BlocksNotASCII)
+        return equalIgnoringCaseScalar(a + lastBlock, b + lastBlock, charactersPerSSE2Block);
+    return comparison == BlocksEqual;
+}
+
+static const StringKernels sse2Kernels = {
+    "SSE2",
+    findCharacterSSE2,
+    findCharactersSSE2,
+    equalSSE2,
+    equalIgnoringCaseSSE2
+};
+
+static bool isSSE2Present()
+{
+#if CPU(X86_64) || defined(__SSE2__)
+    return true;
+#else
+    int registers[4];
+    __cpuid(registers, 1); // cpuid function 1 gives us the standard feature set
+    static const int SSE2FeatureBit = 1 << 26;
+    return registers[3] & SSE2FeatureBit;
+#endif
+}
+
+#elif HAVE(NEON_STRING_KERNELS)
+
+static const unsigned charactersPerNEONBlock = sizeof(uint16x8_t) / sizeof(UChar);
+
+static inline uint16x8_t loadNEONBlock(const UChar* characters)
+{
+    return vld1q_u16(reinterpret_cast<const uint16_t*>(characters));
+}
+
+static inline bool anyNEONLaneSet(uint16x8_t lanes)
+{
+    uint64x2_t halves = vreinterpretq_u64_u16(lanes);
+    return vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1);
+}
+
+static inline bool allNEONLanesSet(uint16x8_t lanes)
+{
+    uint64x2_t halves = vreinterpretq_u64_u16(lanes);
+    return (vgetq_lane_u64(halves, 0) & vgetq_lane_u64(halves, 1)) == ~static_cast<uint64_t>(0);
+}
+
+static inline uint16x8_t toASCIILowerNEON(uint16x8_t block)
+{
+    uint16x8_t isUpper = vandq_u16(vcgeq_u16(block, vdupq_n_u16('A')), vcleq_u16(block, vdupq_n_u16('Z')));
+    return vorrq_u16(block, vandq_u16(isUpper, vdupq_n_u16(0x20)));
+}
+
+// As with SSE2, each kernel finishes with one block that overlaps the
+// previous one and ends exactly at the end of the input.
+
+static inline size_t findCandidateInNEONBlock(const UChar* searchCharacters, unsigned i, uint16x8_t first, uint16x8_t last, const UChar* matchCharacters, unsigned matchLength)
+{
+    unsigned lastIndex = matchLength - 1;
+    uint16x8_t firstMatches = vceqq_u16(loadNEONBlock(searchCharacters + i), first);
+    uint16x8_t lastMatches = vceqq_u16(loadNEONBlock(searchCharacters + i + lastIndex), last);
+    if (!anyNEONLaneSet(vandq_u16(firstMatches, lastMatches)))
+        return notFound;
+    // NEON has no cheap equivalent of movemask, so look for the candidates
+    // in a block that has any with a scalar loop.
+    for (unsigned candidate = i; candidate < i + charactersPerNEONBlock; ++candidate) {
+        if (searchCharacters[candidate] == matchCharacters[0] && searchCharacters[candidate + lastIndex] == matchCharacters[lastIndex]
+            && !memcmp(searchCharacters + candidate + 1, matchCharacters + 1, (matchLength - 2) * sizeof(UChar)))
+            return candidate;
+    }
+    return notFound;
+}
+
+static inline BlockComparison compareNEONBlocksIgnoringCase(const UChar* a, const UChar* b)
+{
+    uint16x8_t aBlock = loadNEONBlock(a);
+    uint16x8_t bBlock = loadNEONBlock(b);
+    if (anyNEONLaneSet(vandq_u16(vorrq_u16(aBlock, bBlock), vdupq_n_u16(0xFF80))))
+        return BlocksNotASCII;
+    if (!allNEONLanesSet(vceqq_u16(toASCIILowerNEON(aBlock), toASCIILowerNEON(bBlock))))
+        return BlocksDiffer;
+    return BlocksEqual;
+}
+
+static size_t findCharacterNEON(const UChar* characters, unsigned length, UChar matchCharacter, unsigned start)
+{
+    if (length - start < charactersPerNEONBlock)
+        return findCharacterScalar(characters, length, matchCharacter, start);
+
+    const uint16x8_t match = vdupq_n_u16(matchCharacter);
+    unsigned lastBlock = length - charactersPerNEONBlock;
+    unsigned i = start;
+    while (i < lastBlock && !anyNEONLaneSet(vceqq_u16(loadNEONBlock(characters + i), match)))
+        i += charactersPerNEONBlock;
+    if (i > lastBlock)
+        i = lastBlock;
+    // The block at i either holds the first match or is the last block, so
+    // a scalar loop over it finds the exact position.
+    return findCharacterScalar(characters, i + charactersPerNEONBlock, matchCharacter, i);
+}
+
+static size_t findCharactersNEON(const UChar* characters, unsigned length, const UChar* matchCharacters, unsigned matchLength, unsigned start)
+{
+    // delta is the number of additional times to test; delta == 0 means test only once.
+    unsigned delta = length - start - matchLength;
+    if (delta < charactersPerNEONBlock - 1)
+        return findCharactersScalar(characters, length, matchCharacters, matchLength, start);
+
+    // Test eight candidate positions at a time against the first and last
+    // characters of the pattern, and only compare the middle of the ones
+    // that pass both.
+    const UChar* searchCharacters = characters + start;
+    const uint16x8_t first = vdupq_n_u16(matchCharacters[0]);
+    const uint16x8_t last = vdupq_n_u16(matchCharacters[matchLength - 1]);
+    unsigned lastBlock = delta - (charactersPerNEONBlock - 1);
+    for (unsigned i = 0; i < lastBlock; i += charactersPerNEONBlock) {
+        size_t candidate = findCandidateInNEONBlock(searchCharacters, i, first, last, matchCharacters, matchLength);
+        if (candidate != notFound)
+            return start + candidate;
+    }
+    size_t candidate = findCandidateInNEONBlock(searchCharacters, lastBlock, first, last, matchCharacters, matchLength);
+    return candidate == notFound ? notFound : start + candidate;
+}
+
+static bool equalNEON(const UChar* a, const UChar* b, unsigned length)
+{
+    if (length < charactersPerNEONBlock)
+        return equalScalar(a, b, length);
+
+    unsigned lastBlock = length - charactersPerNEONBlock;
+    for (unsigned i = 0; i < lastBlock; i += charactersPerNEONBlock) {
+        if (!allNEONLanesSet(vceqq_u16(loadNEONBlock(a + i), loadNEONBlock(b + i))))
+            return false;
+    }
+    return allNEONLanesSet(vceqq_u16(loadNEONBlock(a + lastBlock), loadNEONBlock(b + lastBlock)));
+}
+
+static bool equalIgnoringCaseNEON(const UChar* a, const UChar* b, unsigned length)
+{
+    if (length < charactersPerNEONBlock)
+        return equalIgnoringCaseScalar(a, b, length);
+
+    unsigned lastBlock = length - charactersPerNEONBlock;
+    for (unsigned i = 0; i < lastBlock; i += charactersPerNEONBlock) {
+        BlockComparison comparison = compareNEONBlocksIgnoringCase(a + i, b + i);
+        if (comparison == BlocksDiffer)
+            return false;
+        if (comparison == BlocksNotASCII)
+            return equalIgnoringCaseScalar(a + i, b + i, length - i);
+    }
+    BlockComparison comparison = compareNEONBlocksIgnoringCase(a + lastBlock, b + lastBlock);
+    if (comparison == BlocksNotASCII)
+        return equalIgnoringCaseScalar(a + lastBlock, b + lastBlock, charactersPerNEONBlock);
+    return comparison == BlocksEqual;
+}
+
+static const StringKernels neonKernels = {
+    "NEON",
+    findCharacterNEON,
+    findCharactersNEON,
+    equalNEON,
+    equalIgnoringCaseNEON
+};
+
+#endif
+
+static const StringKernels* selectStringKernels()
+{
+#if HAVE(SSE2_STRING_KERNELS)
+    if (isSSE2Present())
+        return &sse2Kernels;
+    return &scalarKernels;
+#elif HAVE(NEON_STRING_KERNELS)
+    return &neonKernels;
+#else
+    return &scalarKernels;
+#endif
+}
+
+static const StringKernels* s_stringKernels;
+
+static inline const StringKernels& stringKernels()
+{
+    // Every thread selects the same table, so a race here only repeats the check.
+    if (!s_stringKernels)
+        s_stringKernels = selectStringKernels();
+    return *s_stringKernels;
+}
+
+size_t findCharacter(const UChar* characters, unsigned length, UChar matchCharacter, unsigned start)
+{
+    if (start >= length)
+        return notFound;
+    return stringKernels().findCharacter(characters, length, matchCharacter, start);
+}
+
+size_t findCharacters(const UChar* characters, unsigned length, const UChar* matchCharacters, unsigned matchLength, unsigned start)
+{
+    if (!matchLength)
+        return start < length ? start : length;
+    if (start > length || matchLength > length - start)
+        return notFound;
+    if (matchLength == 1)
+        return stringKernels().findCharacter(characters, length, matchCharacters[0], start);
+    return stringKernels().findCharacters(characters, length, matchCharacters, matchLength, start);
+}
+
+bool equalCharacters(const UChar* a, const UChar* b, unsigned length)
+{
+    return stringKernels().equal(a, b, length);
+}
+
+bool equalCharactersIgnoringCase(const UChar* a, const UChar* b, unsigned length)
+{
+    return stringKernels().equalIgnoringCase(a, b, length);
+}
+
+const char* stringKernelsImplementationName()
+{
+    return stringKernels().name;
+}
+
+} // namespace WTF
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef StringKernels_h
+#define StringKernels_h
+
+#include <wtf/NotFound.h>
+#include <wtf/unicode/Unicode.h>
+
+namespace WTF {
+
+// Vectorized versions of the UChar search and comparison loops used by
+// StringImpl and the string hash traits. The implementation is chosen the
+// first time one of these is called: SSE2 on x86-64, on 32-bit x86 builds
+// compiled for SSE2, and with MSVC on 32-bit x86 processors that report it;
+// NEON on ARM builds that target it; plain loops everywhere else.
+
+// Below this many characters the scalar loops win over the setup cost.
+const unsigned minimumLengthForStringKernels = 16;
+
+size_t findCharacter(const UChar* characters, unsigned length, UChar matchCharacter, unsigned start = 0);
+size_t findCharacters(const UChar* characters, unsigned length, const UChar* matchCharacters, unsigned matchLength, unsigned start = 0);
+bool equalCharacters(const UChar*, const UChar*, unsigned length);
+// Same result as umemcasecmp() == 0. Runs of ASCII are folded in vector
+// registers; the first block containing anything else hands the rest of
+// the string to the Unicode library.
+bool equalCharactersIgnoringCase(const UChar*, const UChar*, unsigned length);
+
+// Names the implementation in use, for benchmarks and debugging output.
+const char* stringKernelsImplementationName();
+
+} // namespace WTF
+
+using WTF::minimumLengthForStringKernels;
+using WTF::findCharacter;
+using WTF::findCharacters;
+using WTF::equalCharacters;
+using WTF::equalCharactersIgnoringCase;
+
+#endif // StringKernels_h
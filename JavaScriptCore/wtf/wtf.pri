@@ -35,6 +35,7 @@ SOURCES += \
     wtf/text/CString.cpp \
     wtf/text/StringBuilder.cpp \
     wtf/text/StringImpl.cpp \
+    wtf/text/StringKernels.cpp \
     wtf/text/StringStatics.cpp \
     wtf/text/WTFString.cpp \
     wtf/unicode/CollatorDefault.cpp \
@@ -272,6 +272,17 @@ public:
             return (pos + position) > length;
         }
 
+        // For loops that scan ahead directly, rather than a character at a time.
+        const UChar* data()
+        {
+            return input;
+        }
+
+        unsigned end()
+        {
+            return length;
+        }
+
     private:
         const UChar* input;
         unsigned pos;
@@ -280,25 +291,57 @@ public:
 
     bool testCharacterClass(CharacterClass* characterClass, int ch)
     {
-        if (ch & 0xFF80) {
-            for (unsigned i = 0; i < characterClass->m_matchesUnicode.size(); ++i)
-                if (ch == characterClass->m_matchesUnicode[i])
-                    return true;
-            for (unsigned i = 0; i < characterClass->m_rangesUnicode.size(); ++i)
-                if ((ch >= characterClass->m_rangesUnicode[i].begin) && (ch <= characterClass->m_rangesUnicode[i].end))
-                    return true;
-        } else {
-            for (unsigned i = 0; i < characterClass->m_matches.size(); ++i)
-                if (ch == characterClass->m_matches[i])
-                    return true;
-            for (unsigned i = 0; i < characterClass->m_ranges.size(); ++i)
-                if ((ch >= characterClass->m_ranges[i].begin) && (ch <= characterClass->m_ranges[i].end))
-                    return true;
-        }
+        if (!(ch & 0xFF80))
+            return characterClass->m_asciiBitmap[ch >> 5] & (1u << (ch & 31));
+        if (characterClass->m_table && static_cast<unsigned>(ch) <= 0xFFFF)
+            return !characterClass->m_table->m_table[ch] == characterClass->m_table->m_inverted;
+
+        for (unsigned i = 0; i < characterClass->m_matchesUnicode.size(); ++i)
+            if (ch == characterClass->m_matchesUnicode[i])
+                return true;
+        for (unsigned i = 0; i < characterClass->m_rangesUnicode.size(); ++i)
+            if ((ch >= characterClass->m_rangesUnicode[i].begin) && (ch <= characterClass->m_rangesUnicode[i].end))
+                return true;
 
         return false;
     }
 
+    // Greedy loops over a single character or class scan the input directly, rather than
+    // checking the input length and testing one character at a time.  Each returns the
+    // number of characters matched, having advanced the input past them.
+    unsigned matchGreedyCharacter(UChar ch, unsigned maxCount, int inputPosition)
+    {
+        unsigned count = std::min(maxCount, input.end() - input.getPos());
+        const UChar* characters = input.data() + input.getPos() + inputPosition;
+        unsigned matchAmount = 0;
+        while (matchAmount < count && characters[matchAmount] == ch)
+            ++matchAmount;
+        input.checkInput(matchAmount);
+        return matchAmount;
+    }
+
+    unsigned matchGreedyCasedCharacter(UChar lo, UChar hi, unsigned maxCount, int inputPosition)
+    {
+        unsigned count = std::min(maxCount, input.end() - input.getPos());
+        const UChar* characters = input.data() + input.getPos() + inputPosition;
+        unsigned matchAmount = 0;
+        while (matchAmount < count && (characters[matchAmount] == lo || characters[matchAmount] == hi))
+            ++matchAmount;
+        input.checkInput(matchAmount);
+        return matchAmount;
+    }
+
+    unsigned matchGreedyCharacterClass(CharacterClass* characterClass, bool invert, unsigned maxCount, int inputPosition)
+    {
+        unsigned count = std::min(maxCount, input.end() - input.getPos());
+        const UChar* characters = input.data() + input.getPos() + inputPosition;
+        unsigned matchAmount = 0;
+        while (matchAmount < count && testCharacterClass(characterClass, characters[matchAmount]) != invert)
+            ++matchAmount;
+        input.checkInput(matchAmount);
+        return matchAmount;
+    }
+
     bool checkCharacter(int testChar, int inputPosition)
     {
         return testChar == input.readChecked(inputPosition);
@@ -445,19 +488,9 @@ public:
             return true;
         }
 
-        case QuantifierGreedy: {
-            unsigned matchAmount = 0;
-            while ((matchAmount < term.atom.quantityCount) && input.checkInput(1)) {
-                if (!checkCharacterClass(term.atom.characterClass, term.invert(), term.inputPosition - 1)) {
-                    input.uncheckInput(1);
-                    break;
-                }
-                ++matchAmount;
-            }
-            backTrack->matchAmount = matchAmount;
-
+        case QuantifierGreedy:
+            backTrack->matchAmount = matchGreedyCharacterClass(term.atom.characterClass, term.invert(), term.atom.quantityCount, term.inputPosition);
             return true;
-        }
 
         case QuantifierNonGreedy:
             backTrack->matchAmount = 0;
@@ -1073,6 +1106,44 @@ public:
         }
     }
 
+    // Moves the input to the next position at which the literal prefix occurs, or to the
+    // end of the input if there is none.
+    void lookupForLiteralPrefix()
+    {
+        const UChar* characters = input.data();
+        unsigned end = input.end();
+        const UChar* prefix = pattern->m_literalPrefix.data();
+        unsigned prefixLength = pattern->m_literalPrefix.size();
+        unsigned pos = input.getPos();
+
+        if (prefixLength == 1) {
+            UChar first = prefix[0];
+            while (pos < end && characters[pos] != first)
+                ++pos;
+            input.setPos(pos);
+            return;
+        }
+
+        UChar last = prefix[prefixLength - 1];
+        while (end - pos >= prefixLength) {
+            UChar ch = characters[pos + prefixLength - 1];
+            if (ch == last && !memcmp(characters + pos, prefix, (prefixLength - 1) * sizeof(UChar))) {
+                input.setPos(pos);
+                return;
+            }
+            pos += pattern->m_literalPrefixSkip[ch & 0xFF];
+        }
+        input.setPos(end);
+    }
+
+    void lookupForMatchStart()
+    {
+        if (!pattern->m_literalPrefix.isEmpty())
+            lookupForLiteralPrefix();
+        else if (pattern->m_containsBeginChars)
+            lookupForBeginChars();
+    }
+
 #define MATCH_NEXT() { ++context->term; goto matchAgain; }
 #define BACKTRACK() { --context->term; goto backtrack; }
 #define currentTerm() (disjunction->terms[context->term])
@@ -1084,8 +1155,8 @@ public:
         if (btrack)
             BACKTRACK();
 
-        if (pattern->m_containsBeginChars && isBody)
-            lookupForBeginChars();
+        if (isBody)
+            lookupForMatchStart();
 
         context->matchBegin = input.getPos();
         context->term = 0;
@@ -1141,16 +1212,7 @@ public:
         }
         case ByteTerm::TypePatternCharacterGreedy: {
             BackTrackInfoPatternCharacter* backTrack = reinterpret_cast<BackTrackInfoPatternCharacter*>(context->frame + currentTerm().frameLocation);
-            unsigned matchAmount = 0;
-            while ((matchAmount < currentTerm().atom.quantityCount) && input.checkInput(1)) {
-                if (!checkCharacter(currentTerm().atom.patternCharacter, currentTerm().inputPosition - 1)) {
-                    input.uncheckInput(1);
-                    break;
-                }
-                ++matchAmount;
-            }
-            backTrack->matchAmount = matchAmount;
-
+            backTrack->matchAmount = matchGreedyCharacter(currentTerm().atom.patternCharacter, currentTerm().atom.quantityCount, currentTerm().inputPosition);
             MATCH_NEXT();
         }
         case ByteTerm::TypePatternCharacterNonGreedy: {
@@ -1169,16 +1231,7 @@ public:
         }
         case ByteTerm::TypePatternCasedCharacterGreedy: {
             BackTrackInfoPatternCharacter* backTrack = reinterpret_cast<BackTrackInfoPatternCharacter*>(context->frame + currentTerm().frameLocation);
-            unsigned matchAmount = 0;
-            while ((matchAmount < currentTerm().atom.quantityCount) && input.checkInput(1)) {
-                if (!checkCasedCharacter(currentTerm().atom.casedCharacter.lo, currentTerm().atom.casedCharacter.hi, currentTerm().inputPosition - 1)) {
-                    input.uncheckInput(1);
-                    break;
-                }
-                ++matchAmount;
-            }
-            backTrack->matchAmount = matchAmount;
-
+            backTrack->matchAmount = matchGreedyCasedCharacter(currentTerm().atom.casedCharacter.lo, currentTerm().atom.casedCharacter.hi, currentTerm().atom.quantityCount, currentTerm().inputPosition);
             MATCH_NEXT();
         }
         case ByteTerm::TypePatternCasedCharacterNonGreedy: {
@@ -1264,8 +1317,8 @@ public:
 
             input.next();
 
-            if (pattern->m_containsBeginChars && isBody)
-                lookupForBeginChars();
+            if (isBody)
+                lookupForMatchStart();
 
             context->matchBegin = input.getPos();
 
@@ -1453,7 +1506,77 @@ public:
         emitDisjunction(m_pattern.m_body);
         regexEnd();
 
-        return adoptPtr(new BytecodePattern(m_bodyDisjunction.release(), m_allParenthesesInfo, m_pattern, allocator));
+        OwnPtr<BytecodePattern> bytecodePattern = adoptPtr(new BytecodePattern(m_bodyDisjunction.release(), m_allParenthesesInfo, m_pattern, allocator));
+        findLiteralPrefix(bytecodePattern.get());
+        return bytecodePattern.release();
+    }
+
+    // If the body has a single alternative starting with fixed characters, these are the
+    // characters any match must start with.
+    void findLiteralPrefix(BytecodePattern* bytecodePattern)
+    {
+        Vector<ByteTerm>& terms = bytecodePattern->m_body->terms;
+        ASSERT(terms[0].type == ByteTerm::TypeBodyAlternativeBegin);
+        if (terms[0].alternative.next)
+            return;
+
+        unsigned termIndex = 1;
+        int inputPosition = 0;
+        if (terms[termIndex].type == ByteTerm::TypeCheckInput)
+            inputPosition = -static_cast<int>(terms[termIndex++].checkInputCount);
+
+        Vector<UChar>& prefix = bytecodePattern->m_literalPrefix;
+        for (; termIndex < terms.size(); ++termIndex) {
+            ByteTerm& term = terms[termIndex];
+            if ((term.type != ByteTerm::TypePatternCharacterOnce && term.type != ByteTerm::TypePatternCharacterFixed) || term.inputPosition != inputPosition)
+                break;
+            for (unsigned i = 0; i < term.atom.quantityCount && prefix.size() < BytecodePattern::maxLiteralPrefixLength; ++i)
+                prefix.append(term.atom.patternCharacter);
+            inputPosition += term.atom.quantityCount;
+        }
+
+        unsigned prefixLength = prefix.size();
+        memset(bytecodePattern->m_literalPrefixSkip, prefixLength, sizeof(bytecodePattern->m_literalPrefixSkip));
+        for (unsigned i = 0; i + 1 < prefixLength; ++i)
+            bytecodePattern->m_literalPrefixSkip[prefix[i] & 0xFF] = prefixLength - 1 - i;
+    }
+
+    // Adjacent fixed count atoms matching the same characters are merged into one term,
+    // so that, for example, /\d\d\d\d/ is matched like /\d{4}/.
+    bool extendPreviousAtom(const ByteTerm& term)
+    {
+        if (m_bodyDisjunction->terms.isEmpty() || term.atom.quantityType != QuantifierFixedCount)
+            return false;
+
+        ByteTerm& previous = m_bodyDisjunction->terms.last();
+        if (previous.atom.quantityType != QuantifierFixedCount || previous.inputPosition + static_cast<int>(previous.atom.quantityCount) != term.inputPosition
+            || previous.atom.quantityCount + term.atom.quantityCount < previous.atom.quantityCount)
+            return false;
+
+        switch (term.type) {
+        case ByteTerm::TypePatternCharacterOnce:
+        case ByteTerm::TypePatternCharacterFixed:
+            if ((previous.type != ByteTerm::TypePatternCharacterOnce && previous.type != ByteTerm::TypePatternCharacterFixed) || previous.atom.patternCharacter != term.atom.patternCharacter)
+                return false;
+            previous.type = ByteTerm::TypePatternCharacterFixed;
+            break;
+        case ByteTerm::TypePatternCasedCharacterOnce:
+        case ByteTerm::TypePatternCasedCharacterFixed:
+            if ((previous.type != ByteTerm::TypePatternCasedCharacterOnce && previous.type != ByteTerm::TypePatternCasedCharacterFixed)
+                || previous.atom.casedCharacter.lo != term.atom.casedCharacter.lo || previous.atom.casedCharacter.hi != term.atom.casedCharacter.hi)
+                return false;
+            previous.type = ByteTerm::TypePatternCasedCharacterFixed;
+            break;
+        case ByteTerm::TypeCharacterClass:
+            if (previous.type != ByteTerm::TypeCharacterClass || previous.atom.characterClass != term.atom.characterClass || previous.m_invert != term.m_invert)
+                return false;
+            break;
+        default:
+            return false;
+        }
+
+        previous.atom.quantityCount += term.atom.quantityCount;
+        return true;
     }
 
     void checkInput(unsigned count)
@@ -1488,21 +1611,26 @@ public:
             UChar hi = Unicode::toUpper(ch);
 
             if (lo != hi) {
-                m_bodyDisjunction->terms.append(ByteTerm(lo, hi, inputPosition, frameLocation, quantityCount, quantityType));
+                ByteTerm term(lo, hi, inputPosition, frameLocation, quantityCount, quantityType);
+                if (!extendPreviousAtom(term))
+                    m_bodyDisjunction->terms.append(term);
                 return;
             }
         }
 
-        m_bodyDisjunction->terms.append(ByteTerm(ch, inputPosition, frameLocation, quantityCount, quantityType));
+        ByteTerm term(ch, inputPosition, frameLocation, quantityCount, quantityType);
+        if (!extendPreviousAtom(term))
+            m_bodyDisjunction->terms.append(term);
     }
 
     void atomCharacterClass(CharacterClass* characterClass, bool invert, int inputPosition, unsigned frameLocation, unsigned quantityCount, QuantifierType quantityType)
     {
-        m_bodyDisjunction->terms.append(ByteTerm(characterClass, invert, inputPosition));
-
-        m_bodyDisjunction->terms[m_bodyDisjunction->terms.size() - 1].atom.quantityCount = quantityCount;
-        m_bodyDisjunction->terms[m_bodyDisjunction->terms.size() - 1].atom.quantityType = quantityType;
-        m_bodyDisjunction->terms[m_bodyDisjunction->terms.size() - 1].frameLocation = frameLocation;
+        ByteTerm term(characterClass, invert, inputPosition);
+        term.atom.quantityCount = quantityCount;
+        term.atom.quantityType = quantityType;
+        term.frameLocation = frameLocation;
+        if (!extendPreviousAtom(term))
+            m_bodyDisjunction->terms.append(term);
     }
 
     void atomBackReference(unsigned subpatternId, int inputPosition, unsigned frameLocation, unsigned quantityCount, QuantifierType quantityType)
@@ -1887,6 +2015,19 @@ private:
     Vector<ByteDisjunction*> m_allParenthesesInfo;
 };
 
+void fillASCIIBitmap(CharacterClass* characterClass)
+{
+    for (unsigned i = 0; i < characterClass->m_matches.size(); ++i) {
+        UChar ch = characterClass->m_matches[i];
+        if (ch < 128)
+            characterClass->m_asciiBitmap[ch >> 5] |= 1u << (ch & 31);
+    }
+    for (unsigned i = 0; i < characterClass->m_ranges.size(); ++i) {
+        for (unsigned ch = characterClass->m_ranges[i].begin; ch <= characterClass->m_ranges[i].end && ch < 128; ++ch)
+            characterClass->m_asciiBitmap[ch >> 5] |= 1u << (ch & 31);
+    }
+}
+
 PassOwnPtr<BytecodePattern> byteCompile(YarrPattern& pattern, BumpPointerAllocator* allocator)
 {
     return ByteCompiler(pattern).compile(allocator);
@@ -39,6 +39,8 @@ namespace JSC { namespace Yarr {
 
 class ByteDisjunction;
 
+void fillASCIIBitmap(CharacterClass*);
+
 struct ByteTerm {
     enum Type {
         TypeBodyAlternativeBegin,
@@ -331,11 +333,15 @@ public:
         , m_containsBeginChars(pattern.m_containsBeginChars)
         , m_allocator(allocator)
     {
+        memset(m_literalPrefixSkip, 0, sizeof(m_literalPrefixSkip));
+
         newlineCharacterClass = pattern.newlineCharacterClass();
         wordcharCharacterClass = pattern.wordcharCharacterClass();
 
         m_allParenthesesInfo.append(allParenthesesInfo);
         m_userCharacterClasses.append(pattern.m_userCharacterClasses);
+        for (unsigned i = 0; i < m_userCharacterClasses.size(); ++i)
+            fillASCIIBitmap(m_userCharacterClasses[i]);
         // 'Steal' the YarrPattern's CharacterClasses!  We clear its
         // array, so that it won't delete them on destruction.  We'll
         // take responsibility for that.
@@ -363,6 +369,13 @@ public:
 
     Vector<BeginChar> m_beginChars;
 
+    // Characters every match must start with, if any.  Possible match starts are found
+    // with a Boyer-Moore-Horspool search, shifting by m_literalPrefixSkip, indexed by the
+    // low byte of the character aligned with the end of the prefix.
+    static const unsigned maxLiteralPrefixLength = 255;
+    Vector<UChar> m_literalPrefix;
+    unsigned char m_literalPrefixSkip[256];
+
 private:
     Vector<ByteDisjunction*> m_allParenthesesInfo;
     Vector<CharacterClass*> m_userCharacterClasses;
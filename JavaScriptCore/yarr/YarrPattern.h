@@ -71,12 +71,15 @@ public:
     CharacterClass(PassRefPtr<CharacterClassTable> table)
         : m_table(table)
     {
+        memset(m_asciiBitmap, 0, sizeof(m_asciiBitmap));
     }
     Vector<UChar> m_matches;
     Vector<CharacterRange> m_ranges;
     Vector<UChar> m_matchesUnicode;
     Vector<CharacterRange> m_rangesUnicode;
     RefPtr<CharacterClassTable> m_table;
+    // Filled in by the bytecode compiler, bit c is set if ASCII character c is in the class.
+    uint32_t m_asciiBitmap[4];
 };
 
 enum QuantifierType {
@@ -0,0 +1,4 @@
+#ifndef WebCore_FWD_StringKernels_h
+#define WebCore_FWD_StringKernels_h
+#include <JavaScriptCore/StringKernels.h>
+#endif
@@ -27,6 +27,7 @@
 #include "GCController.h"
 
 #include "JSDOMWindow.h"
+#include <runtime/GCActivityCallback.h>
 #include <runtime/JSGlobalData.h>
 #include <runtime/JSLock.h>
 #include <heap/Heap.h>
@@ -51,11 +52,18 @@ GCController& gcController()
 
 GCController::GCController()
     : m_GCTimer(this, &GCController::gcTimerFired)
+    , m_collectionsDeferred(false)
+    , m_collectionPending(false)
 {
 }
 
 void GCController::garbageCollectSoon()
 {
+    if (m_collectionsDeferred) {
+        m_collectionPending = true;
+        return;
+    }
+
     if (!m_GCTimer.isActive())
         m_GCTimer.startOneShot(0);
 }
@@ -65,6 +73,35 @@ void GCController::gcTimerFired(Timer<GCController>*)
     collect(0);
 }
 
+void GCController::setCollectionsDeferred(bool deferred)
+{
+    if (deferred == m_collectionsDeferred)
+        return;
+    m_collectionsDeferred = deferred;
+
+    JSLock lock(SilenceAssertionsOnly);
+    JSDOMWindow::commonJSGlobalData()->heap.activityCallback()->setDeferred(deferred);
+
+    if (deferred) {
+        if (m_GCTimer.isActive()) {
+            m_GCTimer.stop();
+            m_collectionPending = true;
+        }
+        return;
+    }
+
+    if (m_collectionPending) {
+        m_collectionPending = false;
+        garbageCollectSoon();
+    }
+}
+
+void GCController::userDidBecomeIdle()
+{
+    JSLock lock(SilenceAssertionsOnly);
+    JSDOMWindow::commonJSGlobalData()->heap.activityCallback()->didBecomeIdle();
+}
+
 void GCController::garbageCollectNow()
 {
     JSLock lock(SilenceAssertionsOnly);
@@ -40,11 +40,20 @@ namespace WebCore {
 
         void garbageCollectOnAlternateThreadForDebugging(bool waitUntilDone); // Used for stress testing.
 
+        // While deferred, neither garbageCollectSoon() nor the heap's activity callback will
+        // start a collection; whatever came due meanwhile runs once collections resume.
+        void setCollectionsDeferred(bool);
+        bool collectionsDeferred() const { return m_collectionsDeferred; }
+        // Tells the heap the user is idle, so a pending collection can run right away.
+        void userDidBecomeIdle();
+
     private:
         GCController(); // Use gcController() instead
         void gcTimerFired(Timer<GCController>*);
         
         Timer<GCController> m_GCTimer;
+        bool m_collectionsDeferred;
+        bool m_collectionPending;
     };
 
     // Function to obtain the global GC controller.
@@ -177,14 +177,9 @@ protected:
         return m_exec->hadException();
     }
 
-    unsigned ticksUntilNextCheck()
-    {
-        return m_timeoutChecker.ticksUntilNextCheck();
-    }
-
     bool didTimeOut()
     {
-        return m_timeoutChecker.didTimeOut(m_exec);
+        return UNLIKELY(m_timeoutChecker.interruptRequested()) && m_timeoutChecker.didTimeOut(m_exec);
     }
 
     void throwStackOverflow()
@@ -205,7 +200,7 @@ protected:
 
     ExecState* m_exec;
     bool m_failed;
-    TimeoutChecker m_timeoutChecker;
+    TimeoutChecker& m_timeoutChecker;
     MarkedArgumentBuffer m_gcBuffer;
 };
 
@@ -618,7 +613,6 @@ SerializationReturnCode CloneSerializer::serialize(JSValue in)
     Vector<WalkerState, 16> stateStack;
     WalkerState state = StateUnknown;
     JSValue inValue = in;
-    unsigned tickCount = ticksUntilNextCheck();
     while (1) {
         switch (state) {
             arrayStartState:
@@ -638,11 +632,8 @@ SerializationReturnCode CloneSerializer::serialize(JSValue in)
             }
             arrayStartVisitMember:
             case ArrayStartVisitMember: {
-                if (!--tickCount) {
-                    if (didTimeOut())
-                        return InterruptedExecutionError;
-                    tickCount = ticksUntilNextCheck();
-                }
+                if (didTimeOut())
+                    return InterruptedExecutionError;
 
                 JSArray* array = inputArrayStack.last();
                 uint32_t index = indexStack.last();
@@ -692,11 +683,8 @@ SerializationReturnCode CloneSerializer::serialize(JSValue in)
             }
             objectStartVisitMember:
             case ObjectStartVisitMember: {
-                if (!--tickCount) {
-                    if (didTimeOut())
-                        return InterruptedExecutionError;
-                    tickCount = ticksUntilNextCheck();
-                }
+                if (didTimeOut())
+                    return InterruptedExecutionError;
 
                 JSObject* object = inputObjectStack.last();
                 uint32_t index = indexStack.last();
@@ -750,11 +738,8 @@ SerializationReturnCode CloneSerializer::serialize(JSValue in)
         state = stateStack.last();
         stateStack.removeLast();
 
-        if (!--tickCount) {
-            if (didTimeOut())
-                return InterruptedExecutionError;
-            tickCount = ticksUntilNextCheck();
-        }
+        if (didTimeOut())
+            return InterruptedExecutionError;
     }
     if (m_failed)
         return UnspecifiedError;
@@ -1201,7 +1186,6 @@ DeserializationResult CloneDeserializer::deserialize()
     WalkerState state = StateUnknown;
     JSValue outValue;
 
-    unsigned tickCount = ticksUntilNextCheck();
     while (1) {
         switch (state) {
         arrayStartState:
@@ -1219,11 +1203,8 @@ DeserializationResult CloneDeserializer::deserialize()
         }
         arrayStartVisitMember:
         case ArrayStartVisitMember: {
-            if (!--tickCount) {
-                if (didTimeOut())
-                    return make_pair(JSValue(), InterruptedExecutionError);
-                tickCount = ticksUntilNextCheck();
-            }
+            if (didTimeOut())
+                return make_pair(JSValue(), InterruptedExecutionError);
 
             uint32_t index;
             if (!read(index)) {
@@ -1264,11 +1245,8 @@ DeserializationResult CloneDeserializer::deserialize()
         }
         objectStartVisitMember:
         case ObjectStartVisitMember: {
-            if (!--tickCount) {
-                if (didTimeOut())
-                    return make_pair(JSValue(), InterruptedExecutionError);
-                tickCount = ticksUntilNextCheck();
-            }
+            if (didTimeOut())
+                return make_pair(JSValue(), InterruptedExecutionError);
 
             CachedStringRef cachedString;
             bool wasTerminator = false;
@@ -1313,11 +1291,8 @@ DeserializationResult CloneDeserializer::deserialize()
         state = stateStack.last();
         stateStack.removeLast();
 
-        if (!--tickCount) {
-            if (didTimeOut())
-                return make_pair(JSValue(), InterruptedExecutionError);
-            tickCount = ticksUntilNextCheck();
-        }
+        if (didTimeOut())
+            return make_pair(JSValue(), InterruptedExecutionError);
     }
     ASSERT(outValue);
     ASSERT(!m_failed);
@@ -49,8 +49,19 @@ using namespace JSC;
 
 namespace WebCore {
 
+// Workers run on threads with small native stacks and seldom recurse deeply, so they
+// reserve a quarter of the register file a page gets.
+static size_t workerRegisterFileCapacity = RegisterFile::defaultCapacity / 4;
+
+// Set on the main thread, read by each worker thread as it starts.
+static Mutex& workerRegisterFileCapacityMutex()
+{
+    AtomicallyInitializedStatic(Mutex&, mutex = *new Mutex);
+    return mutex;
+}
+
 WorkerScriptController::WorkerScriptController(WorkerContext* workerContext)
-    : m_globalData(JSGlobalData::create(ThreadStackTypeSmall))
+    : m_globalData(JSGlobalData::create(ThreadStackTypeSmall, registerFileCapacity()))
     , m_workerContext(workerContext)
     , m_workerContextWrapper(*m_globalData)
     , m_executionForbidden(false)
@@ -65,6 +76,19 @@ WorkerScriptController::~WorkerScriptController()
     m_globalData->heap.destroy();
 }
 
+void WorkerScriptController::setRegisterFileCapacity(size_t capacity)
+{
+    ASSERT(capacity && isPageAligned(capacity * sizeof(Register)));
+    MutexLocker locker(workerRegisterFileCapacityMutex());
+    workerRegisterFileCapacity = capacity;
+}
+
+size_t WorkerScriptController::registerFileCapacity()
+{
+    MutexLocker locker(workerRegisterFileCapacityMutex());
+    return workerRegisterFileCapacity;
+}
+
 void WorkerScriptController::initScript()
 {
     ASSERT(!m_workerContextWrapper);
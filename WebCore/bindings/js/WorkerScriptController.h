@@ -75,6 +75,11 @@ namespace WebCore {
 
         JSC::JSGlobalData* globalData() { return m_globalData.get(); }
 
+        // The number of registers of JavaScript stack reserved by workers started from
+        // now on. The registers must fill a whole number of pages. Can be called from any thread.
+        static void setRegisterFileCapacity(size_t);
+        static size_t registerFileCapacity();
+
     private:
         void initScriptIfNeeded()
         {
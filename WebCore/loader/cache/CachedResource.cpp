@@ -230,8 +230,9 @@ void CachedResource::setCachedMetadata(unsigned dataTypeID, const char* data, si
 {
     // Currently, only one type of cached metadata per resource is supported.
     // If the need arises for multiple types of metadata per resource this could
-    // be enhanced to store types of metadata in a map.
-    ASSERT(!m_cachedMetadata);
+    // be enhanced to store types of metadata in a map. Metadata of the same type
+    // may be replaced with a newer version.
+    ASSERT(!m_cachedMetadata || m_cachedMetadata->dataTypeID() == dataTypeID);
 
     m_cachedMetadata = CachedMetadata::create(dataTypeID, data, size);
     ResourceHandle::cacheMetadata(m_response, m_cachedMetadata->serialize());
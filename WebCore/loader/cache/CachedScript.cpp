@@ -28,6 +28,7 @@
 #include "CachedScript.h"
 
 #include "MemoryCache.h"
+#include "CachedMetadata.h"
 #include "CachedResourceClient.h"
 #include "CachedResourceClientWalker.h"
 #include "SharedBuffer.h"
@@ -40,10 +41,18 @@
 
 namespace WebCore {
 
+#if USE(JSC)
+// Identifies the serialized JSC::SourceProviderCache among the metadata the platform keeps for a script.
+static const unsigned sourceProviderCacheDataTypeID = 0x4A534331;
+#endif
+
 CachedScript::CachedScript(const String& url, const String& charset)
     : CachedResource(url, Script)
     , m_decoder(TextResourceDecoder::create("application/javascript", charset))
     , m_decodedDataDeletionTimer(this, &CachedScript::decodedDataDeletionTimerFired)
+#if USE(JSC)
+    , m_persistedSourceProviderCacheSize(0)
+#endif
 {
     // It's javascript we want.
     // But some websites think their scripts are <some wrong mimetype here>
@@ -114,11 +123,24 @@ void CachedScript::error(CachedResource::Status status)
 
 void CachedScript::destroyDecodedData()
 {
+#if USE(JSC)
+    // Hand what the parser learned about this script to the platform before it can be thrown away,
+    // so the next load of the resource does not have to parse every function body again. The blob
+    // is rewritten whenever the parser has added functions since it was last stored or restored.
+    if (m_sourceProviderCache && m_sourceProviderCache->size() > m_persistedSourceProviderCacheSize && !m_script.isNull()) {
+        Vector<char> serializedCache;
+        m_sourceProviderCache->serialize(m_script.characters(), m_script.length(), serializedCache);
+        setCachedMetadata(sourceProviderCacheDataTypeID, serializedCache.data(), serializedCache.size());
+        m_persistedSourceProviderCacheSize = m_sourceProviderCache->size();
+    }
+#endif
     m_script = String();
     unsigned extraSize = 0;
 #if USE(JSC)
+    // Without clients no SourceProvider refers to the cache, so drop it entirely; the next
+    // sourceProviderCache() call restores it from the metadata stored above.
     if (m_sourceProviderCache && m_clients.isEmpty())
-        m_sourceProviderCache->clear();
+        m_sourceProviderCache.clear();
 
     extraSize = m_sourceProviderCache ? m_sourceProviderCache->byteSize() : 0;
 #endif
@@ -135,8 +157,21 @@ void CachedScript::decodedDataDeletionTimerFired(Timer<CachedScript>*)
 #if USE(JSC)
 JSC::SourceProviderCache* CachedScript::sourceProviderCache() const
 {   
-    if (!m_sourceProviderCache) 
-        m_sourceProviderCache = adoptPtr(new JSC::SourceProviderCache); 
+    if (!m_sourceProviderCache) {
+        m_sourceProviderCache = adoptPtr(new JSC::SourceProviderCache);
+        m_persistedSourceProviderCacheSize = 0;
+        if (CachedMetadata* metadata = cachedMetadata(sourceProviderCacheDataTypeID)) {
+            // Decoding the source and accounting for the restored items are not logically
+            // visible changes, so it is fine to do them from this const accessor.
+            CachedScript* mutableThis = const_cast<CachedScript*>(this);
+            const String& source = mutableThis->script();
+            unsigned oldSize = m_sourceProviderCache->byteSize();
+            if (!source.isNull() && m_sourceProviderCache->deserialize(source.characters(), source.length(), metadata->data(), metadata->size())) {
+                mutableThis->sourceProviderCacheSizeChanged(m_sourceProviderCache->byteSize() - oldSize);
+                m_persistedSourceProviderCacheSize = m_sourceProviderCache->size();
+            }
+        }
+    }
     return m_sourceProviderCache.get(); 
 }
 
@@ -70,6 +70,8 @@ namespace WebCore {
         Timer<CachedScript> m_decodedDataDeletionTimer;
 #if USE(JSC)        
         mutable OwnPtr<JSC::SourceProviderCache> m_sourceProviderCache;
+        // Number of cache items in the metadata last stored or restored for this script.
+        mutable unsigned m_persistedSourceProviderCacheSize;
 #endif
     };
 }
@@ -181,10 +181,12 @@ void ResourceHandle::prepareForURL(const KURL& url)
 }
 #endif
 
+#if !PLATFORM(QT)
 void ResourceHandle::cacheMetadata(const ResourceResponse&, const Vector<char>&)
 {
     // Optionally implemented by platform.
 }
+#endif
 
 #if USE(CFURLSTORAGESESSIONS)
 
@@ -28,6 +28,7 @@
 #include "ResourceHandleInternal.h"
 #include "ResourceResponse.h"
 #include "ResourceRequest.h"
+#include <QAbstractNetworkCache>
 #include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
@@ -521,7 +522,25 @@ void QNetworkReplyHandler::sendResponseIfNeeded()
         return;
     }
 
+    if (QNetworkAccessManager* manager = m_replyWrapper->reply()->manager())
+        response.setNetworkCache(manager->cache());
     client->didReceiveResponse(m_resourceHandle, response);
+    sendCachedMetadataIfNeeded(response);
+}
+
+void QNetworkReplyHandler::sendCachedMetadataIfNeeded(const ResourceResponse& response)
+{
+    // Metadata stored for an older copy of the resource does not belong to a fresh network reply.
+    if (wasAborted() || !response.networkCache() || !m_replyWrapper->reply()->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool())
+        return;
+
+    ResourceHandleClient* client = m_resourceHandle->client();
+    if (!client)
+        return;
+
+    QByteArray metadata = response.networkCache()->metaData(response.url()).attributes().value(cachedMetadataAttribute).toByteArray();
+    if (!metadata.isEmpty())
+        client->didReceiveCachedMetadata(m_resourceHandle, metadata.constData(), metadata.size());
 }
 
 void QNetworkReplyHandler::redirect(ResourceResponse& response, const QUrl& redirection)
@@ -40,6 +40,10 @@ class ResourceRequest;
 class ResourceResponse;
 class QNetworkReplyHandler;
 
+// The attribute of a QNetworkCacheMetaData entry that holds WebCore's CachedMetadata
+// for the resource, see ResourceHandle::cacheMetadata().
+const QNetworkRequest::Attribute cachedMetadataAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 0x574B);
+
 class QNetworkReplyHandlerCallQueue {
 public:
     QNetworkReplyHandlerCallQueue(QNetworkReplyHandler*, bool deferSignals);
@@ -138,6 +142,7 @@ private:
     void start();
     String httpMethod() const;
     void redirect(ResourceResponse&, const QUrl&);
+    void sendCachedMetadataIfNeeded(const ResourceResponse&);
     bool wasAborted() const { return !m_resourceHandle; }
     QNetworkReply* sendNetworkRequest(QNetworkAccessManager*, const ResourceRequest&);
 
@@ -170,6 +170,23 @@ void ResourceHandle::loadResourceSynchronously(NetworkingContext* context, const
     d->m_job->setLoadingDeferred(false);
 }
 
+void ResourceHandle::cacheMetadata(const ResourceResponse& response, const Vector<char>& data)
+{
+    QAbstractNetworkCache* cache = response.networkCache();
+    if (!cache)
+        return;
+
+    // Only attach metadata to an entry the cache already keeps for this response.
+    QNetworkCacheMetaData metaData = cache->metaData(response.url());
+    if (!metaData.isValid())
+        return;
+
+    QNetworkCacheMetaData::AttributesMap attributes = metaData.attributes();
+    attributes.insert(cachedMetadataAttribute, QByteArray(data.data(), data.size()));
+    metaData.setAttributes(attributes);
+    cache->updateMetaData(metaData);
+}
+
 void ResourceHandle::platformSetDefersLoading(bool defers)
 {
     if (!d->m_job)
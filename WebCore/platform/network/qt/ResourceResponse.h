@@ -28,6 +28,12 @@
 
 #include "ResourceResponseBase.h"
 
+#include <QPointer>
+
+QT_BEGIN_NAMESPACE
+class QAbstractNetworkCache;
+QT_END_NAMESPACE
+
 namespace WebCore {
 
 class ResourceResponse : public ResourceResponseBase {
@@ -41,11 +47,18 @@ public:
     {
     }
 
+    // The cache of the network access manager that produced this response, if any.
+    // ResourceHandle::cacheMetadata() stores metadata for the response there.
+    QAbstractNetworkCache* networkCache() const { return m_networkCache; }
+    void setNetworkCache(QAbstractNetworkCache* cache) { m_networkCache = cache; }
+
 private:
     friend class ResourceResponseBase;
 
     PassOwnPtr<CrossThreadResourceResponseData> doPlatformCopyData(PassOwnPtr<CrossThreadResourceResponseData> data) const { return data; }
     void doPlatformAdopt(PassOwnPtr<CrossThreadResourceResponseData>) { }
+
+    QPointer<QAbstractNetworkCache> m_networkCache;
 };
 
 struct CrossThreadResourceResponseData : public CrossThreadResourceResponseDataBase {
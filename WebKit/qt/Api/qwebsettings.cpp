@@ -43,6 +43,19 @@
 #include "ApplicationCacheStorage.h"
 #include "DatabaseTracker.h"
 #include "FileSystem.h"
+#if USE(JSC)
+#include "GCController.h"
+#include "JSDOMWindowBase.h"
+#include "JSLock.h"
+#include "SamplingProfiler.h"
+#include "ScriptController.h"
+#include <wtf/MainThread.h>
+#endif
+#if ENABLE(WORKERS) && USE(JSC)
+#include "Register.h"
+#include "WorkerScriptController.h"
+#include <wtf/PageBlock.h>
+#endif
 
 #include <QApplication>
 #include <QDesktopServices>
@@ -82,6 +95,8 @@ public:
     WebCore::Settings* settings;
 };
 
+static QWebSettings::InteractionState currentInteractionState = QWebSettings::UserIdle;
+
 typedef QHash<int, QPixmap> WebGraphicHash;
 Q_GLOBAL_STATIC(WebGraphicHash, _graphics)
 
@@ -832,6 +847,222 @@ void QWebSettings::setObjectCacheCapacities(int cacheMinDeadCapacity, int cacheM
                                     qMax(0, totalCapacity));
 }
 
+/*!
+    \enum QWebSettings::InteractionState
+    \since 4.8
+
+    This enum describes what the user is doing, as far as it matters to when
+    QtWebKit reclaims memory used by JavaScript.
+
+    \value UserIdle The user is not interacting with the application. Collections
+        that have come due run as soon as the event loop becomes idle. This is the
+        default.
+    \value AnimationRunning The application is doing latency sensitive work, such
+        as running an animation. Collections scheduled from the event loop are held
+        back until the state is set to UserIdle again.
+*/
+
+/*!
+    \since 4.8
+
+    Tells QtWebKit what the user is currently doing, so that JavaScript garbage
+    collections scheduled from the event loop can be moved out of the way of
+    animations and other interactive work.
+
+    Setting the state back to UserIdle runs a collection that is due when the
+    event loop next becomes idle, without waiting for its usual delay.
+    Collections that JavaScript code needs in order to make progress are not
+    affected by the state.
+
+    \sa interactionState()
+*/
+void QWebSettings::setInteractionState(InteractionState state)
+{
+    currentInteractionState = state;
+#if USE(JSC)
+    WebCore::ScriptController::initializeThreading();
+    WTF::initializeMainThread();
+    WebCore::gcController().setCollectionsDeferred(state == AnimationRunning);
+    if (state == UserIdle)
+        WebCore::gcController().userDidBecomeIdle();
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Returns the interaction state last set with setInteractionState().
+*/
+QWebSettings::InteractionState QWebSettings::interactionState()
+{
+    return currentInteractionState;
+}
+
+/*!
+    \since 4.8
+
+    Starts sampling the JavaScript call stack \a samplesPerSecond times a second,
+    discarding the stacks collected by a previous run. Returns false, and samples
+    nothing, if pages run JavaScript in a way that cannot be sampled.
+
+    Sampling is cheap enough to be left running in production. Only JavaScript
+    executed by the interpreter is sampled, so QtWebKit must be built with the
+    interpreter enabled (ENABLE_INTERPRETER). Where such a build also uses the
+    JIT, set the \c JavaScriptCoreUseJIT environment variable to 0 before the
+    first page is created to profile.
+
+    \sa stopJavaScriptSampling(), javaScriptSampledStacks()
+*/
+bool QWebSettings::startJavaScriptSampling(int samplesPerSecond)
+{
+#if USE(JSC) && ENABLE(INTERPRETER)
+    WebCore::ScriptController::initializeThreading();
+    WTF::initializeMainThread();
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    JSC::JSGlobalData* globalData = WebCore::JSDOMWindowBase::commonJSGlobalData();
+    if (globalData->canUseJIT()) {
+        qWarning("QWebSettings::startJavaScriptSampling: JavaScript runs in the JIT, which cannot be sampled; set JavaScriptCoreUseJIT=0");
+        return false;
+    }
+    if (!globalData->samplingProfiler)
+        globalData->samplingProfiler = adoptPtr(new JSC::SamplingProfiler(*globalData));
+    globalData->samplingProfiler->start(qMax(samplesPerSecond, 1));
+    return true;
+#else
+    Q_UNUSED(samplesPerSecond);
+    qWarning("QWebSettings::startJavaScriptSampling: QtWebKit was built without the JavaScript interpreter, which sampling requires");
+    return false;
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Stops sampling the JavaScript call stack. The stacks collected so far remain
+    available from javaScriptSampledStacks().
+
+    \sa startJavaScriptSampling()
+*/
+void QWebSettings::stopJavaScriptSampling()
+{
+#if USE(JSC)
+    WebCore::ScriptController::initializeThreading();
+    WTF::initializeMainThread();
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    if (JSC::SamplingProfiler* profiler = WebCore::JSDOMWindowBase::commonJSGlobalData()->samplingProfiler.get())
+        profiler->stop();
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Returns the JavaScript call stacks sampled since startJavaScriptSampling()
+    was called, in the folded format read by flame graph tools.
+
+    Each line holds one distinct stack followed by a space and the number of
+    times it was sampled. The frames of a stack are separated by semicolons,
+    starting from the outermost one, and each reads as the function name, the
+    script URL and the line that was executing.
+
+    \sa startJavaScriptSampling()
+*/
+QString QWebSettings::javaScriptSampledStacks()
+{
+#if USE(JSC)
+    WebCore::ScriptController::initializeThreading();
+    WTF::initializeMainThread();
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    if (JSC::SamplingProfiler* profiler = WebCore::JSDOMWindowBase::commonJSGlobalData()->samplingProfiler.get()) {
+        JSC::UString stacks = profiler->foldedStacks();
+        return QString(reinterpret_cast<const QChar*>(stacks.characters()), stacks.length());
+    }
+#endif
+    return QString();
+}
+
+/*!
+    \since 4.8
+
+    Sets the time a script may run before QWebPage::shouldInterruptJavaScript()
+    is asked whether to stop it to \a milliseconds. The time is counted from
+    the moment the script was entered from the page, and a value of 0 lets
+    scripts run for as long as they like.
+
+    The limit applies to scripts started after the call. The default is 10000.
+
+    \sa javaScriptTimeLimit()
+*/
+void QWebSettings::setJavaScriptTimeLimit(int milliseconds)
+{
+#if USE(JSC)
+    WebCore::ScriptController::initializeThreading();
+    WTF::initializeMainThread();
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    WebCore::JSDOMWindowBase::commonJSGlobalData()->timeoutChecker.setTimeoutInterval(qMax(milliseconds, 0));
+#else
+    Q_UNUSED(milliseconds);
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Returns the time in milliseconds a script may run before
+    QWebPage::shouldInterruptJavaScript() is called, or 0 if there is no limit.
+
+    \sa setJavaScriptTimeLimit()
+*/
+int QWebSettings::javaScriptTimeLimit()
+{
+#if USE(JSC)
+    WebCore::ScriptController::initializeThreading();
+    WTF::initializeMainThread();
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    return WebCore::JSDOMWindowBase::commonJSGlobalData()->timeoutChecker.timeoutInterval();
+#else
+    return 0;
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Sets the address space that each web worker started after the call reserves
+    for its JavaScript stack to \a bytes, rounded up to whole memory pages.
+    Memory is only committed as a worker's scripts actually use the stack, and
+    a worker that runs out of it throws a RangeError.
+
+    \sa workerJavaScriptStackSize()
+*/
+void QWebSettings::setWorkerJavaScriptStackSize(int bytes)
+{
+#if ENABLE(WORKERS) && USE(JSC)
+    size_t pageSize = WTF::pageSize();
+    size_t size = (static_cast<size_t>(qMax(bytes, 1)) + pageSize - 1) / pageSize * pageSize;
+    WebCore::WorkerScriptController::setRegisterFileCapacity(size / sizeof(JSC::Register));
+#else
+    Q_UNUSED(bytes);
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Returns the size in bytes of the JavaScript stack reserved by each web
+    worker, or 0 if web workers are not supported.
+
+    \sa setWorkerJavaScriptStackSize()
+*/
+int QWebSettings::workerJavaScriptStackSize()
+{
+#if ENABLE(WORKERS) && USE(JSC)
+    return WebCore::WorkerScriptController::registerFileCapacity() * sizeof(JSC::Register);
+#else
+    return 0;
+#endif
+}
+
 /*!
     Sets the actual font family to \a family for the specified generic family,
     \a which.
@@ -95,6 +95,10 @@ public:
         DefaultFontSize,
         DefaultFixedFontSize
     };
+    enum InteractionState {
+        UserIdle,
+        AnimationRunning
+    };
 
     static QWebSettings *globalSettings();
 
@@ -130,6 +134,19 @@ public:
     static int maximumPagesInCache();
     static void setObjectCacheCapacities(int cacheMinDeadCapacity, int cacheMaxDead, int totalCapacity);
 
+    static void setInteractionState(InteractionState state);
+    static InteractionState interactionState();
+
+    static bool startJavaScriptSampling(int samplesPerSecond = 1000);
+    static void stopJavaScriptSampling();
+    static QString javaScriptSampledStacks();
+
+    static void setJavaScriptTimeLimit(int milliseconds);
+    static int javaScriptTimeLimit();
+
+    static void setWorkerJavaScriptStackSize(int bytes);
+    static int workerJavaScriptStackSize();
+
     static void setOfflineStoragePath(const QString& path);
     static QString offlineStoragePath();
     static void setOfflineStorageDefaultQuota(qint64 maximumSize);
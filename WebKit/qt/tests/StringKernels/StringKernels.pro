@@ -0,0 +1,15 @@
+isEmpty(OUTPUT_DIR): OUTPUT_DIR = ../../../..
+include(../tests.pri)
+TARGET = StringKernels
+CONFIG += console
+
+SOURCES += ../../../../JavaScriptCore/wtf/text/StringKernels.cpp
+HEADERS += ../../../../JavaScriptCore/wtf/text/StringKernels.h
+
+INCLUDEPATH += \
+    ../../../../JavaScriptCore/wtf/text \
+    ../../../../JavaScriptCore
+
+debug {
+    SOURCES += ../../../../JavaScriptCore/wtf/Assertions.cpp
+}
@@ -0,0 +1,191 @@
+/*
+    Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "config.h"
+#include "StringKernels.h"
+
+#include <QtCore/QString>
+#include <QtTest/QtTest>
+#include <string.h>
+#include <wtf/ASCIICType.h>
+
+// Checks whichever kernels this machine selects (SSE2, NEON or the scalar
+// loops) against naive loops on random strings. The lengths straddle the
+// vector block sizes, and the alphabets include characters whose case
+// folding is not plain ASCII.
+
+static const unsigned iterations = 100000;
+static const unsigned maximumLength = 70;
+
+static size_t referenceFind(const UChar* characters, unsigned length, const UChar* matchCharacters, unsigned matchLength, unsigned start)
+{
+    if (!matchLength)
+        return start < length ? start : length;
+    for (unsigned i = start; i < length && matchLength <= length - i; ++i) {
+        unsigned j = 0;
+        while (j < matchLength && characters[i + j] == matchCharacters[j])
+            ++j;
+        if (j == matchLength)
+            return i;
+    }
+    return notFound;
+}
+
+enum Alphabet { ASCIILetters, ASCIIBoundaries, MixedCase };
+
+static UChar randomCharacter(Alphabet alphabet)
+{
+    // Letters, the characters either side of the ASCII letter ranges, and
+    // characters that fold to or from ASCII (Kelvin sign, dotted capital I).
+    static const UChar characters[] = {
+        'a', 'b', 'A', 'B', 'z', 'Z', '@', '[', '`', '{',
+        0x00E9, 0x00C9, 0x212A, 'k', 'K', 0x0130, 'i', 0x00DF, 's', 0x03A3, 0x03C3, 0x03C2
+    };
+    switch (alphabet) {
+    case ASCIILetters:
+        return characters[qrand() % 4];
+    case ASCIIBoundaries:
+        return characters[qrand() % 10];
+    case MixedCase:
+        break;
+    }
+    return characters[qrand() % (sizeof(characters) / sizeof(characters[0]))];
+}
+
+static void fillRandom(UChar* characters, unsigned length, Alphabet alphabet)
+{
+    for (unsigned i = 0; i < length; ++i)
+        characters[i] = randomCharacter(alphabet);
+}
+
+// Copies the string, swapping the case of some ASCII letters and
+// occasionally replacing a character.
+static void fillRandomVariant(UChar* variant, const UChar* characters, unsigned length, Alphabet alphabet)
+{
+    for (unsigned i = 0; i < length; ++i) {
+        variant[i] = characters[i];
+        if (!(qrand() % 4) && isASCIIAlpha(variant[i]))
+            variant[i] ^= 0x20;
+        else if (!(qrand() % 120))
+            variant[i] = randomCharacter(alphabet);
+    }
+}
+
+static QString describe(const UChar* characters, unsigned length)
+{
+    return QString(reinterpret_cast<const QChar*>(characters), length);
+}
+
+// Names the kernels that were selected, so that a failure says which ones are wrong.
+static QString failure(const QString& message)
+{
+    return QString("%1 kernels: %2").arg(WTF::stringKernelsImplementationName()).arg(message);
+}
+
+class tst_StringKernels : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void findCharacter();
+    void findCharacters();
+    void equalCharacters();
+    void equalCharactersIgnoringCase();
+};
+
+void tst_StringKernels::initTestCase()
+{
+    qsrand(1);
+}
+
+void tst_StringKernels::findCharacter()
+{
+    UChar characters[maximumLength];
+    for (unsigned i = 0; i < iterations; ++i) {
+        Alphabet alphabet = static_cast<Alphabet>(qrand() % 3);
+        unsigned length = qrand() % maximumLength;
+        unsigned start = qrand() % (length + 3);
+        fillRandom(characters, length, alphabet);
+        UChar matchCharacter = randomCharacter(alphabet);
+
+        size_t expected = referenceFind(characters, length, &matchCharacter, 1, start);
+        QVERIFY2(WTF::findCharacter(characters, length, matchCharacter, start) == expected,
+                 qPrintable(failure(QString("'%1' in \"%2\" from %3").arg(QChar(matchCharacter)).arg(describe(characters, length)).arg(start))));
+    }
+}
+
+void tst_StringKernels::findCharacters()
+{
+    UChar characters[maximumLength];
+    UChar matchCharacters[maximumLength];
+    for (unsigned i = 0; i < iterations; ++i) {
+        Alphabet alphabet = static_cast<Alphabet>(qrand() % 3);
+        unsigned length = qrand() % maximumLength;
+        unsigned matchLength = qrand() % 8 ? qrand() % 6 : qrand() % 40;
+        unsigned start = qrand() % (length + 3);
+        fillRandom(characters, length, alphabet);
+        fillRandom(matchCharacters, matchLength, alphabet);
+        // Plant the pattern half of the time so that there is something to find.
+        if (matchLength && matchLength <= length && qrand() % 2)
+            memcpy(characters + qrand() % (length - matchLength + 1), matchCharacters, matchLength * sizeof(UChar));
+
+        size_t expected = referenceFind(characters, length, matchCharacters, matchLength, start);
+        QVERIFY2(WTF::findCharacters(characters, length, matchCharacters, matchLength, start) == expected,
+                 qPrintable(failure(QString("\"%1\" in \"%2\" from %3").arg(describe(matchCharacters, matchLength)).arg(describe(characters, length)).arg(start))));
+    }
+}
+
+void tst_StringKernels::equalCharacters()
+{
+    UChar a[maximumLength];
+    UChar b[maximumLength];
+    for (unsigned i = 0; i < iterations; ++i) {
+        Alphabet alphabet = static_cast<Alphabet>(qrand() % 3);
+        unsigned length = qrand() % maximumLength;
+        fillRandom(a, length, alphabet);
+        memcpy(b, a, length * sizeof(UChar));
+        // Half of the pairs differ in at most one place, which can be anywhere.
+        if (length && qrand() % 2)
+            b[qrand() % length] = randomCharacter(alphabet);
+
+        bool expected = !memcmp(a, b, length * sizeof(UChar));
+        QVERIFY2(WTF::equalCharacters(a, b, length) == expected,
+                 qPrintable(failure(QString("\"%1\" and \"%2\"").arg(describe(a, length)).arg(describe(b, length)))));
+    }
+}
+
+void tst_StringKernels::equalCharactersIgnoringCase()
+{
+    UChar a[maximumLength];
+    UChar b[maximumLength];
+    for (unsigned i = 0; i < iterations; ++i) {
+        Alphabet alphabet = static_cast<Alphabet>(qrand() % 3);
+        unsigned length = qrand() % maximumLength;
+        fillRandom(a, length, alphabet);
+        fillRandomVariant(b, a, length, alphabet);
+
+        bool expected = !WTF::Unicode::umemcasecmp(a, b, length);
+        QVERIFY2(WTF::equalCharactersIgnoringCase(a, b, length) == expected,
+                 qPrintable(failure(QString("\"%1\" and \"%2\"").arg(describe(a, length)).arg(describe(b, length)))));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_StringKernels);
+
+#include "tst_StringKernels.moc"
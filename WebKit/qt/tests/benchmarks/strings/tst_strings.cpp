@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <QtTest/QtTest>
+
+#include <qwebframe.h>
+#include <qwebpage.h>
+
+/**
+ * Exercises the string search and comparison loops that have vectorized
+ * implementations in WTF: character and substring search through indexOf,
+ * StringHash::equal on long strings, and case-insensitive attribute name
+ * lookup. Compare the results against a build without those kernels.
+ */
+class tst_Strings : public QObject
+{
+    Q_OBJECT
+
+public Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+private Q_SLOTS:
+    void evaluate_data();
+    void evaluate();
+
+private:
+    QWebPage* m_page;
+};
+
+void tst_Strings::initTestCase()
+{
+    m_page = new QWebPage;
+
+    QString attributes;
+    for (int i = 0; i < 50; ++i)
+        attributes += QString::fromLatin1(" data-benchmark-attribute-%1").arg(i, 2, 10, QLatin1Char('0'));
+    m_page->mainFrame()->setHtml(QString::fromLatin1("<div id=target%1></div>").arg(attributes));
+
+    m_page->mainFrame()->evaluateJavaScript(QLatin1String(
+        "var words = ['lorem', 'ipsum', 'dolor', 'sit', 'amet', 'consectetur', 'adipiscing', 'elit'];"
+        "var text = '';"
+        "for (var i = 0; i < 8192; ++i)"
+        "    text += words[i % words.length] + ' ';"
+        "var copy = text.split('').join('');"
+        "var object = {};"
+        "object[text] = true;"
+        "var target = document.getElementById('target');"));
+    QCOMPARE(m_page->mainFrame()->evaluateJavaScript(QLatin1String("text == copy && text.length")).toInt(), 56320);
+}
+
+void tst_Strings::cleanupTestCase()
+{
+    delete m_page;
+}
+
+void tst_Strings::evaluate_data()
+{
+    QTest::addColumn<QString>("script");
+    QTest::newRow("indexOf character") << QString::fromLatin1(
+        "for (var i = 0; i < 100; ++i)"
+        "    text.indexOf('#');");
+    QTest::newRow("indexOf string") << QString::fromLatin1(
+        "for (var i = 0; i < 100; ++i)"
+        "    text.indexOf('adipiscing lorem');");
+    // A property name that is not yet an identifier is looked up in the
+    // identifier table, where StringHash::equal compares it with the existing
+    // identifier. The baseline row uses that identifier itself, so it does
+    // the same lookups without the comparison.
+    QTest::newRow("StringHash::equal") << QString::fromLatin1(
+        "for (var i = 0; i < 100; ++i)"
+        "    object[copy];");
+    QTest::newRow("StringHash::equal baseline") << QString::fromLatin1(
+        "for (var i = 0; i < 100; ++i)"
+        "    object[text];");
+    QTest::newRow("attribute name ignoring case") << QString::fromLatin1(
+        "for (var i = 0; i < 1000; ++i)"
+        "    target.getAttribute('DATA-BENCHMARK-ATTRIBUTE-XX');");
+}
+
+void tst_Strings::evaluate()
+{
+    QFETCH(QString, script);
+
+    QBENCHMARK {
+        m_page->mainFrame()->evaluateJavaScript(script);
+    }
+}
+
+QTEST_MAIN(tst_Strings)
+#include "tst_strings.moc"
@@ -632,6 +632,16 @@ private slots:
     void inputFieldFocus();
     void hitTestContent();
     void jsByteArray();
+    void regExpRepeatedMatches();
+    void mixedWidthStrings();
+    void strictModeArguments();
+    void constructedObjectStorage();
+    void unboxedArrays();
+    void jsonParseShapes();
+    void jsonStringifyFastPath();
+    void regExpInterpreter();
+    void arrayBuiltinFastPaths();
+    void stringReplaceAndSplit();
     void ownership();
     void nullValue();
     void baseUrl_data();
@@ -2753,6 +2763,265 @@ void tst_QWebFrame::jsByteArray()
     QCOMPARE(v.toByteArray(), ba);
 }
 
+void tst_QWebFrame::regExpRepeatedMatches()
+{
+    // A RegExp remembers its last match, which must not get in the way of lastIndex
+    // and RegExp.lastMatch when the same subject is matched again.
+    evalJS("var re = /a(b)?/g; var s = 'xab-a-ab';"
+           "function matchAll() { var r = []; while (re.test(s)) r.push(re.lastIndex + ':' + RegExp.lastMatch + ':' + RegExp.$1); return r.join(','); }");
+    QCOMPARE(evalJS("matchAll()"), QString("3:ab:b,5:a:,8:ab:b"));
+    QCOMPARE(evalJS("matchAll()"), QString("3:ab:b,5:a:,8:ab:b"));
+    QCOMPARE(evalJS("re.lastIndex"), QString("0"));
+
+    QCOMPARE(evalJS("re.lastIndex = 4; var m = re.exec(s); m.index + ':' + m[0] + ':' + re.lastIndex"), QString("4:a:5"));
+    QCOMPARE(evalJS("re.lastIndex = 4; m = re.exec(s); m.index + ':' + m[0] + ':' + re.lastIndex"), QString("4:a:5"));
+    QCOMPARE(evalJS("re.lastIndex = 100; re.test(s) + ':' + re.lastIndex"), QString("false:0"));
+
+    QCOMPARE(evalJS("var plain = /a/; plain.lastIndex = 3; plain.test(s) + ':' + plain.test(s) + ':' + plain.lastIndex"), QString("true:true:3"));
+
+    // Substrings of long strings are matched but not remembered.
+    QCOMPARE(evalJS("var sub = (new Array(3000).join('x') + 'ab').substring(2990); var re2 = /ab/g;"
+                    "re2.test(sub) + ':' + re2.lastIndex + ':' + re2.test(sub) + ':' + re2.lastIndex"), QString("true:11:false:0"));
+}
+
+void tst_QWebFrame::mixedWidthStrings()
+{
+    // Identifiers and literals are stored with 8-bit characters; strings built at run time
+    // are 16-bit. Both forms of the same text must compare, hash and atomize the same.
+    evalJS("function chars() { return String.fromCharCode.apply(null, arguments); }"
+           "var built = chars(100, 97, 116, 97, 45, 120);");
+    QCOMPARE(evalJS("built == 'data-x' && 'data-x' == built"), sTrue);
+    QCOMPARE(evalJS("'caf\\u00e9' == 'caf' + chars(0xe9)"), sTrue);
+    QCOMPARE(evalJS("'\\u20ac' == chars(0x20ac)"), sTrue);
+    QCOMPARE(evalJS("'data-y' == built"), sFalse);
+    QCOMPARE(m_page->mainFrame()->evaluateJavaScript(QString::fromUtf8("'caf\xc3\xa9' == 'caf' + chars(0xe9)")), QVariant(true));
+
+    // Property names go through the identifier table.
+    evalJS("var object = {}; object['data-x'] = 1; object[chars(0xe9, 0x41)] = 2; object[chars(0x20ac)] = 3;");
+    QCOMPARE(evalJS("object[built]"), QString("1"));
+    QCOMPARE(evalJS("object['\\u00e9A']"), QString("2"));
+    QCOMPARE(evalJS("object['\\u20ac']"), QString("3"));
+    QCOMPARE(evalJS("var names = []; for (var name in object) names.push(name); names.length"), QString("3"));
+
+    // Searches where either side, or both, are 8-bit.
+    QCOMPARE(evalJS("'data-x-data-x'.indexOf(built) + ':' + 'data-x-data-x'.lastIndexOf(built) + ':' + built.indexOf('ta')"), QString("0:7:2"));
+    QCOMPARE(evalJS("'aaa'.lastIndexOf('aa') + ':' + 'aaa'.indexOf('aa', 2) + ':' + 'abc'.lastIndexOf('c', 1) + ':' + 'abc'.indexOf('\\u0163')"), QString("1:-1:-1:-1"));
+
+    // Attribute names are atomized by WebCore.
+    evalJS("var element = document.createElement('div'); element.setAttribute(built, 'value');");
+    QCOMPARE(evalJS("element.getAttribute('data-x')"), QString("value"));
+    QCOMPARE(evalJS("element.setAttribute('data-y', 'other'); element.getAttribute(chars(100, 97, 116, 97, 45, 121))"), QString("other"));
+    QCOMPARE(evalJS("element.hasAttribute(built.toUpperCase())"), sTrue);
+}
+
+void tst_QWebFrame::strictModeArguments()
+{
+    // In strict code the arguments object is created lazily, but it must still hold the values
+    // the parameters had on entry, whatever the function did to them since.
+    QCOMPARE(evalJS("(function(p) { 'use strict'; p = 2; return arguments[0] + ':' + p; })(1)"), QString("1:2"));
+    QCOMPARE(evalJS("(function(p) { 'use strict'; p += 5; return arguments[0] + ':' + p; })(1)"), QString("1:6"));
+    QCOMPARE(evalJS("(function(p, q) { 'use strict'; p++; ++q; return arguments[0] + ':' + arguments[1] + ':' + p + ':' + q; })(1, 10)"), QString("1:10:2:11"));
+    QCOMPARE(evalJS("(function(p) { 'use strict'; p--; --p; return arguments[0] + ':' + p; })(1)"), QString("1:-1"));
+    QCOMPARE(evalJS("(function(p) { 'use strict'; for (p in { x: 1 }) { } return arguments[0] + ':' + p; })('entry')"), QString("entry:x"));
+    QCOMPARE(evalJS("(function(p) { 'use strict'; var f = function() { return arguments[0]; }; p = 'changed'; return arguments[0] + ':' + f('inner'); })('entry')"), QString("entry:inner"));
+    QCOMPARE(evalJS("(function(p) { 'use strict'; arguments[0] = 'written'; return p + ':' + arguments[0]; })('entry')"), QString("entry:written"));
+    QCOMPARE(evalJS("(function(p) { 'use strict'; if (p) p = 0; return arguments[0] + ':' + p; })(7)"), QString("7:0"));
+
+    // length counts the actual arguments, not the parameters.
+    QCOMPARE(evalJS("(function(a, b, c) { 'use strict'; a = 0; return arguments.length; })(1, 2) + ':' + (function(a) { 'use strict'; return arguments.length; })(1, 2, 3)"), QString("2:3"));
+    QCOMPARE(evalJS("(function(a) { 'use strict'; a = 0; return arguments[1] + ':' + arguments[2]; })(1, 2)"), QString("2:undefined"));
+
+    // Passing arguments on with apply sees the entry values too.
+    QCOMPARE(evalJS("function strictSum(a, b) { 'use strict'; a = 100; return [].slice.call(arguments).join('+') + '=' + Math.max.apply(null, arguments); } strictSum(1, 2)"), QString("1+2=2"));
+    QCOMPARE(evalJS("function forward(x, y) { 'use strict'; x = 'x'; return (function() { return [].join.call(arguments); }).apply(this, arguments); } forward(1, 2, 3)"), QString("1,2,3"));
+}
+
+void tst_QWebFrame::constructedObjectStorage()
+{
+    // Objects made by a constructor get inline storage sized from the first few objects it built.
+    // Objects from before and after that switch, and objects that outgrow it, must all behave alike.
+    evalJS("function Wide(n) { for (var i = 0; i < n; ++i) this['p' + i] = i; }");
+    evalJS("function sumOf(o) { var total = 0; for (var name in o) total += o[name]; return total; }");
+    evalJS("var before = []; for (var i = 0; i < 4; ++i) before.push(new Wide(9));");
+    evalJS("var after = []; for (var i = 0; i < 20; ++i) after.push(new Wide(9));");
+    QCOMPARE(evalJS("sumOf(before[0]) + ':' + sumOf(after[19]) + ':' + before[3].p8 + ':' + after[0].p8"), QString("36:36:8:8"));
+    QCOMPARE(evalJS("var grown = new Wide(9); for (var i = 9; i < 40; ++i) grown['p' + i] = i; sumOf(grown) + ':' + grown.p39 + ':' + grown.p0"), QString("780:39:0"));
+    QCOMPARE(evalJS("var smaller = new Wide(2); smaller.extra = 10; sumOf(smaller) + ':' + (smaller.p5 === undefined)"), QString("11:true"));
+    QCOMPARE(evalJS("before[0].late = 'b'; after[0].late = 'a'; before[0].late + after[0].late + ':' + ('late' in after[1])"), QString("ba:false"));
+    QCOMPARE(evalJS("delete after[2].p4; after[2].p4 = 'again'; after[2].p4 + ':' + Object.keys(after[2]).length"), QString("again:9"));
+
+    // Structures shared by objects of different sizes keep their properties apart.
+    evalJS("function Point(x, y) { this.x = x; this.y = y; }");
+    evalJS("var points = []; for (var i = 0; i < 30; ++i) { var pt = new Point(i, -i); if (i % 3 == 0) { pt.z = i * 10; pt.w = 'w'; pt.v = 'v'; } points.push(pt); }");
+    QCOMPARE(evalJS("points[29].x + ':' + points[29].y + ':' + points[27].z + ':' + points[27].v + ':' + points[28].z"), QString("29:-29:270:v:undefined"));
+    QCOMPARE(evalJS("Point.prototype.norm = function() { return this.x * this.x + this.y * this.y; }; points[3].norm() + ':' + points[4].norm()"), QString("18:32"));
+}
+
+void tst_QWebFrame::unboxedArrays()
+{
+    // Arrays of int32 values start unboxed, move to double storage on the first other number,
+    // and to generic storage on anything else. Each step keeps the elements already there.
+    evalJS("var a = [1, 2, 3]; a[1] = 2.5;");
+    QCOMPARE(evalJS("a.join() + ':' + a.length"), QString("1,2.5,3:3"));
+    evalJS("a[3] = -0; a.push(1e300);");
+    QCOMPARE(evalJS("a.join() + ':' + (1 / a[3]) + ':' + a.length"), QString("1,2.5,3,0,1e+300:-Infinity:5"));
+    evalJS("a[0] = 'one';");
+    QCOMPARE(evalJS("a.join() + ':' + typeof a[0] + ':' + typeof a[1]"), QString("one,2.5,3,0,1e+300:string:number"));
+    QCOMPARE(evalJS("var b = [1, 2]; b[0] = {}; b[1] = 3.5; b.join() + ':' + (b[0] instanceof Object)"), QString("[object Object],3.5:true"));
+    QCOMPARE(evalJS("var n = [1, 2]; n[1] = NaN; n.push(Infinity); n.join() + ':' + isNaN(n[1])"), QString("1,NaN,Infinity:true"));
+
+    // Holes and delete leave the unboxed representations.
+    QCOMPARE(evalJS("var h = [1, 2, 3]; h[5] = 6; h.length + ':' + (3 in h) + ':' + h.join()"), QString("6:false:1,2,3,,,6"));
+    QCOMPARE(evalJS("var d = [1.5, 2.5, 3.5]; delete d[1]; (1 in d) + ':' + d.join() + ':' + d.length"), QString("false:1.5,,3.5:3"));
+    QCOMPARE(evalJS("var i = [1, 2, 3]; delete i[2]; (2 in i) + ':' + i.length + ':' + i.concat([4]).join()"), QString("false:3:1,2,,4"));
+    QCOMPARE(evalJS("var p = [1, 2]; Array.prototype[3] = 'proto'; p[2] = 3; var r = p[3] + ':' + p.join(); delete Array.prototype[3]; r"), QString("proto:1,2,3"));
+
+    // sort, pop and length truncation on int32 and double storage.
+    QCOMPARE(evalJS("var s = [3, 10, 1, 2]; s.sort(); s.join()"), QString("1,10,2,3"));
+    QCOMPARE(evalJS("var s2 = [3, 10, 1, 2]; s2.sort(function(x, y) { return x - y; }); s2.join()"), QString("1,2,3,10"));
+    QCOMPARE(evalJS("var s3 = [2.5, -1, 10.25, 0]; s3.sort(function(x, y) { return y - x; }); s3.join()"), QString("10.25,2.5,0,-1"));
+    QCOMPARE(evalJS("var s4 = [3, 1, 2]; s4[5] = 0; s4.sort(); s4.join() + ':' + s4.length + ':' + (5 in s4)"), QString("0,1,2,3,,:6:false"));
+    QCOMPARE(evalJS("var q = [1, 2, 3]; q.pop() + ':' + q.pop() + ':' + q.join() + ':' + q.length"), QString("3:2:1:1"));
+    QCOMPARE(evalJS("var q2 = [1.5, 2.5]; q2.pop() + ':' + q2.pop() + ':' + q2.pop() + ':' + q2.length"), QString("2.5:1.5:undefined:0"));
+    QCOMPARE(evalJS("var t = [1, 2, 3, 4]; t.length = 2; t.join() + ':' + (2 in t) + ':' + t[3]"), QString("1,2:false:undefined"));
+    QCOMPARE(evalJS("var t2 = [1.5, 2.5, 3.5]; t2.length = 1; t2.length = 3; t2.join() + ':' + (1 in t2)"), QString("1.5,,:false"));
+    QCOMPARE(evalJS("var t3 = [1, 2]; t3.length = 4; t3[1] = 5; t3.join() + ':' + (3 in t3)"), QString("1,5,,:false"));
+
+    // Spreading unboxed arrays into calls.
+    QCOMPARE(evalJS("Math.max.apply(Math, [4, 9, 2]) + ':' + Math.min.apply(Math, [1.5, -2.5, 0])"), QString("9:-2.5"));
+    QCOMPARE(evalJS("(function() { return arguments.length + ':' + Array.prototype.join.call(arguments, '-'); }).apply(null, [1, 2.5, 3])"), QString("3:1-2.5-3"));
+    QCOMPARE(evalJS("function sum() { var total = 0; for (var k = 0; k < arguments.length; ++k) total += arguments[k]; return total; } var big = []; for (var k = 0; k < 1000; ++k) big.push(k); sum.apply(null, big)"), QString("499500"));
+    QCOMPARE(evalJS("var u = [1, 2]; u.length = 3; (function(x, y, z) { return typeof z; }).apply(null, u)"), sUndefined);
+
+    // The array returned by String.prototype.match and RegExp.prototype.exec stores like any other.
+    QCOMPARE(evalJS("var m = /(\\d+)-(\\d+)/.exec('12-34'); m[1] = 7; m.join() + ':' + m.index + ':' + m.input"), QString("12-34,7,34:0:12-34"));
+    QCOMPARE(evalJS("var m2 = 'a1b2'.match(/\\d/g); m2[0] = 'x'; m2[2] = 3; m2.join() + ':' + m2.length"), QString("x,2,3:3"));
+    QCOMPARE(evalJS("var m3 = /b(c)?/.exec('abd'); m3[1] = 'string'; m3.push(5); m3.join() + ':' + m3.length"), QString("b,string,5:3"));
+}
+
+void tst_QWebFrame::jsonParseShapes()
+{
+    // JSON.parse predicts the structure of each object from the last object with the same first
+    // key. The prediction must never leak properties between objects that differ.
+    QCOMPARE(evalJS("var rows = JSON.parse('[{\"a\":1,\"b\":2},{\"a\":3,\"b\":4},{\"a\":5,\"b\":6}]'); rows[2].a + rows[2].b + ':' + Object.keys(rows[1]).join()"), QString("11:a,b"));
+    QCOMPARE(evalJS("var mixed = JSON.parse('[{\"a\":1,\"b\":2},{\"a\":3,\"c\":4},{\"a\":5},{\"a\":6,\"b\":7,\"c\":8},{\"b\":9,\"a\":10}]'); mixed.map(function(o) { return Object.keys(o).join('') + '=' + ('b' in o) + ('c' in o); }).join(' ')"), QString("ab=truefalse ac=falsetrue a=falsefalse abc=truetrue ba=truefalse"));
+    QCOMPARE(evalJS("mixed[1].b + ':' + mixed[1].c + ':' + mixed[2].b + ':' + mixed[4].a"), QString("undefined:4:undefined:10"));
+    QCOMPARE(evalJS("var dup = JSON.parse('{\"a\":1,\"b\":2,\"a\":3}'); dup.a + ':' + Object.keys(dup).join()"), QString("3:a,b"));
+    QCOMPARE(evalJS("var dups = JSON.parse('[{\"k\":1,\"k\":2},{\"k\":3}]'); dups[0].k + ':' + dups[1].k + ':' + Object.keys(dups[0]).length"), QString("2:3:1"));
+    QCOMPARE(evalJS("var nested = JSON.parse('{\"a\":{\"a\":{\"a\":1,\"b\":[{\"a\":2},{\"a\":3,\"b\":4}]}},\"b\":5}'); nested.a.a.b[1].b + ':' + nested.a.a.b[0].b + ':' + nested.b + ':' + Object.keys(nested.a).join()"), QString("4:undefined:5:a"));
+
+    // Escaped keys name the same property as the unescaped spelling.
+    QCOMPARE(evalJS("var esc = JSON.parse('[{\"ab\":1},{\"a\\\\u0062\":2},{\"\\\\u0061b\":3,\"c\\\\\"d\":4}]'); esc[1].ab + ':' + esc[2].ab + ':' + esc[2]['c\"d'] + ':' + Object.keys(esc[1]).join()"), QString("2:3:4:ab"));
+    QCOMPARE(evalJS("var tab = JSON.parse('{\"a\\\\tb\":1,\"a\\\\nb\":2}'); tab['a\\tb'] + ':' + tab['a\\nb']"), QString("1:2"));
+
+    // __proto__ is an ordinary own property in JSON.parse and never changes the prototype.
+    QCOMPARE(evalJS("var proto = JSON.parse('{\"__proto__\":{\"x\":1},\"y\":2}'); (Object.getPrototypeOf(proto) === Object.prototype) + ':' + proto.x + ':' + Object.keys(proto).join() + ':' + proto.hasOwnProperty('__proto__')"), QString("true:undefined:__proto__,y:true"));
+    QCOMPARE(evalJS("var protos = JSON.parse('[{\"__proto__\":1},{\"__proto__\":2,\"z\":3}]'); (Object.getPrototypeOf(protos[1]) === Object.prototype) + ':' + Object.keys(protos[1]).join() + ':' + protos[1].z"), QString("true:__proto__,z:3"));
+    QCOMPARE(evalJS("JSON.parse('{\"a\":1,\"b\":2}', function(key, value) { return key == 'a' ? undefined : value; }).hasOwnProperty('a')"), sFalse);
+}
+
+void tst_QWebFrame::jsonStringifyFastPath()
+{
+    // JSON.stringify walks the Structure of plain objects directly, which must still honour
+    // toJSON found on the prototype chain.
+    QCOMPARE(evalJS("Object.prototype.toJSON = function() { return 'object'; }; var r = JSON.stringify({ a: 1 }) + ':' + JSON.stringify([1]); delete Object.prototype.toJSON; r"), QString("\"object\":\"object\""));
+    QCOMPARE(evalJS("Array.prototype.toJSON = function() { return this.length; }; var r = JSON.stringify({ list: [1, 2, 3] }); delete Array.prototype.toJSON; r"), QString("{\"list\":3}"));
+    QCOMPARE(evalJS("Object.prototype.toJSON = function() { return 'object'; }; var r = JSON.stringify({ toJSON: null, a: {} }); delete Object.prototype.toJSON; r"), QString("{\"toJSON\":null,\"a\":\"object\"}"));
+
+    // Replacers and toJSON may add or remove properties of the holder being walked.
+    QCOMPARE(evalJS("JSON.stringify({ a: 1, b: 2, c: 3 }, function(key, value) { if (key == 'a') { delete this.b; this.d = 4; } return value; })"), QString("{\"a\":1,\"c\":3}"));
+    QCOMPARE(evalJS("var holder = { a: { toJSON: function() { delete holder.b; holder.z = 26; return 'A'; } }, b: 2 }; JSON.stringify(holder)"), QString("{\"a\":\"A\"}"));
+    QCOMPARE(evalJS("var shaped = { x: 1, y: 2 }; JSON.stringify(shaped, function(key, value) { if (key == 'x') shaped.y = { nested: true }; return value; })"), QString("{\"x\":1,\"y\":{\"nested\":true}}"));
+    QCOMPARE(evalJS("var counts = { a: 1, b: 2 }; JSON.stringify(counts, function(key, value) { if (key == 'a') Object.defineProperty(counts, 'b', { value: 'hidden', enumerable: false }); return value; })"), QString("{\"a\":1,\"b\":\"hidden\"}"));
+
+    // Indentation with arrays of primitives and nested empty containers.
+    QCOMPARE(evalJS("JSON.stringify([1, 'two', true, null, [], {}], null, 2)"), QString("[\n  1,\n  \"two\",\n  true,\n  null,\n  [],\n  {}\n]"));
+    QCOMPARE(evalJS("JSON.stringify({ list: [1, [2, [3]]], empty: [] }, null, '--')"), QString("{\n--\"list\": [\n----1,\n----[\n------2,\n------[\n--------3\n------]\n----]\n--],\n--\"empty\": []\n}"));
+    QCOMPARE(evalJS("JSON.stringify([undefined, function() {}, NaN, -Infinity], null, 1)"), QString("[\n null,\n null,\n null,\n null\n]"));
+
+    // int32 boundaries and negative numbers.
+    QCOMPARE(evalJS("JSON.stringify([0, -0, -1, 2147483647, -2147483648, 2147483648, -2147483649, 4294967295, 1e21, -1.5])"), QString("[0,0,-1,2147483647,-2147483648,2147483648,-2147483649,4294967295,1e+21,-1.5]"));
+    QCOMPARE(evalJS("JSON.stringify({ min: -2147483648, max: 2147483647, neg: -42 })"), QString("{\"min\":-2147483648,\"max\":2147483647,\"neg\":-42}"));
+}
+
+void tst_QWebFrame::regExpInterpreter()
+{
+    // The empty group and backreference at the end of each pattern match nothing, but a pattern
+    // with a backreference always runs in the Yarr interpreter, even where the JIT is enabled.
+    // Horspool search skips ahead by the low byte of a character; U+0161 and U+0261 share theirs
+    // with 'a', and U+0162 with 'b'.
+    QCOMPARE(evalJS("'\\u0161\\u0261xab'.search(/ab()\\1/) + ':' + '\\u0161\\u0162\\u0261ab'.search(/ab()\\1/) + ':' + 'aab\\u0161b'.search(/\\u0161b()\\1/)"), QString("3:3:3"));
+    QCOMPARE(evalJS("'\\u0161b\\u0162\\u0261'.search(/ab()\\1/) + ':' + 'xx\\u0161\\u0162\\u0163abc'.search(/abc()\\1/) + ':' + 'abc'.search(/\\u0161bc()\\1/)"), QString("-1:5:-1"));
+    QCOMPARE(evalJS("'aaaa\\u0161aab'.replace(/aab()\\1/, '[$&]').length + ':' + '\\u0161ab\\u0161ab'.match(/\\u0161ab()\\1/g).length + ':' + 'ab\\u0161ab'.lastIndexOf('\\u0161a')"), QString("10:2:2"));
+
+    // Runs of the same fixed-count class are matched together.
+    QCOMPARE(evalJS("/\\d\\d\\d()\\1/.exec('ab12c345d')[0] + ':' + /\\d\\d\\d()\\1/.test('12a3') + ':' + '1234567'.match(/\\d\\d\\d()\\1/g).join('|')"), QString("345:false:123|456"));
+    QCOMPARE(evalJS("/[a-c][a-c]x()\\1/.exec('cabbx')[0] + ':' + /\\w\\w\\w\\w()\\1/.exec('ab cdef')[0] + ':' + /\\D\\D()\\1/.exec('1a2bc3')[0]"), QString("bbx:cdef:bc"));
+    QCOMPARE(evalJS("/\\d\\d\\d()\\1/.test('\\u0661\\u0662\\u0663') + ':' + /x\\d{3}y()\\1/.test('x123y') + ':' + /x\\d{3}y()\\1/.test('x12y') + ':' + /\\d\\d()\\1/.exec('1\\u00b223')[0]"), QString("false:true:false:23"));
+
+    // \w, \s and their negations on characters outside ASCII: \w is only [A-Za-z0-9_], while \s
+    // includes the Unicode spaces.
+    QCOMPARE(evalJS("/\\w()\\1/.test('\\u00e9') + ':' + /\\W()\\1/.test('\\u00e9') + ':' + /\\w()\\1/.test('\\u0130') + ':' + /\\W()\\1/.test('\\u017f') + ':' + /\\w()\\1/.test('\\u212a')"), QString("false:true:false:true:false"));
+    QCOMPARE(evalJS("/\\s()\\1/.test('\\u00a0') + ':' + /\\s()\\1/.test('\\u2003') + ':' + /\\s()\\1/.test('\\u3000') + ':' + /\\s()\\1/.test('\\ufeff') + ':' + /\\S()\\1/.test('\\u2028') + ':' + /\\S()\\1/.test('\\u0161')"), QString("true:true:true:true:false:true"));
+    QCOMPARE(evalJS("'\\u00e9t\\u00e9 caf\\u00e9'.replace(/\\w+()\\1/g, '#').length + ':' + 'a\\u00a0b\\u2003c'.split(/\\s()\\1/).length + ':' + /[\\W\\d]+()\\1/.exec('ab\\u00e9\\u01611c')[0].length"), QString("6:5:3"));
+    QCOMPARE(evalJS("/\\w()\\1/i.test('\\u212a') + ':' + /k()\\1/i.test('\\u212a') + ':' + /[^\\s]+()\\1/.exec('\\u3000\\u0161x\\u00a0')[0].length + ':' + /[^\\S]()\\1/.test('\\u0161')"), QString("false:false:2:false"));
+}
+
+void tst_QWebFrame::arrayBuiltinFastPaths()
+{
+    // slice and splice copy and move dense arrays in place; holes, sparse arrays and
+    // other objects take the generic paths.
+    QCOMPARE(evalJS("[1, 2, 3, 4, 5].slice(1, 3).join() + ':' + [1, 2, 3].slice(-2).join() + ':' + [1, 2, 3].slice(-10, 10).join()"), QString("2,3:2,3:1,2,3"));
+    QCOMPARE(evalJS("[1, 2, 3].slice(2, 1).length + ':' + [1, 2, 3].slice(5).length + ':' + [1, 2, 3].slice(1.5, 2.5).join()"), QString("0:0:2"));
+    QCOMPARE(evalJS("var holes = [1, , 3, , 5]; var sliced = holes.slice(1, 4); sliced.length + ':' + (0 in sliced) + ':' + (1 in sliced) + ':' + sliced.join()"), QString("3:false:true:,3,"));
+    QCOMPARE(evalJS("var sparse = []; sparse[100000] = 'x'; sparse[3] = 'y'; var part = sparse.slice(2, 5); part.length + ':' + part.join('|')"), QString("3:|y|"));
+    QCOMPARE(evalJS("Array.prototype.slice.call({ length: 3, 0: 'a', 2: 'c' }, 0).join()"), QString("a,,c"));
+    QCOMPARE(evalJS("var sp = [1, 2, 3, 4, 5]; var removed = sp.splice(1, 2, 'a', 'b', 'c'); removed.join() + ':' + sp.join() + ':' + sp.length"), QString("2,3:1,a,b,c,4,5:6"));
+    QCOMPARE(evalJS("var sp2 = [1, 2, 3, 4, 5]; sp2.splice(-2, 1).join() + ':' + sp2.join()"), QString("4:1,2,3,5"));
+    QCOMPARE(evalJS("var sp3 = [1, 2, 3]; sp3.splice(1).join() + ':' + sp3.join()"), QString("2,3:1"));
+    QCOMPARE(evalJS("var sp4 = [1, 2, 3]; sp4.splice(10, 1, 4).length + ':' + sp4.join()"), QString("0:1,2,3,4"));
+    QCOMPARE(evalJS("var sp5 = [1, 2, 3]; sp5.splice(0, -1, 0).length + ':' + sp5.join()"), QString("0:0,1,2,3"));
+    QCOMPARE(evalJS("var sp6 = [1, 2, 3]; sp6.splice().length + ':' + sp6.join()"), QString("0:1,2,3"));
+    QCOMPARE(evalJS("var sp7 = [1.5, 2, 3]; sp7.splice(1, 0, 'x', 2.5); sp7.join()"), QString("1.5,x,2.5,2,3"));
+    QCOMPARE(evalJS("var sp8 = [1, , 3, 4]; sp8.splice(0, 1); sp8.length + ':' + (0 in sp8) + ':' + sp8.join()"), QString("3:false:,3,4"));
+    QCOMPARE(evalJS("var sp9 = [1, 2, 3, 4]; sp9.splice(0, 2, 9); sp9.join() + ':' + sp9.length"), QString("9,3,4:3"));
+    QCOMPARE(evalJS("var sp10 = [{ v: 1 }, { v: 2 }]; sp10.splice(1, 0, { v: 3 }); sp10.map(function(o) { return o.v; }).join()"), QString("1,3,2"));
+
+    // concat, indexOf and lastIndexOf.
+    QCOMPARE(evalJS("[1, 2].concat([3, , 5], 6, [[7]]).join() + ':' + [1, 2].concat([3, , 5]).length + ':' + (3 in [1, 2].concat([3, , 5]))"), QString("1,2,3,,5,6,7:5:false"));
+    QCOMPARE(evalJS("var sparseSource = []; sparseSource[5] = 1; [0].concat(sparseSource).length"), QString("7"));
+    QCOMPARE(evalJS("[1, 2, 3, 2, 1].indexOf(2) + ':' + [1, 2, 3, 2, 1].lastIndexOf(2) + ':' + [1, 2, 3].indexOf('2') + ':' + [1.5, NaN].indexOf(NaN)"), QString("1:3:-1:-1"));
+    QCOMPARE(evalJS("[1, 2, 3, 2].indexOf(2, -2) + ':' + [1, 2, 3].indexOf(1, -10) + ':' + [1, 2, 3].indexOf(1, 10) + ':' + [1, 2, 3].lastIndexOf(3, -2) + ':' + [1, 2, 3].lastIndexOf(1, -10) + ':' + [1, 2, 3].lastIndexOf(3, 10)"), QString("3:0:-1:-1:-1:2"));
+    QCOMPARE(evalJS("[, undefined].indexOf(undefined) + ':' + [undefined, ,].lastIndexOf(undefined) + ':' + [0].indexOf(-0) + ':' + ['1', 1].lastIndexOf(1)"), QString("1:0:0:1"));
+
+    // push with several arguments, including values that change the storage.
+    QCOMPARE(evalJS("var pushed = [1]; pushed.push(2, 3.5, 'four') + ':' + pushed.join()"), QString("4:1,2,3.5,four"));
+    QCOMPARE(evalJS("var pushed2 = []; pushed2.push() + ':' + pushed2.push(1, 2) + ':' + pushed2.join()"), QString("0:2:1,2"));
+    QCOMPARE(evalJS("var lengthLimit = []; lengthLimit.length = 4294967294; try { lengthLimit.push(1, 2); } catch (e) { e instanceof RangeError }"), sTrue);
+}
+
+void tst_QWebFrame::stringReplaceAndSplit()
+{
+    // Replacement patterns.
+    QCOMPARE(evalJS("'abc'.replace('b', '[$&]') + ':' + 'abc'.replace('b', '[$`]') + ':' + \"abc\".replace('b', \"[$']\") + ':' + 'abc'.replace('b', '$$') + ':' + 'abc'.replace('b', '$') + ':' + 'abc'.replace('b', '$x')"), QString("a[b]c:a[a]c:a[c]c:a$c:a$c:a$xc"));
+    QCOMPARE(evalJS("'abc'.replace(/(a)(b)/, '$2$1') + ':' + 'abc'.replace(/(a)/, '$01$10$2') + ':' + 'abc'.replace(/b/g, \"<$`|$'>\")"), QString("bac:aa0$2bc:a<a|c>c"));
+    QCOMPARE(evalJS("'abcdefghijk'.replace(/(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)/, '$11-$10-$1$0') + ':' + 'ab'.replace(/(a)/, '$00$001')"), QString("k-j-a$0:$00$001b"));
+    QCOMPARE(evalJS("'aXbXc'.replace(/X/g, '$&$&') + ':' + 'x'.replace(/x/, '$&$`$\\'') + ':' + 'aaa'.replace('a', function(m, i, s) { return i + s; })"), QString("aXXbXXc:x:0aaaaa"));
+
+    // Global replacement advances past empty matches.
+    QCOMPARE(evalJS("'abc'.replace(/x*/g, '-') + ':' + 'abc'.replace(/()/g, '[$1]') + ':' + ''.replace(/x*/g, '-') + ':' + 'ab'.replace(/a|/g, '.')"), QString("-a-b-c-:[]a[]b[]c[]:-:..b."));
+    QCOMPARE(evalJS("'\\ud834\\udd1e'.replace(/(?:)/g, '|').length + ':' + 'aaa'.replace(/a*?/g, '-')"), QString("5:-a-a-a-"));
+
+    // RegExp.lastMatch and friends after a global replace reflect the last match.
+    QCOMPARE(evalJS("'a1b22c'.replace(/\\d+/g, '#') + ':' + RegExp.lastMatch + ':' + RegExp.leftContext + ':' + RegExp.rightContext"), QString("a#b#c:22:a1b:c"));
+    QCOMPARE(evalJS("'x-y-z'.replace(/(\\w)-/g, '$1') + ':' + RegExp.$1 + ':' + RegExp.lastParen + ':' + RegExp.lastMatch"), QString("xyz:y:y:y-"));
+
+    // split with empty matches, captures and limits.
+    QCOMPARE(evalJS("'abc'.split('').join('|') + ':' + 'abc'.split(/(?:)/).join('|') + ':' + 'abc'.split(/x*/).join('|') + ':' + ''.split(/x*/).length + ':' + ''.split('').length"), QString("a|b|c:a|b|c:a|b|c:0:0"));
+    QCOMPARE(evalJS("'a1b2c'.split(/(\\d)/).join('|') + ':' + 'ab'.split(/(x)?/).join('|') + ':' + 'a,b,c'.split(',', 2).join('|') + ':' + 'abc'.split('', 0).length"), QString("a|1|b|2|c:|a||b:a|b:0"));
+    QCOMPARE(evalJS("'test'.split(/(?:)/, 2).join('|') + ':' + 'a  b'.split(/\\s*/).join('|') + ':' + ',a,'.split(',').length"), QString("t|e:a|b:3"));
+}
+
 void tst_QWebFrame::ownership()
 {
     // test ownership
@@ -118,6 +118,11 @@ private slots:
     void requestCache();
     void loadCachedPage();
     void protectBindingsRuntimeObjectsFromCollector();
+    void idleGarbageCollection();
+    void garbageCollectionUnderLoad();
+    void javaScriptSampling();
+    void javaScriptTimeLimit();
+    void workerJavaScriptStackSize();
     void localURLSchemes();
     void testOptionalJSObjects();
     void testLocalStorageVisibility();
@@ -2312,6 +2317,132 @@ void tst_QWebPage::protectBindingsRuntimeObjectsFromCollector()
     newPage->mainFrame()->evaluateJavaScript("testme('bar')");
 }
 
+void tst_QWebPage::idleGarbageCollection()
+{
+    QCOMPARE(QWebSettings::interactionState(), QWebSettings::UserIdle);
+
+    m_page->mainFrame()->evaluateJavaScript("var junk = []; for (var i = 0; i < 10000; ++i) junk.push({ i: i });");
+    DumpRenderTreeSupportQt::garbageCollectorCollect();
+    int objectCount = DumpRenderTreeSupportQt::javaScriptObjectsCount();
+
+    // While an animation is running, an idle event loop must not collect the garbage.
+    QWebSettings::setInteractionState(QWebSettings::AnimationRunning);
+    QCOMPARE(QWebSettings::interactionState(), QWebSettings::AnimationRunning);
+    m_page->mainFrame()->evaluateJavaScript("junk = null;");
+    QCoreApplication::processEvents();
+    QCOMPARE(DumpRenderTreeSupportQt::javaScriptObjectsCount(), objectCount);
+
+    // Going idle again runs the pending collection at the next idle moment, without waiting
+    // for the collection delay: either the trigger is still armed and didBecomeIdle() skips it,
+    // or it already fired and the deferred collection is released.
+    QWebSettings::setInteractionState(QWebSettings::UserIdle);
+    QTRY_VERIFY(DumpRenderTreeSupportQt::javaScriptObjectsCount() < objectCount);
+}
+
+void tst_QWebPage::javaScriptSampling()
+{
+    if (!QWebSettings::startJavaScriptSampling())
+        QSKIP("JavaScript runs in the JIT or QtWebKit has no interpreter, so it cannot be sampled", SkipSingle);
+    m_page->mainFrame()->evaluateJavaScript("function spin() { var end = new Date().getTime() + 200; while (new Date().getTime() < end) { } } spin();");
+    QWebSettings::stopJavaScriptSampling();
+
+    // Stopping keeps the stacks around, and nothing more is recorded afterwards.
+    QString stacks = QWebSettings::javaScriptSampledStacks();
+    m_page->mainFrame()->evaluateJavaScript("spin();");
+    QCOMPARE(QWebSettings::javaScriptSampledStacks(), stacks);
+
+    QVERIFY(!stacks.isEmpty());
+    QRegExp foldedStack("^[^\\n]+ \\d+$");
+    foreach (const QString& line, stacks.split('\n', QString::SkipEmptyParts))
+        QVERIFY2(foldedStack.exactMatch(line), qPrintable(line));
+    QVERIFY(stacks.contains(";spin "));
+
+    // Starting again discards the previous run.
+    QVERIFY(QWebSettings::startJavaScriptSampling());
+    QWebSettings::stopJavaScriptSampling();
+    QVERIFY(QWebSettings::javaScriptSampledStacks().isEmpty());
+}
+
+void tst_QWebPage::javaScriptTimeLimit()
+{
+    int defaultTimeLimit = QWebSettings::javaScriptTimeLimit();
+    QCOMPARE(defaultTimeLimit, 10000);
+
+    QWebSettings::setJavaScriptTimeLimit(200);
+    QCOMPARE(QWebSettings::javaScriptTimeLimit(), 200);
+
+    JSTestPage* newPage = new JSTestPage(m_view);
+    m_view->setPage(newPage);
+    m_view->setHtml(QString("<html><body>test</body></html>"), QUrl());
+
+    // The page agrees to every interruption, so the loop ends soon after the limit.
+    QTime timer;
+    timer.start();
+    newPage->mainFrame()->evaluateJavaScript("var run = true; var a = 1; while (run) { a++; }");
+    QVERIFY(timer.elapsed() < defaultTimeLimit);
+    QVERIFY(newPage->mainFrame()->evaluateJavaScript("a").toInt() > 1);
+
+    QWebSettings::setJavaScriptTimeLimit(defaultTimeLimit);
+    QCOMPARE(QWebSettings::javaScriptTimeLimit(), defaultTimeLimit);
+    m_view->setPage(0);
+    delete newPage;
+}
+
+void tst_QWebPage::workerJavaScriptStackSize()
+{
+    int defaultSize = QWebSettings::workerJavaScriptStackSize();
+    QCOMPARE(defaultSize, 1024 * 1024);
+
+    // Sizes are rounded up to whole pages.
+    QWebSettings::setWorkerJavaScriptStackSize(100000);
+    int size = QWebSettings::workerJavaScriptStackSize();
+    QVERIFY(size >= 100000);
+    QVERIFY(size < 100000 + 64 * 1024);
+
+    QWebSettings::setWorkerJavaScriptStackSize(defaultSize);
+    QCOMPARE(QWebSettings::workerJavaScriptStackSize(), defaultSize);
+}
+
+void tst_QWebPage::garbageCollectionUnderLoad()
+{
+    m_page->mainFrame()->setHtml("<html><body><div id='holder'></div></body></html>");
+    m_page->mainFrame()->evaluateJavaScript(
+        "var holder = document.getElementById('holder');"
+        "var oldObjects = [];"
+        "for (var i = 0; i < 1000; ++i) oldObjects.push({ i: i });"
+        "function churn(n) { var t; for (var i = 0; i < n; ++i) t = { a: i, b: [i, i + 1] }; return t; }"
+        "function makeCounter() { var captured = null; return { set: function(x) { captured = x; }, get: function() { return captured; } }; }"
+        "function keepArguments() { return arguments; }"
+        "var counter = makeCounter();");
+
+    // Make everything allocated so far old, so that the collections triggered below
+    // only trace what the loop stores into it.
+    DumpRenderTreeSupportQt::garbageCollectorCollect();
+
+    QVariant result = m_page->mainFrame()->evaluateJavaScript(
+        "var ok = true;"
+        "for (var round = 0; round < 30; ++round) {"
+        // A wrapper kept alive only through the DOM tree of an old wrapper, by way of its opaque root.
+        "    var child = document.createElement('span');"
+        "    child.expando = { round: round };"
+        "    holder.appendChild(child);"
+        "    child = null;"
+        "    for (var i = 0; i < 1000; i += 7)"
+        "        oldObjects[i] = { v: round * 10000 + i, s: 's' + i + '_' + round };"
+        "    counter.set({ round: round });"
+        "    var args = keepArguments({ round: round }, 'r' + round);"
+        "    churn(30000);"
+        "    if (!holder.lastChild.expando || holder.lastChild.expando.round != round) ok = false;"
+        "    for (var i = 0; i < 1000; i += 7)"
+        "        if (oldObjects[i].v != round * 10000 + i || oldObjects[i].s != 's' + i + '_' + round) ok = false;"
+        "    if (counter.get().round != round || args[0].round != round || args[1] != 'r' + round) ok = false;"
+        "}"
+        "for (var child = holder.firstChild, round = 0; child; child = child.nextSibling, ++round)"
+        "    if (child.expando.round != round) ok = false;"
+        "ok;");
+    QCOMPARE(result, QVariant(true));
+}
+
 void tst_QWebPage::localURLSchemes()
 {
     int i = QWebSecurityOrigin::localSchemes().size();
@@ -5,11 +5,11 @@ SUBDIRS = qwebframe qwebpage qwebelement qgraphicswebview qwebhistoryinterface q
 linux-* {
     # This test bypasses the library and links the tested code's object itself.
     # This stresses the build system in some corners so we only run it on linux.
-    SUBDIRS += MIMESniffing
+    SUBDIRS += MIMESniffing StringKernels
 }
 
 contains(QT_CONFIG, declarative): SUBDIRS += qdeclarativewebview
-SUBDIRS += benchmarks/painting benchmarks/loading
+SUBDIRS += benchmarks/painting benchmarks/loading benchmarks/strings
 contains(DEFINES, ENABLE_WEBGL=1) {
     SUBDIRS += benchmarks/webgl
 }